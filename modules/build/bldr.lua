@@ -1,7 +1,14 @@
 if Project "luajit" then
     Dir "build/vendor/luajit"
     Include "src"
-    Link { "src/luajit.lib", "src/lua51.lib" }
+
+    if Platform "Win32" then
+        Link { "src/luajit.lib", "src/lua51.lib" }
+    end
+
+    if Platform "Linux" then
+        Link "src/libluajit.a"
+    end
 end
 
 if Project "sol2" then
@@ -25,7 +25,17 @@ cd build\out
         ..\..\src\debug.cpp ^
         ..\..\src\load.cpp ^
         ..\..\src\bldr.cpp ^
-        ..\..\src\files.cpp
+        ..\..\src\files.cpp ^
+        ..\..\src\deps.cpp ^
+        ..\..\src\scan.cpp ^
+        ..\..\src\state.cpp ^
+        ..\..\src\graph.cpp ^
+        ..\..\src\diagnostics.cpp ^
+        ..\..\src\embed.cpp ^
+        ..\..\src\jobserver.cpp ^
+        ..\..\src\toolchain.cpp ^
+        ..\..\src\process_win32.cpp ^
+        ..\..\src\process_posix.cpp
 
     echo Linking...
 
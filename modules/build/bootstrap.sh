@@ -0,0 +1,43 @@
+#!/bin/sh
+set -e
+
+CXX="${CXX:-g++}"
+
+mkdir -p build/out
+rm -f build/out/*
+cd build/out
+
+    echo Compiling...
+
+    "$CXX" \
+        -std=c++23 \
+        -fopenmp \
+        -pthread \
+        -I../../src \
+        -I../vendor/sol2/include \
+        -I../vendor/luajit/src \
+        ../../src/build.cpp \
+        ../../src/debug.cpp \
+        ../../src/load.cpp \
+        ../../src/bldr.cpp \
+        ../../src/files.cpp \
+        ../../src/deps.cpp \
+        ../../src/scan.cpp \
+        ../../src/state.cpp \
+        ../../src/graph.cpp \
+        ../../src/diagnostics.cpp \
+        ../../src/embed.cpp \
+        ../../src/jobserver.cpp \
+        ../../src/toolchain.cpp \
+        ../../src/process_win32.cpp \
+        ../../src/process_posix.cpp \
+        -o bldr \
+        ../vendor/luajit/src/libluajit.a \
+        -ldl \
+        -lm
+
+cd ../..
+
+echo Bootstrapping...
+
+build/out/bldr make -clean bldr
\ No newline at end of file
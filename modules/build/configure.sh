@@ -0,0 +1,18 @@
+#!/bin/sh
+set -e
+
+mkdir -p build/vendor
+cd build/vendor
+
+    [ -d luajit ] || git clone --depth 1 https://github.com/LuaJIT/LuaJIT.git luajit
+    cd luajit
+        git pull
+        make -C src BUILDMODE=static libluajit.a
+    cd ..
+
+    [ -d sol2 ] || git clone --depth 1 https://github.com/ThePhD/sol2.git sol2
+    cd sol2
+        git pull
+    cd ..
+
+cd ../..
\ No newline at end of file
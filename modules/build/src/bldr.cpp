@@ -1,9 +1,13 @@
 #include "bldr.hpp"
 #include "log.hpp"
+#include "diagnostics.hpp"
 
+#include <algorithm>
+#include <charconv>
 #include <fstream>
 #include <unordered_set>
 #include <format>
+#include <thread>
 
 void display_help(std::string_view message = {})
 {
@@ -22,28 +26,40 @@ bldr install add    : Install new bldr files
      .                -clean   : Clean build
      .                -no-warn : Disable warnings
      .                -no-opt  : Disable optimizations
+     .                -no-cache: Bypass the build cache
+     .                -quiet   : Only log warnings and errors
+     .                -j<N>    : Run at most N build steps at once
+     .                -diagnostics=<file> : Write compiler diagnostics as JSON
      ide            : Configure intellisense for supported IDEs
 )");
     std::exit(1);
 }
 
-struct file_index_guard_t
+struct build_state_guard_t
 {
-    file_index_guard_t() { load_file_include_cache(); }
-    ~file_index_guard_t() { save_file_include_cache(); }
+    build_state_guard_t() { load_build_state(); }
+    ~build_state_guard_t() { save_build_state(); }
 };
 
 int main(int argc, char* argv[]) try
 {
     std::vector<std::string_view> args(argv, argv + argc);
 
+#ifdef _WIN32
     s_paths.dir = fs::path(std::getenv("USERPROFILE")) / ".bldr";
+#else
+    s_paths.dir = fs::path(std::getenv("HOME")) / ".bldr";
+#endif
     s_paths.artifacts    = s_paths.dir / "artifacts";
     s_paths.environments = s_paths.dir / "environments";
     s_paths.installed    = s_paths.dir / "installed";
+    s_paths.cache        = s_paths.dir / "cache";
+    if (auto* cache_dir = std::getenv("BLDR_CACHE_DIR")) {
+        s_paths.cache = cache_dir;
+    }
     fs::create_directories(s_paths.dir);
 
-    file_index_guard_t file_index_guard;
+    build_state_guard_t build_state_guard;
 
     if (args.size() < 2) display_help("Expected action");
 
@@ -121,6 +137,7 @@ int main(int argc, char* argv[]) try
     } else if (args[1] == "make" || args[1] == "cmake" || args[1] == "vscode") {
         std::vector<std::string_view> projects;
         flags_t flags{};
+        uint32_t jobs = std::max(std::thread::hardware_concurrency(), 1u);
         for (uint32_t i = 2; i < args.size(); ++i) {
             auto& arg = args[i];
             if      (arg == "-clean")   flags = flags | flags_t::clean;
@@ -131,6 +148,22 @@ int main(int argc, char* argv[]) try
             else if (arg == "-strip")   flags = flags | flags_t::strip;
             else if (arg == "-lto")     flags = flags | flags_t::lto;
             else if (arg == "-link")    flags = flags | flags_t::link;
+            else if (arg == "-no-cache") flags = flags | flags_t::nocache;
+            else if (arg == "-quiet")   s_log_level = log_level_t::warn;
+            else if (arg.starts_with("-diagnostics=")) {
+                auto path = arg.substr(13);
+                if (path.empty()) {
+                    display_help("Expected file path after -diagnostics=");
+                }
+                s_diagnostics.path = fs::absolute(path);
+            }
+            else if (arg.starts_with("-j")) {
+                auto value = arg.substr(2);
+                auto[end, ec] = std::from_chars(value.data(), value.data() + value.size(), jobs);
+                if (ec != std::errc{} || end != value.data() + value.size() || jobs == 0) {
+                    display_help(std::format("Expected job count after -j, but got '{}'", value));
+                }
+            }
             else projects.push_back(arg);
         }
 
@@ -154,7 +187,7 @@ int main(int argc, char* argv[]) try
 
         if (!to_build.empty()) {
             if (args[1] == "make") {
-                if (!build_project(to_build, flags)) {
+                if (!build_project(to_build, flags, jobs)) {
                     return 1;
                 }
             } else if (args[1] == "cmake") {
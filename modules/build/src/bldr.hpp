@@ -19,6 +19,7 @@ struct paths_t
     fs::path installed;
     fs::path artifacts;
     fs::path environments;
+    fs::path cache;
 };
 
 inline paths_t s_paths;
@@ -36,6 +37,7 @@ enum class flags_t : uint64_t
     strip  = 1 << 5,
     lto    = 1 << 6,
     link = 1 << 7, // force a relink
+    nocache = 1 << 8, // bypass the build cache
 };
 
 inline
@@ -76,6 +78,8 @@ struct define_t
     std::string value;
 };
 
+std::string to_string(const define_t& def);
+
 struct source_t
 {
     fs::path      file;
@@ -111,6 +115,7 @@ struct project_t
     std::vector<define_t>    build_defines;
     std::vector<define_t>    defines;
     std::vector<fs::path>    shared_libs;
+    fs::path                 pch; // Precompiled for this project's own C++ sources only
 
     std::optional<artifact_t> artifact;
 };
@@ -120,13 +125,13 @@ struct project_artifactory_t
     std::unordered_map<std::string_view, project_t*> projects;
 };
 
-void load_file_include_cache();
-void save_file_include_cache();
+void load_build_state();
+void save_build_state();
 
 void populate_artifactory(project_artifactory_t& artifactory, flags_t flags);
 void generate_build(project_artifactory_t& artifactory,  project_t& project, project_t& output);
 void debug_project(project_t& project);
-bool build_project(std::span<project_t*> projects, flags_t flags);
+bool build_project(std::span<project_t*> projects, flags_t flags, uint32_t jobs);
 void configure_cmake(std::span<project_t*> projects, flags_t flags);
 void configure_vscode(std::span<project_t*> projects, flags_t flags);
 
@@ -154,4 +159,12 @@ struct program_exec_t
 
 };
 
-uint32_t execute_program(const program_exec_t& info, flags_t flags, std::string_view filename);
\ No newline at end of file
+// Starts a command line with a program found through PATH
+void add_program(program_exec_t& info, std::string_view program);
+
+uint32_t execute_program(const program_exec_t& info, flags_t flags, std::string_view filename);
+
+#ifdef _WIN32
+// Environment variables set up by the MSVC developer prompt
+const std::string& get_build_environment();
+#endif
\ No newline at end of file
@@ -1,238 +1,26 @@
 #include "bldr.hpp"
 #include "log.hpp"
 #include "json.hpp"
+#include "cache.hpp"
+#include "deps.hpp"
+#include "state.hpp"
+#include "scan.hpp"
+#include "graph.hpp"
+#include "jobserver.hpp"
+#include "toolchain.hpp"
+#include "diagnostics.hpp"
+#include "embed.hpp"
 
 #include <unordered_set>
 #include <filesystem>
 #include <array>
 #include <fstream>
 #include <algorithm>
-#include <regex>
 #include <ranges>
 #include <spanstream>
 
-#define NOMINMAX
-#define WIN32_LEAN_AND_MEAN
 #include <any>
 
-#include "Windows.h"
-#include "shellapi.h"
-
-std::string generate_env()
-{
-    auto env_file = s_paths.environments / "msvc";
-    fs::create_directories(s_paths.environments);
-
-    {
-        std::ifstream in(env_file, std::ios::binary | std::ios::ate);
-        if (in.is_open()) {
-            std::string str;
-            str.resize(in.tellg());
-            in.seekg(0);
-            in.read(str.data(), str.size());
-            return str;
-        }
-    }
-
-    // TODO: Move all of this process execution + input + output into unified helper
-    STARTUPINFOA startup{};
-    PROCESS_INFORMATION process{};
-
-    std::string cmd = "cmd /c call \"C:/Program Files/Microsoft Visual Studio/2022/Community/VC/Auxiliary/Build/vcvarsx86_amd64.bat\" && set";
-
-    SECURITY_ATTRIBUTES sec_attribs;
-    SecureZeroMemory(&sec_attribs, sizeof(sec_attribs));
-    sec_attribs.nLength = sizeof(sec_attribs);
-    sec_attribs.bInheritHandle = true;
-    sec_attribs.lpSecurityDescriptor = nullptr;
-
-    HANDLE stdout_read_handle;
-    HANDLE stdout_write_handle;
-
-    CreatePipe(&stdout_read_handle, &stdout_write_handle, &sec_attribs, 0);
-
-    startup.cb = sizeof(startup);
-    startup.hStdError = stdout_write_handle;
-    startup.hStdOutput = stdout_write_handle;
-    startup.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
-    startup.dwFlags = STARTF_USESTDHANDLES;
-
-    auto res = CreateProcessA(
-        nullptr,
-        cmd.data(),
-        nullptr,
-        nullptr,
-        true,
-        0,
-        nullptr,
-        nullptr,
-        &startup,
-        &process);
-
-    if (!res) {
-        log_error("Error creating environment: {}", GetLastError());
-    } else {
-        CloseHandle(stdout_write_handle);
-
-        log_info("Generating MSVC environment...");
-
-        std::string output;
-        std::array<char, 4096> buffer{};
-        DWORD bytes_read;
-        BOOL success;
-        for (;;) {
-            success = ReadFile(stdout_read_handle, buffer.data(), DWORD(buffer.size()) - 1, &bytes_read, 0);
-            if (!success || bytes_read == 0) break;
-            output.append(buffer.data(), bytes_read);
-        }
-
-        WaitForSingleObject(process.hProcess, INFINITE);
-        CloseHandle(stdout_read_handle);
-
-        std::string env;
-        std::string line;
-        std::stringstream ss(output);
-        while (std::getline(ss, line)) {
-            if (line.ends_with('\r')) {
-                line = line.substr(0, line.size() - 1);
-            }
-            if (line.find_first_of('=') != std::string::npos) {
-                env.append(line);
-                env.push_back('\0');
-            }
-        }
-        env.push_back('\0');
-
-        {
-            std::ofstream out(env_file, std::ios::binary);
-            out.write(env.data(), env.size());
-        }
-
-        log_info("MSVC environment generated");
-
-        return env;
-    }
-
-    std::exit(1);
-}
-
-const std::string& get_build_environment()
-{
-    static std::string env = generate_env();
-    return env;
-}
-
-uint32_t execute_program(const program_exec_t& info, [[maybe_unused]] flags_t flags, std::string_view name)
-{
-    (void)name;
-    // auto start = std::chrono::steady_clock::now();
-
-    std::stringstream ss;
-    auto cmd = [&](std::string_view value)
-    {
-        if (value.contains(' ')) {
-            ss << '"' << value << "\" ";
-        } else {
-            ss << value << ' ';
-        }
-    };
-
-    for (auto& arg : info.arguments) cmd(arg);
-
-    std::string cmd_line = ss.str();
-    if (is_set(flags, flags_t::trace)) {
-        log_debug("{}", cmd_line);
-    }
-
-    SECURITY_ATTRIBUTES sa = {};
-    sa.nLength = sizeof(sa);
-    sa.bInheritHandle = true;
-    sa.lpSecurityDescriptor = nullptr;
-
-    HANDLE stdout_read = {};
-    HANDLE stdout_write = {};
-
-    // Create a pipe for the child process' STDOUT.
-    if (!CreatePipe(&stdout_read, &stdout_write, &sa, 0)) {
-        log_error("Failed to create pipe for executing process");
-        return 1;
-    }
-
-    // Ensure the read handle to the pipe for STDOUT is not inherit
-    if (!SetHandleInformation(stdout_read, HANDLE_FLAG_INHERIT, 0)) {
-        log_error("Failed to disable inheritance for stdout read handle");
-        CloseHandle(stdout_write);
-        CloseHandle(stdout_read);
-        return 1;
-    }
-
-    STARTUPINFOA si = {};
-    si.cb = sizeof(si);
-    si.hStdError = stdout_write;
-    si.hStdOutput = stdout_write;
-    si.dwFlags |= STARTF_USESTDHANDLES;
-
-    PROCESS_INFORMATION pi = {};
-
-    if (!CreateProcessA(
-            nullptr,
-            cmd_line.data(),
-            nullptr,
-            nullptr,
-            true, // Inherit Handles
-            0,    // Creation flags
-            (void*)get_build_environment().c_str(),
-            info.working_directory.string().c_str(),
-            &si,
-            &pi)) {
-        log_error("Failed to launch process");
-        CloseHandle(stdout_write);
-        CloseHandle(stdout_read);
-        return 1;
-    }
-
-    std::jthread reader_thread {
-        [&] {
-            std::string line;
-            for (;;) {
-                std::array<char, UINT16_MAX> buffer = {};
-                DWORD bytes_read;
-                if (!ReadFile(stdout_read, buffer.data(), DWORD(buffer.size()), &bytes_read, 0)) {
-                    break;
-                }
-
-                // TODO: Used timed locks holding to avoid interspersing output from multiple processes
-                for (char c : std::string_view(buffer.data(), bytes_read)) {
-                    line.push_back(c);
-                    if (c == '\n') {
-                        std::cout << line;
-                        line.clear();
-                    }
-                }
-            }
-
-            // Flush remainder of output buffer
-            if (!line.empty()) {
-                std::cout << line << '\n';
-            }
-        }
-    };
-
-    WaitForSingleObject(pi.hProcess, INFINITE);
-
-    DWORD ec;
-    GetExitCodeProcess(pi.hProcess, &ec);
-
-    CloseHandle(stdout_write);
-    CloseHandle(stdout_read);
-    CloseHandle(pi.hProcess);
-
-    // auto end = std::chrono::steady_clock::now();
-    // log_debug("{} - {}", name, duration_to_string(end - start));
-
-    return ec;
-}
-
 void generate_build(project_artifactory_t& artifactory,  project_t& project, project_t& output)
 {
     std::unordered_set<std::string_view> visited;
@@ -295,6 +83,7 @@ void generate_build(project_artifactory_t& artifactory,  project_t& project, pro
     }
 
     output.name = project.name;
+    output.pch = project.pch;
     output.artifact = project.artifact;
 }
 
@@ -316,23 +105,34 @@ std::string to_string(const fs::path& path, char separator = '/')
 
 // -----------------------------------------------------------------------------
 
-struct file_dep_t
+// Records the dependencies a compiler reported for an output. Unreadable reports record an
+// empty list, which is always considered dirty.
+std::vector<std::string> record_dependencies(const fs::path& output, const fs::path& report, dependency_format_t format)
 {
-    std::string name;
-    bool       local;
-};
+    std::string text;
+    {
+        std::ifstream in(report, std::ios::binary | std::ios::ate);
+        if (in.is_open()) {
+            text.resize(in.tellg());
+            in.seekg(0);
+            in.read(text.data(), text.size());
+        }
+    }
 
-struct file_includes_t
-{
-    bool                       dirty = false;
-    bool                     visited = false;
-    bool                     scanned = false;
-    std::string                 name;
-    std::vector<file_dep_t> includes;
-    // TODO: Store file scan time and use to invalidate scan state
-};
+    std::vector<std::string> dependencies;
+    if (!parse_dependencies(text, format, dependencies)) {
+        log_warn("Failed to read dependencies for [{}]", output.filename().string());
+        dependencies.clear();
+    }
+
+    std::error_code ec;
+    fs::remove(report, ec);
+
+    s_build_state.record(output, dependencies);
+    return dependencies;
+}
 
-std::unordered_map<std::string_view, std::unique_ptr<file_includes_t>> file_cache;
+// -----------------------------------------------------------------------------
 
 struct timer_t
 {
@@ -364,200 +164,17 @@ struct timer_t
     }
 };
 
-static constexpr std::string_view s_file_index_name = ".include-cache";
-
-void load_file_include_cache()
-{
-    timer_t t{ "load file index" };
-
-    auto path = s_paths.dir / s_file_index_name;
-
-    std::ifstream in(path, std::ios::binary);
-    if (!in.is_open()) {
-        return;
-    }
-    std::vector<char> data;
-    data.resize(fs::file_size(path));
-    in.read(data.data(), data.size());
-
-    std::spanstream din{data};
-
-    auto ReadUInt32 = [&] {
-        uint32_t v;
-        din.read((char*)&v, 4);
-        return v;
-    };
-
-    auto ReadString = [&] {
-        auto size = ReadUInt32();
-        std::string str(size, '\0');
-        din.read(str.data(), str.size());
-        return str;
-    };
-
-    auto count = ReadUInt32();
-
-    for (uint32_t i = 0; i < count; ++i) {
-        auto file = std::make_unique<file_includes_t>();
-        file->name = ReadString();
-        file->includes.resize(ReadUInt32());
-        file->scanned = true;
-        // log_debug("loaded file [{}]", file->name);
-        for (uint32_t j = 0; j < file->includes.size(); ++j) {
-            file->includes[j].local = bool(ReadUInt32());
-            file->includes[j].name = ReadString();
-        }
-        file_cache[file->name] = std::move(file);
-    }
-}
-
-void save_file_include_cache()
-{
-    // TODO: Only save index if changed
-
-    timer_t t{ "save file index" };
-
-    auto path = s_paths.dir / s_file_index_name;
-
-    std::ofstream out(path, std::ios::binary);
-
-    auto WriteUInt32 = [&](uint32_t v) {
-        out.write((const char*)&v, 4);
-    };
-
-    auto WriteString = [&](std::string_view s) {
-        WriteUInt32(uint32_t(s.size()));
-        out.write(s.data(), s.size());
-    };
-
-    uint32_t count = 0;
-    for (auto& file : std::views::values(file_cache)) {
-        count += file->scanned;
-    }
-
-    WriteUInt32(count);
-
-    for (auto& file : std::views::values(file_cache)) {
-        if (!file->scanned) continue;
-        WriteString(file->name);
-        WriteUInt32(uint32_t(file->includes.size()));
-        for (auto& dep : file->includes) {
-            WriteUInt32(dep.local);
-            WriteString(dep.name);
-        }
-    }
-}
-
-static size_t files_visited = 0;
-static size_t files_scanned = 0;
-static size_t bytes_scanned = 0;
-
-// ^ \s* # \s* include \s+ ("|<) ([^">]+)
-static const std::regex regex(R"(^\s*#\s*include\s+("|<)([^">]+))");
-
-bool is_dirty(const project_t& project, const fs::path& path, fs::file_time_type last)
-{
-    auto check = [&](this auto&& self, fs::path cur)
-    {
-        cur = fs::canonical(cur);
-
-        files_visited++;
-
-        file_includes_t* state = {};
-        {
-            auto i = file_cache.find(cur.string());
-            if (i != file_cache.end()) {
-                state = i->second.get();
-            } else {
-                auto file = std::make_unique<file_includes_t>();
-                state = file.get();
-                file->name = cur.string();
-                file_cache[file->name] = std::move(file);
-            }
-        }
-
-        if (state->visited) {
-            return state->dirty;
-        }
-
-        state->visited = true;
-
-        if (!fs::exists(cur) || fs::last_write_time(cur) > last) {
-            state->dirty = true;
-            state->scanned = false;
-            return true;
-        }
-
-        if (!state->scanned) {
-
-            std::string str;
-            std::ifstream in(cur, std::ios::binary | std::ios::ate);
-            if (!in.is_open()) {
-                // log_warn("Couldn't open file {}", cur.string());
-                return false;
-            }
-            str.resize(in.tellg());
-            in.seekg(0);
-            in.read(str.data(), str.size());
-
-            files_scanned++;
-            bytes_scanned += str.size();
-            state->scanned = true;
-
-            auto beg = std::sregex_iterator(str.begin(), str.end(), regex);
-            auto end = std::sregex_iterator();
-            for (auto i = beg; i != end; ++i) {
-                auto& match = *i;
-                auto token = match.str(1);
-                auto file = match.str(2);
-
-                state->includes.push_back(file_dep_t {
-                    .name = file,
-                    .local = token == "\"",
-                });
-            }
-        }
-
-        for (auto& dep : state->includes) {
-            if (dep.local) {
-                auto new_path = cur.parent_path() / fs::path(dep.name);
-                if (fs::exists(new_path) && !fs::is_directory(new_path)) {
-                    if (self(std::move(new_path))) {
-                        state->dirty = true;
-                        return true;
-                    }
-                    continue;
-                }
-            }
-
-            for (auto& include : project.includes) {
-                auto new_path = include / dep.name;
-                if (fs::exists(new_path) && !fs::is_directory(new_path)) {
-                    if (self(std::move(new_path))) {
-                        state->dirty = true;
-                        return true;
-                    }
-                    break;
-                }
-            }
-        }
-
-        return false;
-    };
-
-    return check(path);
-}
-
 // -----------------------------------------------------------------------------
 
 
-bool build_project(std::span<project_t*> projects, flags_t flags)
+bool build_project(std::span<project_t*> projects, flags_t flags, uint32_t jobs)
 {
     auto start = std::chrono::steady_clock::now();
 
     timer_t timer{ "clean & collect tasks" };
 
     auto artifacts_dir = s_paths.artifacts;
+    auto& toolchain = get_toolchain();
     if (is_set(flags, flags_t::clean)) {
         log_info("Cleaning project artifacts");
         for (auto& project : projects) {
@@ -585,6 +202,10 @@ bool build_project(std::span<project_t*> projects, flags_t flags)
     std::unordered_set<std::filesystem::path> generated_objs;
     std::unordered_set<std::filesystem::path>       obj_dirs;
 
+    auto object_path = [&](const project_t& project, const source_t& source) {
+        return artifacts_dir / project.name / fs::path(source.file.filename()).replace_extension(".obj");
+    };
+
     for (auto& project : projects) {
         auto obj_dir = artifacts_dir / project->name;
         fs::create_directories(obj_dir);
@@ -593,6 +214,16 @@ bool build_project(std::span<project_t*> projects, flags_t flags)
 
     timer.segment("scan for changes");
 
+    struct unrecorded_task_t
+    {
+        compile_task_t       task;
+        fs::path           object;
+        fs::file_time_type   time;
+    };
+
+    // Objects without compiler reported dependencies, checked by scanning for includes
+    std::vector<unrecorded_task_t> unrecorded_tasks;
+
     for (int32_t i = 0; i < int32_t(compile_tasks.size()); ++i) {
         auto task = compile_tasks[i];
         auto& project = *task.project;
@@ -610,17 +241,26 @@ bool build_project(std::span<project_t*> projects, flags_t flags)
 
         generated_objs.emplace(target_obj);
 
-        if (fs::exists(target_obj)) {
-            auto last_modified = fs::last_write_time(target_obj);
+        if (auto target_stat = s_build_state.stat(target_obj); target_stat.exists) {
+            auto last_modified = target_stat.last_write;
             if (source.type == source_type_t::embed) {
                 // Don't look for dependencies in embeds
-                if (fs::last_write_time(source.file) <= last_modified) {
+                if (auto source_stat = s_build_state.stat(source.file); source_stat.exists && source_stat.last_write <= last_modified) {
                     continue;
                 }
-            } else {
-                if (!is_dirty(project, source.file, last_modified)) {
+            } else if (source.type == source_type_t::slang) {
+                // Shader dependencies are recorded against the intermediate SPIR-V
+                auto spirv = fs::path(target_obj).replace_extension();
+                if (!s_build_state.is_dirty(spirv, last_modified)) {
+                    continue;
+                }
+            } else if (s_build_state.contains(target_obj)) {
+                if (!s_build_state.is_dirty(target_obj, last_modified)) {
                     continue;
                 }
+            } else {
+                unrecorded_tasks.emplace_back(compile_tasks[i], target_obj, last_modified);
+                continue;
             }
             fs::remove(target_obj);
         }
@@ -628,17 +268,232 @@ bool build_project(std::span<project_t*> projects, flags_t flags)
         filtered_compile_tasks.emplace_back(compile_tasks[i]);
     }
 
-    log_info("Scanned {} / {} ({} bytes)", files_scanned, files_visited, bytes_scanned);
+    if (!unrecorded_tasks.empty()) {
+        include_scanner_t scanner;
+
+        // Force includes are given as written, and may need to be found through include paths
+        std::unordered_map<project_t*, std::vector<fs::path>> force_includes;
+        for (auto* project : projects) {
+            auto& resolved = force_includes[project];
+            for (auto& include : project->force_includes) {
+                if (fs::is_regular_file(include)) {
+                    resolved.push_back(include);
+                    continue;
+                }
+                for (auto& dir : project->includes) {
+                    if (fs::is_regular_file(dir / include)) {
+                        resolved.push_back(dir / include);
+                        break;
+                    }
+                }
+            }
+
+            std::vector<fs::path> roots = resolved;
+            for (auto& unrecorded : unrecorded_tasks) {
+                if (unrecorded.task.project == project) roots.push_back(unrecorded.task.source.file);
+            }
+            scanner.scan(roots, project->includes);
+        }
+
+        for (auto& unrecorded : unrecorded_tasks) {
+            auto& project = *unrecorded.task.project;
+            bool dirty = scanner.is_dirty(unrecorded.task.source.file, project.includes, unrecorded.time);
+            for (auto& include : force_includes[&project]) {
+                dirty = dirty || scanner.is_dirty(include, project.includes, unrecorded.time);
+            }
+            if (dirty) {
+                fs::remove(unrecorded.object);
+                filtered_compile_tasks.emplace_back(unrecorded.task);
+            }
+        }
+
+        log_info("Scanned {} files for {} object{} without recorded dependencies",
+            std::ranges::count_if(scanner.files, &include_scanner_t::file_t::scanned), unrecorded_tasks.size(), (unrecorded_tasks.size() == 1) ? "" : "s");
+    }
+
+    timer.segment("precompiled headers and modules");
+
+    // Compiles added because of a rebuilt PCH or a missing BMI
+    std::unordered_set<fs::path> filtered_objs;
+    for (auto& task : filtered_compile_tasks) {
+        filtered_objs.insert(object_path(*task.project, task.source));
+    }
+
+    auto force_compile = [&](const compile_task_t& task) {
+        auto obj = object_path(*task.project, task.source);
+        if (filtered_objs.insert(obj).second) {
+            std::error_code ec;
+            fs::remove(obj, ec);
+            filtered_compile_tasks.emplace_back(task);
+        }
+    };
+
+    // Precompiled headers, used by each project's own C++ sources. A rebuilt PCH rebuilds every
+    // object using it, as MSVC objects only link with the PCH object they were compiled against.
+
+    struct pch_t
+    {
+        fs::path                    stub; // Includes the header, and is what gcc consumers include
+        fs::path                     pch;
+        fs::path                  object; // MSVC only
+        bool                   dirty = false;
+        std::optional<uint32_t>     node;
+    };
+
+    std::unordered_map<project_t*, pch_t> pchs;
+    bool pch_objects = toolchain.type == toolchain_type_t::msvc;
+
+    auto uses_pch = [&](const compile_task_t& task) {
+        return task.source.type == source_type_t::cpp && pchs.contains(task.project);
+    };
+
+    for (auto* project : projects) {
+        if (project->pch.empty()) continue;
+
+        auto& pch = pchs[project];
+        pch.stub = artifacts_dir / project->name / std::format("{}.pch.hpp", project->name);
+        pch.pch = toolchain.pch_path(pch.stub);
+        if (pch_objects) {
+            pch.object = fs::path(pch.stub).replace_extension(".obj");
+            generated_objs.emplace(pch.object);
+        }
+
+        auto pch_stat = s_build_state.stat(pch.pch);
+        pch.dirty = !pch_stat.exists
+            || s_build_state.is_dirty(pch.pch, pch_stat.last_write)
+            || (pch_objects && !s_build_state.stat(pch.object).exists);
+    }
+
+    for (auto& task : compile_tasks) {
+        if (uses_pch(task) && pchs.at(task.project).dirty) {
+            force_compile(task);
+        }
+    }
+
+    // Module interfaces, found by scanning every cppm source. Imports are only resolved between
+    // the projects being built, and BMIs are named after their source like objects.
+
+    struct module_t
+    {
+        std::string                  name;
+        compile_task_t               task;
+        fs::path                      bmi;
+        std::vector<std::string>  imports;
+        std::optional<uint32_t>      node; // Set when the interface is rebuilt
+    };
+
+    std::unordered_map<std::string, module_t> modules;
+    std::vector<module_unit_t> filtered_units; // Indexed as filtered_compile_tasks, empty without modules
+    auto module_map = artifacts_dir / ".module-map";
+
+    auto bmi_path = [&](const project_t& project, const source_t& source) {
+        return artifacts_dir / project.name / fs::path(source.file.filename()).replace_extension(toolchain.bmi_extension());
+    };
+
+    auto scan_units = [&](std::span<const compile_task_t> tasks) {
+        std::vector<module_unit_t> units(tasks.size());
+#pragma omp parallel for
+        for (int32_t i = 0; i < int32_t(tasks.size()); ++i) {
+            auto type = tasks[i].source.type;
+            if (type != source_type_t::cpp && type != source_type_t::cppm) continue;
+
+            std::ifstream in(tasks[i].source.file, std::ios::binary);
+            std::string text{ std::istreambuf_iterator<char>(in), {} };
+            find_module_directives(text, units[i]);
+        }
+        return units;
+    };
+
+    if (std::ranges::any_of(compile_tasks, [](auto& task) { return task.source.type == source_type_t::cppm; })) {
+        std::vector<compile_task_t> interface_tasks;
+        for (auto& task : compile_tasks) {
+            if (task.source.type == source_type_t::cppm) interface_tasks.emplace_back(task);
+        }
+
+        auto interface_units = scan_units(interface_tasks);
+        for (uint32_t i = 0; i < interface_tasks.size(); ++i) {
+            auto& unit = interface_units[i];
+            if (!unit.interface) continue;
+
+            auto& task = interface_tasks[i];
+            auto[iter, inserted] = modules.try_emplace(unit.name, unit.name, task, bmi_path(*task.project, task.source), std::move(unit.imports));
+            if (!inserted) {
+                log_error("Module [{}] is declared by both [{}] and [{}]",
+                    unit.name, to_string(iter->second.task.source.file), to_string(task.source.file));
+                return false;
+            }
+        }
+
+        for (auto&[name, module] : modules) {
+            if (!s_build_state.stat(module.bmi).exists) {
+                force_compile(module.task);
+            }
+        }
+
+        filtered_units = scan_units(filtered_compile_tasks);
+
+        // gcc reads every BMI location from a mapper file
+        if (toolchain.type == toolchain_type_t::gcc) {
+            std::ofstream out(module_map, std::ios::binary);
+            for (auto&[name, module] : modules) {
+                out << name << ' ' << module.bmi.string() << '\n';
+            }
+        }
+    }
+
+    // Modules imported by a unit, directly or through the interfaces it imports. Imports not
+    // built here are left for the compiler to report.
+    auto resolve_imports = [&](const module_unit_t& unit) {
+        std::vector<module_t*> resolved;
+        std::unordered_set<std::string_view> visited;
+        auto visit = [&](this auto&& self, const std::vector<std::string>& imports) -> void {
+            for (auto& name : imports) {
+                if (!visited.insert(name).second) continue;
+                auto iter = modules.find(name);
+                if (iter == modules.end()) continue;
+                resolved.push_back(&iter->second);
+                self(iter->second.imports);
+            }
+        };
+        visit(unit.imports);
+        return resolved;
+    };
 
     log_info("Compiling {} file{} ({} skipped)",
         filtered_compile_tasks.size(),
         (filtered_compile_tasks.size() == 1) ? "" : "s",
         compile_tasks.size() - filtered_compile_tasks.size());
 
-    timer.segment("compiling");
+    timer.segment("cleaning old objects");
 
-    std::atomic_uint32_t errors = 0;
-    std::atomic_uint32_t aborted = 0;
+    // Removed objects are only known to relink projects importing their directory
+    std::unordered_set<fs::path> dirs_with_removed_objs;
+
+    for (auto& obj_dir : obj_dirs) {
+        if (is_set(flags, flags_t::trace)) {
+            log_debug("Cleaning out obj dir [{}]", to_string(obj_dir));
+        }
+        for (auto& i : fs::directory_iterator(obj_dir)) {
+            if (i.path().extension() != ".obj") continue;
+            if (!generated_objs.contains(i.path())) {
+                if (is_set(flags, flags_t::trace)) {
+                    log_debug("Removing stale object [{}]", to_string(i.path().filename()));
+                }
+                fs::remove(i.path());
+                dirs_with_removed_objs.insert(obj_dir);
+            }
+        }
+    }
+
+    timer.segment("building");
+
+    uint32_t errors = 0;
+    uint32_t aborted = 0;
+    std::atomic_uint32_t cache_hits = 0;
+
+    bool use_cache = !is_set(flags, flags_t::nocache);
+    action_cache_t action_cache{ s_paths.cache };
+    hash_t compiler_identity;
 
     auto arg = [&](auto& exec_info, auto&&... args)
     {
@@ -652,436 +507,426 @@ bool build_project(std::span<project_t*> projects, flags_t flags)
         (arg(exec_info, _args), ...);
     };
 
-    while (filtered_compile_tasks.size()) {
-        std::vector<compile_task_t> new_compile_tasks;
+    if (use_cache && !filtered_compile_tasks.empty()) {
+        compiler_identity = toolchain.identity();
+    }
 
-#pragma omp parallel for
-        for (int32_t i = 0; i < int32_t(filtered_compile_tasks.size()); ++i) {
-            auto task = filtered_compile_tasks[i];
-            auto& project = *task.project;
-            auto source = task.source;
+    // Embeds and shaders are compiled through a generated C++ source, unless written directly as objects
+    auto generated_source = [&](const project_t& project, const source_t& source) -> source_t {
+        auto dir = artifacts_dir / project.name;
+        if (source.type == source_type_t::embed) {
+            return { {(dir / std::format("{}.cpp", source.file.filename().string())).string()}, source_type_t::cpp };
+        }
+        return { {(dir / fs::path(source.file.filename()).replace_extension(".spv.cpp")).string()}, source_type_t::cpp };
+    };
 
-            program_exec_t info;
-            info.working_directory = {(artifacts_dir / project.name).string()};
+    // MSVC objects are written directly, other toolchains compile a generated .incbin source
+    bool embed_objects = toolchain.type == toolchain_type_t::msvc;
 
-            bool generated = false;
+    auto embed_resource = [&](project_t& project, const source_t& source, const fs::path& resource) -> bool
+    {
+        auto generated = generated_source(project, source);
+        auto name = resource.filename().string();
+        return embed_objects
+            ? write_coff_embed(object_path(project, generated), name, resource)
+            : write_incbin_embed(generated.file, name, resource);
+    };
 
-            if (source.type == source_type_t::embed) {
-                log("embedding {}...", source.file.filename().string());
-
-                auto gen_path = artifacts_dir / project.name / std::format("{}.cpp", source.file.filename().string());
-                std::ofstream gen(gen_path, std::ios::binary);
-                gen << "#include <cstdint>\n";
-                gen << "void bldr_register_embed(const char* name, const void* data, size_t size_in_bytes);\n";
-                gen << "namespace {\n";
-                gen << "int bldr_register_embed_call(const char* name, const void* data, size_t size_in_bytes)\n";
-                gen << "{\n";
-                gen << "    bldr_register_embed(name, data, size_in_bytes);\n";
-                gen << "    return 1;\n";
-                gen << "}\n";
-                gen << "constexpr uint64_t bldr_embed_data[] {";
-
-                auto resource_in_path = source.file;
-                std::ifstream resource_in(resource_in_path, std::ios::binary);
-                size_t resource_byte_size = fs::file_size(resource_in_path);
-                size_t u64_count = (resource_byte_size + 7) / 8;
-
-                for (size_t j = 0; j < u64_count; ++j) {
-                    if ((j % 8) == 0) gen << '\n';
-                    uint64_t value = {};
-                    resource_in.read(reinterpret_cast<char*>(&value), sizeof(value));
-                    gen << std::format("{:#016x},", value);
-                }
+    auto generate_embed = [&](project_t& project, const source_t& source) -> bool
+    {
+        log("embedding {}...", source.file.filename().string());
 
-                gen << "\n";
-                gen << "};\n";
-                gen << "const int bldr_embed_registered = bldr_register_embed_call(\"" << resource_in_path.filename().string() << "\", bldr_embed_data, " << resource_byte_size << ");\n";
-                gen << "}\n";
+        return embed_resource(project, source, source.file);
+    };
 
-                // Continue to compile generated source file
+    auto generate_shader = [&](project_t& project, const source_t& source) -> bool
+    {
+        program_exec_t info;
+        info.working_directory = {(artifacts_dir / project.name).string()};
 
-                resource_in.close();
-                gen.close();
+        add_program(info, "slangc");
 
-                source.type = source_type_t::cpp;
-                source.file = gen_path;
-                info.arguments.clear();
-                generated = true;
+        args(info, "-o", fs::path(source.file.filename()).replace_extension(".spv").string());
+        args(info, "-depfile", fs::path(source.file.filename()).replace_extension(".spv.d").string());
 
-            } else if (source.type == source_type_t::slang) {
-                args(info, "cmd", "/c", "slangc");
+        args(info, "-lang", "slang");
 
-                args(info, "-o", fs::path(source.file.filename()).replace_extension(".spv").string());
+        arg(info, "-matrix-layout-column-major");
+        arg(info, "-force-glsl-scalar-layout");
 
-                args(info, "-lang", "slang");
+        args(info, "-target", "spirv");
+        arg(info, "-fvk-use-entrypoint-name");
+        arg(info, "-emit-spirv-directly");
 
-                arg(info, "-matrix-layout-column-major");
-                arg(info, "-force-glsl-scalar-layout");
+        for (auto& include : project.includes) arg(info, "-I",  include.string());
 
-                args(info, "-target", "spirv");
-                arg(info, "-fvk-use-entrypoint-name");
-                arg(info, "-emit-spirv-directly");
+        log("{}", source.file.filename().string());
+        arg(info, source.file.string());
 
-                for (auto& include : project.includes) arg(info, "-I",  include.string());
+        auto res = execute_program(info, flags, source.file.filename().string());
+        if (res != 0) {
+            return false;
+        }
 
-                log("{}", source.file.filename().string());
-                arg(info, source.file.string());
+        record_dependencies(
+            artifacts_dir / project.name / fs::path(source.file.filename()).replace_extension(".spv"),
+            artifacts_dir / project.name / fs::path(source.file.filename()).replace_extension(".spv.d"),
+            dependency_format_t::makefile);
 
-                auto res = execute_program(info, flags, source.file.filename().string());
-                if (res != 0) {
-                    errors++;
-                    continue;
-                }
+        // Embed the generated SPIR-V
 
-                // Generate source file for embedding
-
-                auto gen_path = artifacts_dir / project.name / fs::path(source.file.filename()).replace_extension(".spv.cpp");
-                std::ofstream gen(gen_path, std::ios::binary);
-                gen << "#include <cstdint>\n";
-                gen << "void bldr_register_embed(const char* name, const void* data, size_t size_in_bytes);\n";
-                gen << "namespace {\n";
-                gen << "int bldr_register_embed_call(const char* name, const void* data, size_t size_in_bytes)\n";
-                gen << "{\n";
-                gen << "    bldr_register_embed(name, data, size_in_bytes);\n";
-                gen << "    return 1;\n";
-                gen << "}\n";
-                gen << "constexpr uint32_t bldr_spirv_data[] {";
-
-                auto spirv_in_path = artifacts_dir / project.name / fs::path(source.file.filename()).replace_extension(".spv");
-                std::ifstream spirv_in(spirv_in_path, std::ios::binary);
-                size_t spirv_byte_size = fs::file_size(spirv_in_path);
-                size_t spirv_count = spirv_byte_size / 4;
-
-                for (size_t j = 0; j < spirv_count; ++j) {
-                    if ((j % 16) == 0) gen << '\n';
-                    uint32_t value;
-                    spirv_in.read(reinterpret_cast<char*>(&value), sizeof(value));
-                    gen << std::format("{},", value);
-                }
+        return embed_resource(project, source, artifacts_dir / project.name / fs::path(source.file.filename()).replace_extension(".spv"));
+    };
 
-                gen << "\n";
-                gen << "};\n";
-                gen << "const int bldr_spirv_registered = bldr_register_embed_call(\"" << spirv_in_path.filename().string() << "\", bldr_spirv_data, " << spirv_byte_size << ");\n";
-                gen << "}\n";
+    // Inherits records the outputs (PCH, imported interfaces) whose dependencies become the
+    // object's own, so changing any header they read rebuilds it
+    auto compile = [&](project_t& project, const source_t& source, const compile_inputs_t& inputs = {},
+        std::span<const fs::path> inherits = {}) -> bool
+    {
+        program_exec_t info;
+        info.working_directory = {(artifacts_dir / project.name).string()};
 
-                // Continue to compile generated source file
+        if (is_set(flags, flags_t::trace)) {
+            log_debug("compiling [{}] into [{}]", source.file.filename().string(), to_string(info.working_directory));
+        }
 
-                spirv_in.close();
-                gen.close();
+        auto obj_path = object_path(project, source);
+        auto deps_path = fs::path(obj_path).replace_extension(
+            (toolchain.dependency_format == dependency_format_t::msvc_json) ? ".deps.json" : ".d");
+        toolchain.compile(info, project, source, obj_path, deps_path, flags, inputs);
+
+        // BMIs are a second output, which the cache does not hold
+        bool cacheable = use_cache && inputs.interface.empty();
+
+        hash_t command_key;
+        if (cacheable) {
+            hasher_t hasher;
+            hasher.update(compiler_identity);
+            for (auto& argument : info.arguments) hasher.update(argument);
+            if (!inputs.pch.empty()) {
+                hasher.update(s_build_state.hash_files(std::array{ inputs.pch.string() }));
+            }
+            command_key = hasher.finish();
 
-                source.type = source_type_t::cpp;
-                source.file = gen_path;
-                info.arguments.clear();
-                generated = true;
+            // Dependencies recorded by the last local compile first, then those seen by other builds
+            auto candidates = action_cache.read_manifest(command_key);
+            if (auto local = s_build_state.get(obj_path); !local.empty()) {
+                std::erase(candidates, local);
+                candidates.insert(candidates.begin(), std::move(local));
             }
 
-            if (generated) {
-#pragma omp critical
-                {
-                    new_compile_tasks.emplace_back(&project, source);
+            bool fetched = false;
+            for (auto& dependencies : candidates) {
+                auto key = hasher_t().update(command_key).update(s_build_state.hash_files(dependencies)).finish();
+                if (action_cache.fetch(key, obj_path)) {
+                    s_build_state.record(obj_path, dependencies);
+                    fetched = true;
+                    break;
                 }
-                continue;
             }
 
-
-            if (is_set(flags, flags_t::trace)) {
-                log_debug("compiling [{}] into [{}]", source.file.filename().string(), to_string(info.working_directory));
+            if (fetched) {
+                log("{} (cached)", source.file.filename().string());
+                cache_hits++;
+                return true;
             }
+        }
 
-            args(info, "cmd", "/c", "cl");
-
-            // TODO: Parameterize
-
-            arg(info, "/c");               // Compile without linking
-            arg(info, "/nologo");          // Suppress banner
-            arg(info, "/arch:AVX2");       // AVX2 vector extensions
-            if (is_set(flags, flags_t::debug)) {
-                arg(info, "/MDd");         // Use dynamic debug CRT
-            } else {
-                arg(info, "/MD");          // Use dynamic non-debug CRT
-            }
-            arg(info, "/Zc:preprocessor"); // Use conforming preprocessor
-            arg(info, "/permissive-");     // Disable permissive mode
-            // arg(info, "/fp:fast");      // Allow floating point reordering
-            arg(info, "/utf-8");           // Set source and execution character sets
-            arg(info, "/Zc:char8_t-");     // Treat u8"" strings as char instead of char8_t
-
-            if (!is_set(flags, flags_t::noopt)) {
-                arg(info, "/O2");          // Maximum optimization level
-                arg(info, "/Ob3");         // Maximum inlining level
+        auto compile_start = std::chrono::steady_clock::now();
+        auto res = execute_program(info, flags, source.file.filename().string());
+        if (res != 0) {
+            log_error("Process failed with code: {}", res);
+            return false;
+        }
+        s_build_state.record_duration(obj_path, std::chrono::steady_clock::now() - compile_start);
+
+        auto dependencies = record_dependencies(obj_path, deps_path, toolchain.dependency_format);
+        if (!dependencies.empty() && !inherits.empty()) {
+            std::unordered_set<std::string> recorded(dependencies.begin(), dependencies.end());
+            for (auto& output : inherits) {
+                for (auto& dependency : s_build_state.get(output)) {
+                    if (recorded.insert(dependency).second) dependencies.push_back(std::move(dependency));
+                }
             }
+            s_build_state.record(obj_path, dependencies);
+        }
+        if (cacheable && !dependencies.empty()) {
+            auto key = hasher_t().update(command_key).update(s_build_state.hash_files(dependencies)).finish();
+            action_cache.store(key, obj_path);
+            action_cache.update_manifest(command_key, dependencies);
+        }
 
-            arg(info, "/cgthreads8");      // threads for optimization + code generation
+        return true;
+    };
 
-            arg(info, "/DUNICODE");        // Specify UNICODE for win32
-            arg(info, "/D_UNICODE");
+    auto precompile = [&](project_t& project, const pch_t& pch) -> bool
+    {
+        program_exec_t info;
+        info.working_directory = {(artifacts_dir / project.name).string()};
 
-            if (is_set(flags, flags_t::lto)) {
-                arg(info, "/GL");          // Enable whole program optimization
-                arg(info, "/Gw");          // Optimize global data
-            }
+        {
+            std::ofstream stub(pch.stub, std::ios::binary);
+            stub << "#include \"" << project.pch.generic_string() << "\"\n";
+        }
 
-            if (!is_set(flags, flags_t::strip)) {
-                arg(info, "/Z7");          // Generate debug info and include in object files
-                arg(info, "/DEBUG");
-            }
+        auto deps_path = fs::path(pch.pch).replace_extension(
+            (toolchain.dependency_format == dependency_format_t::msvc_json) ? ".deps.json" : ".d");
+        toolchain.precompile(info, project, pch.stub, pch.pch, pch.object, deps_path, flags);
 
-            arg(info, "/constexpr:steps10000000"); // Increase constexpr step limit
-
-            arg(info, "/D_CRT_SECURE_NO_WARNINGS"); // Suppress MS "security" warnings
-
-            if (!is_set(flags, flags_t::nowarn)) {
-                arg(info, "/W4");     // Warning level 4
-                arg(info, "/WX");     // Warnings as errors
-
-                arg(info, "/we4289"); // nonstandard extension used: 'variable': loop control variable declared in the for-loop is used outside the for-loop scope
-
-                arg(info, "/w14242"); // 'identifier': conversion from 'type1' to 'type1', possible loss of data
-                arg(info, "/w14254"); // 'operator': conversion from 'type1:field_bits' to 'type2:field_bits', possible loss of data
-                arg(info, "/w14263"); // 'function': member function does not override any base class virtual member function
-                arg(info, "/w14265"); // 'classname': class has virtual functions, but destructor is not virtual instances of this class may not be destructed correctly
-                arg(info, "/w14287"); // 'operator': unsigned/negative constant mismatch
-                arg(info, "/w14296"); // 'operator': expression is always 'boolean_value'
-                arg(info, "/w14311"); // 'variable': pointer truncation from 'type1' to 'type2'
-                arg(info, "/w14545"); // expression before comma evaluates to a function which is missing an argument list
-                arg(info, "/w14546"); // function call before comma missing argument list
-                arg(info, "/w14547"); // 'operator': operator before comma has no effect; expected operator with side effect
-                arg(info, "/w14549"); // 'operator': operator before comma has no effect; did you intend 'operator'?
-                arg(info, "/w14555"); // expression has no effect; expected expression with side- effect
-                arg(info, "/w14640"); // Enable warning on thread unsafe static member initialization
-                arg(info, "/w14826"); // Conversion from 'type1' to 'type_2' is sign-extended. This may cause unexpected runtime behavior.
-                arg(info, "/w14905"); // wide string literal cast to 'LPSTR'
-                arg(info, "/w14906"); // string literal cast to 'LPWSTR'
-                arg(info, "/w14928"); // illegal copy-initialization; more than one user-defined conversion has been implicitly applied
-
-                arg(info, "/wd4324"); // 'struct': structure was padded due to alignment specifier
-                arg(info, "/wd4505"); // 'function': unreferenced function with internal linkage has been removed
-
-                arg(info, "/permissive-"); // standards conformance mode for MSVC compiler.
-            }
+        auto precompile_start = std::chrono::steady_clock::now();
+        auto res = execute_program(info, flags, project.pch.filename().string());
+        if (res != 0) {
+            log_error("Process failed with code: {}", res);
+            return false;
+        }
+        s_build_state.record_duration(pch.pch, std::chrono::steady_clock::now() - precompile_start);
 
-            if (is_set(flags, flags_t::debug)) {
-                arg(info, "/DDEBUG");   // Enable debug checks
-                arg(info, "/D_DEBUG");
-            }
+        record_dependencies(pch.pch, deps_path, toolchain.dependency_format);
+        return true;
+    };
 
-            if (source.type == source_type_t::c) {
-                arg(info, "/std:c23");
-                arg(info, "/Tc", source.file.string());
-            } else {
-                arg(info, "/EHsc");           // Full exception unwinding
-                arg(info, "/openmp:llvm");    // LLVM openmp (enables unsigned loop counters)
-                arg(info, "/Zc:__cplusplus"); // Use correct __cplusplus macro value
-                arg(info, "/std:c++latest");  // Use latest C++ language version
-                if (source.type == source_type_t::cpp) {
-                    arg(info, "/experimental:module"); // Enable modules
-                    arg(info, "/translateInclude");    // Enable header include -> module import translation
-                }
-                arg(info, "/Tp", source.file.string());
-            }
+    std::mutex copy_mutex;
 
-            for (auto& include : project.includes)       arg(info, "/I",  include.string());
-            for (auto& include : project.force_includes) arg(info, "/FI", include.string());
-            for (auto& define  : project.build_defines)  arg(info, "/D", to_string(define));
-            auto res = execute_program(info, flags, source.file.filename().string());
-            if (res != 0) {
-                log_error("Process failed with code: {}", res);
-                errors++;
-            }
-        }
+    auto link_project = [&](project_t& project) -> bool
+    {
+        auto path = toolchain.output_path(project.artifact.value());
+        auto build_path = (artifacts_dir / project.name) / path.filename();
+        auto link_commands = artifacts_dir / project.name / ".link-commands";
 
-        filtered_compile_tasks = std::move(new_compile_tasks);
-    }
+        // Import objects
 
-    timer.segment("cleaning old objects");
+        bool any_changed = is_set(flags, flags_t::clean) || is_set(flags, flags_t::link);
+        auto output_last_write = fs::exists(build_path) ? fs::last_write_time(build_path) : std::filesystem::file_time_type();
 
-    bool any_objs_deleted = false;
+        // TODO: Search for changes through additional links via libpaths
 
-    for (auto& obj_dir : obj_dirs) {
-        if (is_set(flags, flags_t::trace)) {
-            log_debug("Cleaning out obj dir [{}]", to_string(obj_dir));
-        }
-        for (auto& i : fs::directory_iterator(obj_dir)) {
-            if (i.path().extension() != ".obj") continue;
-            if (!generated_objs.contains(i.path())) {
-                if (is_set(flags, flags_t::trace)) {
-                    log_debug("Removing stale object [{}]", to_string(i.path().filename()));
+        std::vector<std::string> objects;
+        for (auto& import : project.imports) {
+            auto dir = artifacts_dir / import;
+            if (!fs::exists(dir)) continue;
+
+            // TODO: Relink when objs removed
+            //       This only catches objects that were *just* removed, and misses any removed indirectly from other builds
+            any_changed |= dirs_with_removed_objs.contains(dir);
+
+            auto iter = fs::directory_iterator(dir);
+            for (auto& file : iter) {
+                if (file.path().extension() == ".obj") {
+                    objects.push_back(fs::relative(file, artifacts_dir).string());
+                    if (file.last_write_time() > output_last_write) {
+                        any_changed |= true;
+                    }
                 }
-                fs::remove(i.path());
-                any_objs_deleted = true;
             }
         }
-    }
 
-    timer.segment("linking");
+        // Check if any link inputs changed
 
-    if (errors == 0) {
-        for (int32_t i = 0; i < projects.size(); ++i) {
-            auto& project = *projects[i];
-            if (!project.artifact) continue;
-
-            auto& artifact = project.artifact.value();
-            auto path = artifact.path;
+        if (any_changed) {
+            log_info("Generating [{}]", path.filename().string());
 
             program_exec_t info;
             info.working_directory = {artifacts_dir.string()};
+            auto prefix = toolchain.link(info, project, build_path, objects, flags);
 
-            args(info, "cmd", "/c", "link", "/nologo");
+            // Write link commands to file, per project as links run concurrently
+
+            {
+                std::ofstream link_out(link_commands);
+                for (size_t j = prefix; j < info.arguments.size(); ++j) {
+                    link_out << '"' << info.arguments[j] << "\"\n";
+                }
+                info.arguments.resize(prefix);
+                arg(info, "@", to_string(link_commands));
 
-            arg(info, "/IGNORE:4099");     // PDB 'filename' was not found with 'object/library' or at 'path'; linking object as if no debug info
-            if (is_set(flags, flags_t::lto)) {
-                arg(info, "/LTCG");
-            } else {
-                arg(info, "/INCREMENTAL"); // Incremental build when not optimizing
             }
-            arg(info, "/DYNAMICBASE:NO");  // Disable address space layout randomization.
 
-            arg(info, "/DEBUG");
+            // Link
 
-            if (is_set(flags, flags_t::debug)) {
-                arg(info, "/NODEFAULTLIB:msvcrt.lib");
-            } else {
-                arg(info, "/NODEFAULTLIB:msvcrtd.lib");
+            auto link_start = std::chrono::steady_clock::now();
+            auto res = execute_program(info, flags, path.filename().string());
+            if (res != 0) {
+                return false;
             }
-            arg(info, "/NODEFAULTLIB:libcmt.lib");
-            arg(info, "/NODEFAULTLIB:libcmtd.lib");
+            s_build_state.record_duration(build_path, std::chrono::steady_clock::now() - link_start);
+        }
 
-            // Target
+        // Copy output
 
-            if (artifact.type == artifact_type_t::console || artifact.type == artifact_type_t::window) {
-                arg(info, "/SUBSYSTEM:", artifact.type == artifact_type_t::console ? "CONSOLE" : "WINDOWS");
-                path.replace_extension(".exe");
-            } else if (artifact.type == artifact_type_t::shared_library) {
-                arg(info, "/DLL");
-                path.replace_extension(".dll");
-            }
+        try {
+            // Projects may share an output directory, and with it shared libraries
+            std::scoped_lock lock{ copy_mutex };
 
-            auto build_path = (artifacts_dir / project.name) / path.filename();
-            arg(info, "/OUT:", build_path.string());
+            fs::create_directories(path.parent_path());
 
-            // Library paths
+            if (any_changed || !fs::exists(path) || fs::last_write_time(build_path) > fs::last_write_time(path)) {
+                fs::remove(path);
+                fs::copy(build_path, path);
+            }
 
-            for (auto& lib_path : project.lib_paths) {
-                arg(info, "/LIBPATH:", lib_path.string());
+            for (auto& shared_lib_glob : project.shared_libs) {
+                for (auto& shared_lib : resolve_glob(shared_lib_glob)) {
+                    auto slib_target = path.parent_path() / shared_lib.filename();
+                    if (!fs::exists(slib_target) || fs::last_write_time(shared_lib) > fs::last_write_time(slib_target)) {
+                        fs::remove(slib_target);
+                        fs::copy(shared_lib, slib_target);
+                    }
+                }
             }
+        } catch (const std::exception& e) {
+            log_error("{}", e.what());
+            return false;
+        }
 
-            // Additional Links
+        return true;
+    };
 
-            for (auto& link : project.links) {
-                arg(info, link.string());
-            }
+    // Build graph. Nodes are weighted by how long their output took to build last time, falling
+    // back to the average of those known.
 
-            // Import objects
+    task_graph_t graph;
 
-            bool any_changed = is_set(flags, flags_t::clean) || is_set(flags, flags_t::link);
-            auto output_last_write = fs::exists(build_path) ? fs::last_write_time(build_path) : std::filesystem::file_time_type();
+    auto add_node = [&](std::string name, const fs::path& output, std::function<bool()> run) {
+        return graph.add(std::move(name), s_build_state.get_duration(output), std::move(run));
+    };
 
-            // TODO: Search for changes through additional links via libpaths
+    // Compile nodes by project name, for links to wait on
+    std::unordered_map<std::string_view, std::vector<uint32_t>> project_nodes;
 
-            // TODO: Relink when objs removed
-            //       This only catches objects that were *just* removed, and misses any removed indirectly from other builds
-            any_changed |= any_objs_deleted;
+    // Precompiled headers come first, links wait on them for the MSVC PCH object
+    for (auto&[project, pch] : pchs) {
+        if (!pch.dirty) continue;
+        pch.node = add_node(project->pch.filename().string(), pch.pch, [&, project = project, pch = &pch] {
+            return precompile(*project, *pch);
+        });
+        project_nodes[project->name].push_back(*pch.node);
+    }
 
-            for (auto& import : project.imports) {
-                auto dir = artifacts_dir / import;
-                if (!fs::exists(dir)) continue;
-                auto iter = fs::directory_iterator(dir);
-                for (auto& file : iter) {
-                    if (file.path().extension() == ".obj") {
-                        auto relative = fs::relative(file, artifacts_dir).string();
-                        arg(info, relative);
-                        if (fs::last_write_time(file.path()) > output_last_write) {
-                            any_changed |= true;
-                        }
-                    }
+    // Compiles wait on the interfaces they import, once every interface has a node
+    std::vector<std::pair<uint32_t, std::vector<module_t*>>> import_edges;
+
+    for (uint32_t i = 0; i < filtered_compile_tasks.size(); ++i) {
+        auto& task = filtered_compile_tasks[i];
+        auto* project = task.project;
+        auto& source = task.source;
+        auto& compile_nodes = project_nodes[project->name];
+
+        if (source.type == source_type_t::embed || source.type == source_type_t::slang) {
+            auto generated = generated_source(*project, source);
+            auto output = embed_objects ? object_path(*project, generated) : generated.file;
+            auto generate = add_node(source.file.filename().string(), output, [&, project, source, output] {
+                auto generate_start = std::chrono::steady_clock::now();
+                bool success = (source.type == source_type_t::embed)
+                    ? generate_embed(*project, source)
+                    : generate_shader(*project, source);
+                if (success) {
+                    s_build_state.record_duration(output, std::chrono::steady_clock::now() - generate_start);
                 }
+                return success;
+            });
+            if (embed_objects) {
+                compile_nodes.push_back(generate);
+                continue;
+            }
+            auto compile_generated = add_node(generated.file.filename().string(), object_path(*project, generated), [&, project, generated] {
+                return compile(*project, generated);
+            });
+            graph.depend(compile_generated, generate);
+            compile_nodes.push_back(compile_generated);
+        } else {
+            compile_inputs_t inputs;
+            std::vector<fs::path> inherits;
+            std::vector<module_t*> imported;
+
+            if (uses_pch(task)) {
+                auto& pch = pchs.at(project);
+                inputs.pch = pch.pch;
+                inherits.push_back(pch.pch);
             }
 
-            // // Mark dlls as lazy load
-            // // TODO: ONLY do this for dlls with a specific flag set in the bldr script
-            // {
-            //     for (auto& shared_lib_glob : project.shared_libs) {
-            //         for (auto& shared_lib : resolve_glob(shared_lib_glob)) {
-            //             arg(info, "/DELAYLOAD:", shared_lib.filename().string());
-            //             // auto slib_target = path.parent_path() / shared_lib.filename();
-            //             // fs::remove(slib_target);
-            //             // fs::copy(shared_lib, slib_target);
-            //         }
-            //     }
-            // }
-            // arg(info, "delayimp.lib");
-
-
-            // Check if any link inputs changed
-
-            if (any_changed) {
-                log_info("Generating [{}]", path.filename().string());
-
-                // Add default windows libraries
-
-                arg(info, "user32.lib");
-                arg(info, "gdi32.lib");
-                arg(info, "shell32.lib");
-                arg(info, "Winmm.lib");
-                arg(info, "Advapi32.lib");
-                arg(info, "Comdlg32.lib");
-                arg(info, "comsuppw.lib");
-                arg(info, "onecore.lib");
-
-                arg(info, "D3D12.lib");
-                arg(info, "DXGI.lib");
-                arg(info, "dcomp.lib");
-                arg(info, "d3d11.lib");
-
-                // Write link commands to file
-
-                {
-                    std::ofstream link_out(s_paths.dir / ".link-commands");
-                    for (uint32_t j = 4; j < info.arguments.size(); ++j) {
-                        link_out << '"' << info.arguments[j] << "\"\n";
-                    }
-                    info.arguments.resize(4);
-                    arg(info, "@", to_string(s_paths.dir / ".link-commands"));
-
+            if (!filtered_units.empty()) {
+                auto& unit = filtered_units[i];
+                if (source.type == source_type_t::cppm && unit.interface) {
+                    inputs.interface = bmi_path(*project, source);
                 }
-
-                // Link
-
-                auto res = execute_program(info, flags, path.filename().string());
-                if (res != 0) {
-                    errors++;
-                    continue;
+                imported = resolve_imports(unit);
+                for (auto* module : imported) {
+                    inputs.imports.emplace_back(module->name, module->bmi);
+                    inherits.push_back(object_path(*module->task.project, module->task.source));
+                }
+                if (!inputs.interface.empty() || !inputs.imports.empty()) {
+                    inputs.module_map = module_map;
                 }
             }
 
-            // Copy output
+            bool is_interface = !inputs.interface.empty();
+            auto id = add_node(source.file.filename().string(), object_path(*project, source),
+                [&, project, source, inputs = std::move(inputs), inherits = std::move(inherits)] {
+                    return compile(*project, source, inputs, inherits);
+                });
+            compile_nodes.push_back(id);
 
-            try {
-                fs::create_directories(path.parent_path());
+            if (uses_pch(task)) {
+                if (auto& pch = pchs.at(project); pch.node) graph.depend(id, *pch.node);
+            }
+            if (is_interface) {
+                modules.at(filtered_units[i].name).node = id;
+            }
+            if (!imported.empty()) {
+                import_edges.emplace_back(id, std::move(imported));
+            }
+        }
+    }
 
-                if (any_changed || !fs::exists(path) || fs::last_write_time(build_path) > fs::last_write_time(path)) {
-                    fs::remove(path);
-                    fs::copy(build_path, path);
-                }
+    for (auto&[id, imported] : import_edges) {
+        for (auto* module : imported) {
+            if (module->node) graph.depend(id, *module->node);
+        }
+    }
 
-                for (auto& shared_lib_glob : project.shared_libs) {
-                    for (auto& shared_lib : resolve_glob(shared_lib_glob)) {
-                        auto slib_target = path.parent_path() / shared_lib.filename();
-                        if (!fs::exists(slib_target) || fs::last_write_time(shared_lib) > fs::last_write_time(slib_target)) {
-                            fs::remove(slib_target);
-                            fs::copy(shared_lib, slib_target);
-                        }
-                    }
-                }
-            } catch (const std::exception& e) {
-                log_error("{}", e.what());
-                errors++;
+    for (auto* project : projects) {
+        if (!project->artifact) continue;
+
+        auto output = toolchain.output_path(project->artifact.value());
+        auto id = add_node(project->name, artifacts_dir / project->name / output.filename(), [&, project] {
+            return link_project(*project);
+        });
+        for (auto& import : project->imports) {
+            if (auto i = project_nodes.find(import); i != project_nodes.end()) {
+                for (auto dependency : i->second) graph.depend(id, dependency);
             }
         }
     }
 
+    {
+        std::chrono::nanoseconds known_total = {};
+        uint32_t known_count = 0;
+        for (auto& node : graph.nodes) {
+            if (node.cost.count() > 0) {
+                known_total += node.cost;
+                known_count++;
+            }
+        }
+        auto fallback = known_count ? known_total / known_count : std::chrono::nanoseconds(1s);
+        for (auto& node : graph.nodes) {
+            if (node.cost.count() == 0) node.cost = fallback;
+        }
+    }
+
+    jobserver_t jobserver;
+    jobserver.init(jobs);
+    auto result = graph.run(jobs, &jobserver);
+    errors += result.failed;
+    aborted += result.skipped;
+
+    if (cache_hits > 0) {
+        log_info("Fetched {} object{} from build cache", cache_hits.load(), (cache_hits == 1) ? "" : "s");
+    }
+
     timer.segment("report");
 
+    s_diagnostics.save();
+
     auto end = std::chrono::steady_clock::now();
 
     if (errors == 0) {
@@ -1091,10 +936,10 @@ bool build_project(std::span<project_t*> projects, flags_t flags)
         return true;
     } else {
         if (aborted > 0) {
-            log_warn("Aborted {} files after errors", aborted.load());
+            log_warn("Skipped {} step{} after errors", aborted, (aborted == 1) ? "" : "s");
         }
         log_error("------------------------------------------------------------------------");
-        log_error("\u001B[91mBuild Failure!\u001B[0m | Errors: {}", errors.load());
+        log_error("\u001B[91mBuild Failure!\u001B[0m | Errors: {}", errors);
         log_error("------------------------------------------------------------------------");
         return false;
     }
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "hash.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+
+// Content addressed store for build outputs, keyed by a digest of everything that can change
+// them (compiler environment, command line, source and transitive include contents). Entries
+// are written to a temporary file and renamed into place, so a directory shared between
+// concurrent builds never exposes a partially written object.
+//
+// The files a compile reads are only known once it has run, so lookups go through a manifest
+// keyed on the command line alone, listing the dependency sets previously seen for it. The
+// output key is then derived from the contents of each set in turn.
+struct action_cache_t
+{
+    static constexpr size_t max_manifest_entries = 8;
+
+    fs::path dir;
+
+public:
+    fs::path entry_path(const hash_t& key) const
+    {
+        auto name = key.to_string();
+        return dir / name.substr(0, 2) / name;
+    }
+
+    // Copies the cached output for key to output, returns false on a miss. Copies keep the
+    // entry's timestamp, so the output is touched to be newer than its sources and anything
+    // linked from it.
+    bool fetch(const hash_t& key, const fs::path& output) const
+    {
+        std::error_code ec;
+        if (!fs::copy_file(entry_path(key), output, fs::copy_options::overwrite_existing, ec) || ec) {
+            return false;
+        }
+        fs::last_write_time(output, fs::file_time_type::clock::now(), ec);
+        return !ec;
+    }
+
+    // Failures only cost a future cache hit, so are reported but never fail the build
+    void store(const hash_t& key, const fs::path& output) const
+    {
+        commit(entry_path(key), output.filename().string(), [&](const fs::path& temp, std::error_code& ec) {
+            fs::copy_file(output, temp, fs::copy_options::overwrite_existing, ec);
+        });
+    }
+
+    // Most recent first
+    std::vector<std::vector<std::string>> read_manifest(const hash_t& key) const
+    {
+        std::vector<std::vector<std::string>> lists(1);
+
+        std::ifstream in(manifest_path(key), std::ios::binary);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty()) {
+                lists.back().push_back(std::move(line));
+            } else if (!lists.back().empty()) {
+                lists.emplace_back();
+            }
+        }
+
+        if (lists.back().empty()) {
+            lists.pop_back();
+        }
+        return lists;
+    }
+
+    void update_manifest(const hash_t& key, std::span<const std::string> dependencies) const
+    {
+        auto lists = read_manifest(key);
+        std::erase_if(lists, [&](auto& list) { return std::ranges::equal(list, dependencies); });
+        if (lists.size() >= max_manifest_entries) {
+            lists.resize(max_manifest_entries - 1);
+        }
+
+        commit(manifest_path(key), "manifest", [&](const fs::path& temp, std::error_code& ec) {
+            std::ofstream out(temp, std::ios::binary);
+            for (auto& dependency : dependencies) out << dependency << '\n';
+            for (auto& list : lists) {
+                out << '\n';
+                for (auto& dependency : list) out << dependency << '\n';
+            }
+            if (!out) ec = std::make_error_code(std::errc::io_error);
+        });
+    }
+
+private:
+    fs::path manifest_path(const hash_t& key) const
+    {
+        return fs::path(entry_path(key).string() + ".manifest");
+    }
+
+    template<class Fn>
+    void commit(const fs::path& entry, std::string_view name, Fn&& write) const
+    {
+        auto temp = fs::path(std::format("{}.{:08x}.tmp", entry.string(), std::random_device{}()));
+
+        std::error_code ec;
+        fs::create_directories(entry.parent_path(), ec);
+        if (!ec) write(temp, ec);
+        if (!ec) fs::rename(temp, entry, ec);
+        if (ec) {
+            log_warn("Failed to store [{}] in build cache: {}", name, ec.message());
+            fs::remove(temp, ec);
+        }
+    }
+};
\ No newline at end of file
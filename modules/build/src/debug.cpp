@@ -65,6 +65,10 @@ void debug_project(project_t& project)
     print_all("build_defines",  project.build_defines);
     print_all("defines",        project.defines);
 
+    if (!project.pch.empty()) {
+        std::cout << "  pch: " << project.pch << '\n';
+    }
+
     if (project.artifact) {
         std::cout << "  artifact: " << project.artifact.value() << '\n';
     }
@@ -0,0 +1,187 @@
+#include "deps.hpp"
+
+#include <cctype>
+#include <cstring>
+
+// -----------------------------------------------------------------------------
+//                              Report parsing
+// -----------------------------------------------------------------------------
+
+namespace
+{
+    // Just enough JSON to walk /sourceDependencies output, collecting the strings stored
+    // under Source, Includes and header unit Header keys
+    struct json_scanner_t
+    {
+        std::string_view          text;
+        size_t                     pos = 0;
+        std::vector<std::string>&  out;
+
+        void skip_whitespace()
+        {
+            while (pos < text.size() && std::isspace((unsigned char)text[pos])) pos++;
+        }
+
+        bool consume(char c)
+        {
+            skip_whitespace();
+            if (pos < text.size() && text[pos] == c) {
+                pos++;
+                return true;
+            }
+            return false;
+        }
+
+        bool string(std::string& str)
+        {
+            if (!consume('"')) return false;
+            while (pos < text.size()) {
+                char c = text[pos++];
+                if (c == '"') return true;
+                if (c != '\\') {
+                    str.push_back(c);
+                    continue;
+                }
+                if (pos >= text.size()) return false;
+                switch (char e = text[pos++]) {
+                    break;case 'n': str.push_back('\n');
+                    break;case 't': str.push_back('\t');
+                    break;case 'r': str.push_back('\r');
+                    break;case 'b': str.push_back('\b');
+                    break;case 'f': str.push_back('\f');
+                    break;case 'u': {
+                        if (pos + 4 > text.size()) return false;
+                        uint32_t cp = 0;
+                        for (uint32_t i = 0; i < 4; ++i) {
+                            char h = text[pos++];
+                            cp <<= 4;
+                            if      (h >= '0' && h <= '9') cp |= uint32_t(h - '0');
+                            else if (h >= 'a' && h <= 'f') cp |= uint32_t(h - 'a' + 10);
+                            else if (h >= 'A' && h <= 'F') cp |= uint32_t(h - 'A' + 10);
+                            else return false;
+                        }
+                        // Paths are not expected to contain surrogate pairs, encode the BMP only
+                        if (cp < 0x80) {
+                            str.push_back(char(cp));
+                        } else if (cp < 0x800) {
+                            str.push_back(char(0xc0 | (cp >> 6)));
+                            str.push_back(char(0x80 | (cp & 0x3f)));
+                        } else {
+                            str.push_back(char(0xe0 | (cp >> 12)));
+                            str.push_back(char(0x80 | ((cp >> 6) & 0x3f)));
+                            str.push_back(char(0x80 | (cp & 0x3f)));
+                        }
+                    }
+                    break;default: str.push_back(e);
+                }
+            }
+            return false;
+        }
+
+        bool value(bool collect)
+        {
+            skip_whitespace();
+            if (pos >= text.size()) return false;
+
+            switch (text[pos]) {
+                break;case '"': {
+                    std::string str;
+                    if (!string(str)) return false;
+                    if (collect && !str.empty()) out.push_back(std::move(str));
+                    return true;
+                }
+                break;case '[': {
+                    pos++;
+                    if (consume(']')) return true;
+                    do {
+                        if (!value(collect)) return false;
+                    } while (consume(','));
+                    return consume(']');
+                }
+                break;case '{': {
+                    pos++;
+                    if (consume('}')) return true;
+                    do {
+                        std::string key;
+                        if (!string(key) || !consume(':')) return false;
+                        if (!value(key == "Source" || key == "Includes" || key == "Header")) return false;
+                    } while (consume(','));
+                    return consume('}');
+                }
+                break;default: {
+                    // Numbers, booleans and null
+                    while (pos < text.size() && !std::strchr(",]} \t\r\n", text[pos])) pos++;
+                    return true;
+                }
+            }
+        }
+    };
+
+    // "target: dep1 dep2", with long lines split by backslash-newline. Spaces in paths are
+    // escaped with a backslash, and $ is doubled. Only the first rule is read, later rules
+    // are phony targets added by -MP.
+    bool parse_makefile(std::string_view text, std::vector<std::string>& out)
+    {
+        std::string token;
+        bool in_targets = true;
+
+        auto finish_token = [&] {
+            if (token.empty()) return;
+            if (in_targets) {
+                // Everything up to the first token ending in ':' is a target
+                in_targets = !token.ends_with(':');
+            } else {
+                out.push_back(std::move(token));
+            }
+            token.clear();
+        };
+
+        for (size_t i = 0; i < text.size(); ++i) {
+            char c = text[i];
+            if (c == '\\' && i + 1 < text.size()) {
+                char n = text[i + 1];
+                if (n == ' ' || n == '#') {
+                    token.push_back(n);
+                    i++;
+                    continue;
+                }
+                if (n == '\n' || (n == '\r' && i + 2 < text.size() && text[i + 2] == '\n')) {
+                    finish_token();
+                    i += (n == '\r') ? 2 : 1;
+                    continue;
+                }
+            }
+            if (c == '$' && i + 1 < text.size() && text[i + 1] == '$') {
+                token.push_back('$');
+                i++;
+                continue;
+            }
+            if (c == '\n') {
+                finish_token();
+                if (!in_targets) break;
+                continue;
+            }
+            if (c == ' ' || c == '\t' || c == '\r') {
+                finish_token();
+                continue;
+            }
+            token.push_back(c);
+        }
+        finish_token();
+
+        return !in_targets;
+    }
+}
+
+bool parse_dependencies(std::string_view text, dependency_format_t format, std::vector<std::string>& out)
+{
+    switch (format) {
+        break;case dependency_format_t::msvc_json: {
+            json_scanner_t scanner{ text, 0, out };
+            return scanner.value(false);
+        }
+        break;case dependency_format_t::makefile:
+            return parse_makefile(text, out);
+    }
+    return false;
+}
\ No newline at end of file
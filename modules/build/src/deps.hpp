@@ -0,0 +1,17 @@
+#pragma once
+
+#include <bldr.hpp>
+
+// -----------------------------------------------------------------------------
+//                        Compiler reported dependencies
+// -----------------------------------------------------------------------------
+
+enum class dependency_format_t
+{
+    msvc_json, // cl /sourceDependencies
+    makefile,  // gcc/clang -MD -MF
+};
+
+// Appends every file the compiler read, including the source itself. Returns false if
+// the report is malformed.
+bool parse_dependencies(std::string_view text, dependency_format_t format, std::vector<std::string>& out);
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "diagnostics.hpp"
+#include "json.hpp"
+#include "log.hpp"
+
+#include <array>
+#include <charconv>
+#include <fstream>
+
+namespace
+{
+    struct severity_name_t
+    {
+        std::string_view     name;
+        severity_t       severity;
+    };
+
+    // Longest first, "fatal error" must win over "error"
+    constexpr std::array severity_names {
+        severity_name_t{ "fatal error", severity_t::fatal   },
+        severity_name_t{ "error",       severity_t::error   },
+        severity_name_t{ "warning",     severity_t::warning },
+        severity_name_t{ "note",        severity_t::note    },
+    };
+
+    std::string_view to_string(severity_t severity)
+    {
+        switch (severity) {
+            break;case severity_t::note:    return "note";
+            break;case severity_t::warning: return "warning";
+            break;case severity_t::error:   return "error";
+            break;case severity_t::fatal:   return "fatal";
+        }
+        return "error";
+    }
+
+    std::string_view trim(std::string_view str)
+    {
+        while (!str.empty() && (str.front() == ' ' || str.front() == '\t')) str.remove_prefix(1);
+        while (!str.empty() && (str.back()  == ' ' || str.back()  == '\t')) str.remove_suffix(1);
+        return str;
+    }
+
+    bool parse_number(std::string_view str, uint32_t& value)
+    {
+        if (str.empty()) return false;
+        auto[end, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+        return ec == std::errc{} && end == str.data() + str.size();
+    }
+
+    void parse_location(std::string_view location, diagnostic_t& diag)
+    {
+        location = trim(location);
+
+        // MSVC: file(line) or file(line,column)
+        if (location.ends_with(')')) {
+            if (auto open = location.rfind('('); open != std::string_view::npos) {
+                auto position = location.substr(open + 1, location.size() - open - 2);
+                auto comma = position.find(',');
+                if (parse_number(position.substr(0, comma), diag.line)) {
+                    if (comma != std::string_view::npos) {
+                        parse_number(position.substr(comma + 1), diag.column);
+                    }
+                    diag.file = trim(location.substr(0, open));
+                    return;
+                }
+            }
+        }
+
+        // gcc/clang: file:line or file:line:column. Drive letters are never all digits.
+        std::array<uint32_t, 2> numbers;
+        uint32_t count = 0;
+        while (count < numbers.size()) {
+            auto colon = location.rfind(':');
+            if (colon == std::string_view::npos || !parse_number(location.substr(colon + 1), numbers[count])) break;
+            location = location.substr(0, colon);
+            count++;
+        }
+        if (count == 1) {
+            diag.line = numbers[0];
+        } else if (count == 2) {
+            diag.line = numbers[1];
+            diag.column = numbers[0];
+        }
+        diag.file = location;
+    }
+
+    bool parse_line(std::string_view line, diagnostic_t& diag)
+    {
+        for (auto pos = line.find(": "); pos != std::string_view::npos; pos = line.find(": ", pos + 1)) {
+            auto rest = line.substr(pos + 2);
+            for (auto& name : severity_names) {
+                if (!rest.starts_with(name.name)) continue;
+                auto after = rest.substr(name.name.size());
+
+                if (after.starts_with(": ")) {
+                    diag.code.clear();
+                    diag.message = after.substr(2);
+                } else if (after.starts_with(' ')) {
+                    // MSVC puts a code between the severity and the message
+                    auto colon = after.find(": ");
+                    if (colon == std::string_view::npos) continue;
+                    auto code = after.substr(1, colon - 1);
+                    if (code.empty() || code.contains(' ')) continue;
+                    diag.code = code;
+                    diag.message = after.substr(colon + 2);
+                } else {
+                    continue;
+                }
+
+                diag.severity = name.severity;
+                diag.line = 0;
+                diag.column = 0;
+                parse_location(line.substr(0, pos), diag);
+                return !diag.file.empty();
+            }
+        }
+        return false;
+    }
+}
+
+void parse_diagnostics(std::string_view task, std::string_view output, std::vector<diagnostic_t>& out)
+{
+    while (!output.empty()) {
+        auto end = output.find('\n');
+        auto line = output.substr(0, end);
+        output = (end == std::string_view::npos) ? std::string_view{} : output.substr(end + 1);
+
+        if (line.ends_with('\r')) line.remove_suffix(1);
+
+        diagnostic_t diag;
+        if (parse_line(line, diag)) {
+            diag.task = task;
+            out.push_back(std::move(diag));
+        }
+    }
+}
+
+void diagnostics_t::add(std::string_view task, std::string_view output)
+{
+    if (path.empty() || output.empty()) {
+        return;
+    }
+
+    std::vector<diagnostic_t> parsed;
+    parse_diagnostics(task, output, parsed);
+    if (parsed.empty()) {
+        return;
+    }
+
+    std::scoped_lock lock{ mutex };
+    records.insert(records.end(), std::make_move_iterator(parsed.begin()), std::make_move_iterator(parsed.end()));
+}
+
+void diagnostics_t::save()
+{
+    if (path.empty()) {
+        return;
+    }
+
+    if (path.has_parent_path()) {
+        fs::create_directories(path.parent_path());
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        log_error("Failed to write diagnostics to [{}]", path.string());
+        return;
+    }
+
+    json_writer_t json(out);
+    json.array();
+    for (auto& diag : records) {
+        json.object();
+        json["task"] = diag.task;
+        json["file"] = diag.file;
+        json["line"] = diag.line;
+        json["column"] = diag.column;
+        json["severity"] = to_string(diag.severity);
+        if (!diag.code.empty()) {
+            json["code"] = diag.code;
+        }
+        json["message"] = diag.message;
+        json.end_object();
+    }
+    json.end_array();
+}
\ No newline at end of file
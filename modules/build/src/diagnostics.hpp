@@ -0,0 +1,47 @@
+#pragma once
+
+#include <bldr.hpp>
+
+#include <mutex>
+
+// -----------------------------------------------------------------------------
+//                                Diagnostics
+// -----------------------------------------------------------------------------
+
+enum class severity_t
+{
+    note,
+    warning,
+    error,
+    fatal,
+};
+
+struct diagnostic_t
+{
+    std::string      task; // Name of the build step that reported it
+    std::string      file; // Tool name (e.g. LINK, collect2) when not about a source location
+    uint32_t         line = 0;
+    uint32_t       column = 0;
+    severity_t   severity;
+    std::string      code; // MSVC style codes (C2065, LNK2019), empty for gcc/clang
+    std::string   message;
+};
+
+// Picks out MSVC "file(line[,col]): error C1234: message" and gcc/clang
+// "file:line[:col]: error: message" lines from captured tool output. Other lines (source
+// excerpts, carets, include stacks) are ignored.
+void parse_diagnostics(std::string_view task, std::string_view output, std::vector<diagnostic_t>& out);
+
+// Diagnostics collected from every step of a build, written out as JSON when a path is set
+struct diagnostics_t
+{
+    std::mutex                       mutex;
+    fs::path                          path;
+    std::vector<diagnostic_t>      records;
+
+public:
+    void add(std::string_view task, std::string_view output);
+    void save();
+};
+
+inline diagnostics_t s_diagnostics;
\ No newline at end of file
@@ -0,0 +1,263 @@
+#include "embed.hpp"
+#include "hash.hpp"
+#include "log.hpp"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    // void bldr_register_embed(const char*, const void*, size_t), as mangled by MSVC for x64
+    constexpr std::string_view RegisterEmbedSymbol = "?bldr_register_embed@@YAXPEBDPEBX_K@Z";
+
+    constexpr uint16_t ImageFileMachineAmd64 = 0x8664;
+
+    constexpr uint32_t ImageScnCntCode              = 0x0000'0020;
+    constexpr uint32_t ImageScnCntInitializedData   = 0x0000'0040;
+    constexpr uint32_t ImageScnAlign8Bytes          = 0x0040'0000;
+    constexpr uint32_t ImageScnAlign16Bytes         = 0x0050'0000;
+    constexpr uint32_t ImageScnMemExecute           = 0x2000'0000;
+    constexpr uint32_t ImageScnMemRead              = 0x4000'0000;
+
+    constexpr uint16_t ImageRelAmd64Addr64 = 0x0001;
+    constexpr uint16_t ImageRelAmd64Rel32  = 0x0004;
+
+    constexpr uint8_t ImageSymClassExternal = 2;
+    constexpr uint8_t ImageSymClassStatic   = 3;
+    constexpr uint16_t ImageSymTypeFunction = 0x20;
+
+    constexpr uint32_t FileHeaderSize    = 20;
+    constexpr uint32_t SectionHeaderSize = 40;
+    constexpr uint32_t RelocationSize    = 10;
+
+    // Escapes for both C++ string literals and assembler strings
+    std::string escape(std::string_view str)
+    {
+        std::string escaped;
+        for (char c : str) {
+            if (c == '\\' || c == '"') escaped.push_back('\\');
+            escaped.push_back(c);
+        }
+        return escaped;
+    }
+}
+
+bool write_coff_embed(const fs::path& object, std::string_view name, const fs::path& resource)
+{
+    std::ifstream in(resource, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        log_error("Failed to open [{}] for embedding", resource.string());
+        return false;
+    }
+    uint64_t size = uint64_t(in.tellg());
+    in.seekg(0);
+
+    // Sections, in file order:
+    //   .rdata    - name, then the resource aligned to 16 bytes
+    //   .text     - lea rcx, [name]; lea rdx, [data]; mov r8, size; jmp bldr_register_embed
+    //   .CRT$XCU  - pointer to .text, run by the CRT along with C++ dynamic initializers
+
+    uint32_t data_offset = (uint32_t(name.size()) + 1 + 15) & ~15u;
+    if (data_offset + size > UINT32_MAX) {
+        log_error("[{}] is too large to embed", resource.string());
+        return false;
+    }
+    uint32_t rdata_size = data_offset + uint32_t(size);
+
+    std::array<uint8_t, 29> code {
+        0x48, 0x8D, 0x0D, 0, 0, 0, 0, // lea rcx, [rip + rel32]
+        0x48, 0x8D, 0x15, 0, 0, 0, 0, // lea rdx, [rip + rel32]
+        0x49, 0xB8, 0, 0, 0, 0, 0, 0, 0, 0, // mov r8, imm64
+        0xE9, 0, 0, 0, 0, // jmp rel32
+    };
+    std::memcpy(&code[10], &data_offset, 4); // REL32 addends are stored in place
+    std::memcpy(&code[16], &size, 8);
+
+    uint32_t rdata_offset = FileHeaderSize + SectionHeaderSize * 3;
+    uint32_t text_offset = rdata_offset + rdata_size;
+    uint32_t text_relocations = text_offset + uint32_t(code.size());
+    uint32_t crt_offset = text_relocations + RelocationSize * 3;
+    uint32_t crt_relocations = crt_offset + 8;
+    uint32_t symbol_table = crt_relocations + RelocationSize;
+
+    std::string out;
+
+    auto WriteUInt8 = [&](uint8_t v) {
+        out.push_back(char(v));
+    };
+
+    auto WriteUInt16 = [&](uint16_t v) {
+        out.append((const char*)&v, 2);
+    };
+
+    auto WriteUInt32 = [&](uint32_t v) {
+        out.append((const char*)&v, 4);
+    };
+
+    auto WriteUInt64 = [&](uint64_t v) {
+        out.append((const char*)&v, 8);
+    };
+
+    auto WriteName = [&](std::string_view section) {
+        std::array<char, 8> padded{};
+        section.copy(padded.data(), padded.size());
+        out.append(padded.data(), padded.size());
+    };
+
+    auto WriteSection = [&](std::string_view section, uint32_t data_size, uint32_t data_ptr,
+            uint32_t relocations_ptr, uint16_t relocations, uint32_t characteristics) {
+        WriteName(section);
+        WriteUInt32(0); // VirtualSize
+        WriteUInt32(0); // VirtualAddress
+        WriteUInt32(data_size);
+        WriteUInt32(data_ptr);
+        WriteUInt32(relocations_ptr);
+        WriteUInt32(0); // PointerToLinenumbers
+        WriteUInt16(relocations);
+        WriteUInt16(0); // NumberOfLinenumbers
+        WriteUInt32(characteristics);
+    };
+
+    auto WriteRelocation = [&](uint32_t offset, uint32_t symbol, uint16_t type) {
+        WriteUInt32(offset);
+        WriteUInt32(symbol);
+        WriteUInt16(type);
+    };
+
+    // Section symbol followed by its section definition auxiliary record
+    auto WriteSectionSymbol = [&](std::string_view section, int16_t number, uint32_t length, uint16_t relocations) {
+        WriteName(section);
+        WriteUInt32(0); // Value
+        WriteUInt16(uint16_t(number));
+        WriteUInt16(0); // Type
+        WriteUInt8(ImageSymClassStatic);
+        WriteUInt8(1);
+        WriteUInt32(length);
+        WriteUInt16(relocations);
+        WriteUInt16(0); // NumberOfLinenumbers
+        WriteUInt32(0); // CheckSum
+        WriteUInt16(0); // Number
+        WriteUInt8(0);  // Selection
+        out.append(3, '\0');
+    };
+
+    // Header and section table
+
+    WriteUInt16(ImageFileMachineAmd64);
+    WriteUInt16(3);
+    WriteUInt32(0); // TimeDateStamp, left out for reproducible objects
+    WriteUInt32(symbol_table);
+    WriteUInt32(7);
+    WriteUInt16(0); // SizeOfOptionalHeader
+    WriteUInt16(0); // Characteristics
+
+    WriteSection(".rdata", rdata_size, rdata_offset, 0, 0,
+        ImageScnCntInitializedData | ImageScnAlign16Bytes | ImageScnMemRead);
+    WriteSection(".text", uint32_t(code.size()), text_offset, text_relocations, 3,
+        ImageScnCntCode | ImageScnAlign16Bytes | ImageScnMemExecute | ImageScnMemRead);
+    WriteSection(".CRT$XCU", 8, crt_offset, crt_relocations, 1,
+        ImageScnCntInitializedData | ImageScnAlign8Bytes | ImageScnMemRead);
+
+    out.append(name);
+    out.append(data_offset - name.size(), '\0');
+
+    std::ofstream file(object, std::ios::binary);
+    file.write(out.data(), out.size());
+    if (size > 0) {
+        file << in.rdbuf();
+    }
+    out.clear();
+
+    // Registration code, initializer and symbols. Symbols 0, 2 and 4 are the sections, each
+    // followed by an auxiliary record, and 6 the external registration function.
+
+    out.append((const char*)code.data(), code.size());
+    WriteRelocation(3, 0, ImageRelAmd64Rel32);
+    WriteRelocation(10, 0, ImageRelAmd64Rel32);
+    WriteRelocation(25, 6, ImageRelAmd64Rel32);
+
+    WriteUInt64(0);
+    WriteRelocation(0, 2, ImageRelAmd64Addr64);
+
+    WriteSectionSymbol(".rdata", 1, rdata_size, 0);
+    WriteSectionSymbol(".text", 2, uint32_t(code.size()), 3);
+    WriteSectionSymbol(".CRT$XCU", 3, 8, 1);
+
+    WriteUInt32(0); // Long names are offsets into the string table
+    WriteUInt32(4);
+    WriteUInt32(0); // Value
+    WriteUInt16(0); // Undefined
+    WriteUInt16(ImageSymTypeFunction);
+    WriteUInt8(ImageSymClassExternal);
+    WriteUInt8(0);
+
+    WriteUInt32(4 + uint32_t(RegisterEmbedSymbol.size()) + 1);
+    out.append(RegisterEmbedSymbol);
+    out.push_back('\0');
+
+    file.write(out.data(), out.size());
+    if (!file) {
+        log_error("Failed to write embed object [{}]", object.string());
+        return false;
+    }
+
+    return true;
+}
+
+bool write_incbin_embed(const fs::path& source, std::string_view name, const fs::path& resource)
+{
+    auto path = fs::absolute(resource).string();
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        log_error("Failed to open [{}] for embedding", path);
+        return false;
+    }
+
+    // Symbols are named by path and contents, so they are unique within a link and each
+    // version of the resource produces a different source
+
+    hasher_t hasher;
+    hasher.update(path);
+    uint64_t size = 0;
+    std::array<char, UINT16_MAX> buffer;
+    while (in.read(buffer.data(), buffer.size()) || in.gcount() > 0) {
+        hasher.update(buffer.data(), size_t(in.gcount()));
+        size += uint64_t(in.gcount());
+    }
+    auto symbol = std::format("bldr_embed_{}", hasher.finish().to_string());
+
+    std::ofstream gen(source, std::ios::binary);
+    gen << "#include <cstddef>\n";
+    gen << "void bldr_register_embed(const char* name, const void* data, size_t size_in_bytes);\n";
+    gen << "extern \"C\" __attribute__((visibility(\"hidden\"))) const unsigned char " << symbol << "[];\n";
+    gen << "asm(\n";
+    // Mach-O has no .rodata or .hidden, and prefixes C symbols with an underscore
+    gen << "#ifdef __APPLE__\n";
+    gen << "    \".pushsection __TEXT,__const\\n\"\n";
+    gen << "    \".balign 16\\n\"\n";
+    gen << "    \".globl _" << symbol << "\\n\"\n";
+    gen << "    \".private_extern _" << symbol << "\\n\"\n";
+    gen << "    \"_" << symbol << ":\\n\"\n";
+    gen << "#else\n";
+    gen << "    \".pushsection .rodata\\n\"\n";
+    gen << "    \".balign 16\\n\"\n";
+    gen << "    \".globl " << symbol << "\\n\"\n";
+    gen << "    \".hidden " << symbol << "\\n\"\n";
+    gen << "    \"" << symbol << ":\\n\"\n";
+    gen << "#endif\n";
+    gen << "    \".incbin \\\"" << escape(escape(path)) << "\\\"\\n\"\n";
+    gen << "    \".popsection\\n\"\n";
+    gen << ");\n";
+    gen << "namespace {\n";
+    gen << "const int bldr_embed_registered = (bldr_register_embed(\"" << escape(name) << "\", " << symbol << ", " << size << "), 1);\n";
+    gen << "}\n";
+
+    if (!gen) {
+        log_error("Failed to write embed source [{}]", source.string());
+        return false;
+    }
+
+    return true;
+}
\ No newline at end of file
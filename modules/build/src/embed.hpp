@@ -0,0 +1,23 @@
+#pragma once
+
+#include <bldr.hpp>
+
+// -----------------------------------------------------------------------------
+//                             Resource embedding
+// -----------------------------------------------------------------------------
+
+// Embedded resources register themselves before main through
+//
+//     void bldr_register_embed(const char* name, const void* data, size_t size_in_bytes);
+//
+// Neither backend turns the resource into source code, so embedding costs about as much as
+// copying the file.
+
+// Writes an x64 COFF object directly, holding the resource and a .CRT$XCU initializer that
+// registers it. No compiler is run.
+bool write_coff_embed(const fs::path& object, std::string_view name, const fs::path& resource);
+
+// Writes a C++ source including the resource with the assembler's .incbin, for gcc and clang
+// targeting ELF. The source only changes with the resource's contents, so it stays valid as a
+// build cache key even though compilers do not report .incbin files as dependencies.
+bool write_incbin_embed(const fs::path& source, std::string_view name, const fs::path& resource);
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "graph.hpp"
+#include "jobserver.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <ranges>
+#include <thread>
+
+uint32_t task_graph_t::add(std::string name, std::chrono::nanoseconds cost, std::function<bool()> run)
+{
+    auto id = uint32_t(nodes.size());
+    nodes.push_back({ .name = std::move(name), .cost = cost, .run = std::move(run) });
+    return id;
+}
+
+void task_graph_t::depend(uint32_t node, uint32_t dependency)
+{
+    nodes[dependency].successors.push_back(node);
+    nodes[node].predecessors++;
+}
+
+task_graph_t::result_t task_graph_t::run(uint32_t jobs, jobserver_t* jobserver)
+{
+    result_t result;
+    if (nodes.empty()) {
+        return result;
+    }
+
+    // Critical path lengths, from the sinks back through a topological order
+
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> remaining(nodes.size());
+    order.reserve(nodes.size());
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        remaining[i] = nodes[i].predecessors;
+        if (remaining[i] == 0) order.push_back(i);
+    }
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (auto successor : nodes[order[i]].successors) {
+            if (--remaining[successor] == 0) order.push_back(successor);
+        }
+    }
+    if (order.size() != nodes.size()) {
+        log_error("Build graph contains a cycle");
+        result.failed = uint32_t(nodes.size());
+        return result;
+    }
+    for (auto i : order | std::views::reverse) {
+        auto& node = nodes[i];
+        std::chrono::nanoseconds longest = {};
+        for (auto successor : node.successors) {
+            longest = std::max(longest, nodes[successor].critical_path);
+        }
+        node.critical_path = node.cost + longest;
+    }
+
+    // Execute
+
+    auto by_critical_path = [&](uint32_t l, uint32_t r) {
+        return nodes[l].critical_path < nodes[r].critical_path;
+    };
+    std::priority_queue<uint32_t, std::vector<uint32_t>, decltype(by_critical_path)> ready(by_critical_path);
+
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        remaining[i] = nodes[i].predecessors;
+        if (remaining[i] == 0) ready.push(i);
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t unfinished = nodes.size();
+
+    // Skipped nodes are finished without running, along with everything after them
+    auto skip = [&](this auto&& self, uint32_t id) -> void {
+        for (auto successor : nodes[id].successors) {
+            if (remaining[successor] != UINT32_MAX) {
+                remaining[successor] = UINT32_MAX;
+                result.skipped++;
+                unfinished--;
+                self(successor);
+            }
+        }
+    };
+
+    // The calling thread runs on the implicit slot every process owns, other workers need a token
+    auto worker = [&](bool implicit_slot) {
+        std::unique_lock lock{ mutex };
+        for (;;) {
+            cv.wait(lock, [&] { return !ready.empty() || unfinished == 0; });
+            if (ready.empty()) {
+                return;
+            }
+
+            // Take a token before a node, so the most critical ready node always goes to a thread
+            // able to run it rather than one still waiting on the jobserver
+
+            bool token = false;
+            if (!implicit_slot && jobserver) {
+                lock.unlock();
+                token = jobserver->acquire();
+                lock.lock();
+                if (ready.empty()) {
+                    if (token) {
+                        lock.unlock();
+                        jobserver->release();
+                        lock.lock();
+                    }
+                    continue;
+                }
+            }
+
+            auto id = ready.top();
+            ready.pop();
+
+            lock.unlock();
+            bool success = nodes[id].run();
+            if (token) jobserver->release();
+            lock.lock();
+
+            unfinished--;
+            if (success) {
+                for (auto successor : nodes[id].successors) {
+                    if (remaining[successor] != UINT32_MAX && --remaining[successor] == 0) {
+                        ready.push(successor);
+                    }
+                }
+            } else {
+                result.failed++;
+                skip(id);
+            }
+            cv.notify_all();
+        }
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        for (uint32_t i = 1; i < std::min<size_t>(std::max(jobs, 1u), nodes.size()); ++i) {
+            workers.emplace_back(worker, false);
+        }
+        worker(true);
+
+        // Everything has finished, wake workers still waiting for a token
+        if (jobserver) jobserver->cancel();
+    }
+
+    return result;
+}
\ No newline at end of file
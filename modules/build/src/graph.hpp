@@ -0,0 +1,47 @@
+#pragma once
+
+#include <bldr.hpp>
+
+#include <functional>
+
+struct jobserver_t;
+
+// -----------------------------------------------------------------------------
+//                                 Task graph
+// -----------------------------------------------------------------------------
+
+// Runs build steps as soon as everything they depend on has finished, on a bounded number of
+// job slots. When more steps are ready than slots are free, those heading the longest chain of
+// remaining work (by estimated cost) go first, so steps gating generated sources and slow links
+// are not queued behind independent work.
+struct task_graph_t
+{
+    struct node_t
+    {
+        std::string                        name;
+        std::chrono::nanoseconds           cost;
+        std::function<bool()>               run; // Returns false on failure
+        std::vector<uint32_t>        successors;
+        uint32_t                   predecessors = 0;
+        std::chrono::nanoseconds  critical_path = {}; // Cost of the longest chain starting here
+    };
+
+    std::vector<node_t> nodes;
+
+public:
+    uint32_t add(std::string name, std::chrono::nanoseconds cost, std::function<bool()> run);
+
+    // The node will not start before the dependency has succeeded
+    void depend(uint32_t node, uint32_t dependency);
+
+    struct result_t
+    {
+        uint32_t  failed = 0;
+        uint32_t skipped = 0; // Not run as a dependency failed
+    };
+
+    // Independent work keeps going after a failure, only the failed node's dependents are skipped.
+    // With a jobserver, every step beyond the first running one also holds one of its tokens,
+    // and the jobserver is cancelled once the graph has finished.
+    result_t run(uint32_t jobs, jobserver_t* jobserver = nullptr);
+};
\ No newline at end of file
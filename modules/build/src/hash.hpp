@@ -0,0 +1,143 @@
+#pragma once
+
+#include <bldr.hpp>
+
+#include <bit>
+#include <cstring>
+#include <format>
+
+// 128-bit content digests for cache keys. Four multiply-rotate lanes in the style of XXH64,
+// folded twice with different rotations for the two halves. Not compatible with nova::hash,
+// which bldr can't depend on as it builds nova.
+struct hash_t
+{
+    uint64_t  low = 0;
+    uint64_t high = 0;
+
+public:
+    bool operator==(const hash_t&) const = default;
+
+    std::string to_string() const
+    {
+        return std::format("{:016x}{:016x}", high, low);
+    }
+};
+
+struct hasher_t
+{
+    static constexpr uint64_t prime1 = 0x9e37'79b1'85eb'ca87;
+    static constexpr uint64_t prime2 = 0xc2b2'ae3d'27d4'eb4f;
+    static constexpr uint64_t prime3 = 0x1656'67b1'9e37'79f9;
+    static constexpr uint64_t prime4 = 0x85eb'ca77'c2b2'ae63;
+
+    uint64_t      lanes[4];
+    unsigned char buffer[32];
+    uint32_t      buffered = 0;
+    uint64_t         total = 0;
+
+public:
+    hasher_t(uint64_t seed = 0)
+        : lanes{ seed + prime1 + prime2, seed + prime2, seed, seed - prime1 }
+    {}
+
+    hasher_t& update(const void* data, size_t size)
+    {
+        auto* bytes = static_cast<const unsigned char*>(data);
+        total += size;
+
+        if (buffered) {
+            size_t count = std::min(size, sizeof(buffer) - buffered);
+            std::memcpy(buffer + buffered, bytes, count);
+            buffered += uint32_t(count);
+            bytes += count;
+            size -= count;
+            if (buffered < sizeof(buffer)) {
+                return *this;
+            }
+            consume(buffer);
+            buffered = 0;
+        }
+
+        for (; size >= sizeof(buffer); bytes += sizeof(buffer), size -= sizeof(buffer)) {
+            consume(bytes);
+        }
+
+        std::memcpy(buffer, bytes, size);
+        buffered = uint32_t(size);
+        return *this;
+    }
+
+    // Length prefixed, so that sequences of strings hash unambiguously
+    hasher_t& update(std::string_view str)
+    {
+        update(uint64_t(str.size()));
+        return update(str.data(), str.size());
+    }
+
+    hasher_t& update(uint64_t value)
+    {
+        return update(&value, sizeof(value));
+    }
+
+    hasher_t& update(const hash_t& hash)
+    {
+        update(hash.low);
+        return update(hash.high);
+    }
+
+    hash_t finish() const
+    {
+        return {
+            .low  = fold(1, 7, 12, 18, 0),
+            .high = fold(3, 11, 23, 41, prime3),
+        };
+    }
+
+private:
+    static uint64_t read64(const unsigned char* p)
+    {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static uint64_t round(uint64_t acc, uint64_t input)
+    {
+        acc += input * prime2;
+        acc = std::rotl(acc, 31);
+        return acc * prime1;
+    }
+
+    void consume(const unsigned char* p)
+    {
+        for (uint32_t i = 0; i < 4; ++i) {
+            lanes[i] = round(lanes[i], read64(p + i * 8));
+        }
+    }
+
+    uint64_t fold(int r0, int r1, int r2, int r3, uint64_t salt) const
+    {
+        uint64_t h = std::rotl(lanes[0], r0) + std::rotl(lanes[1], r1) + std::rotl(lanes[2], r2) + std::rotl(lanes[3], r3);
+        for (uint32_t i = 0; i < 4; ++i) {
+            h = (h ^ round(salt, lanes[i])) * prime1 + prime4;
+        }
+        h += total;
+
+        uint32_t i = 0;
+        for (; i + 8 <= buffered; i += 8) {
+            h ^= round(0, read64(buffer + i));
+            h = std::rotl(h, 27) * prime1 + prime4;
+        }
+        for (; i < buffered; ++i) {
+            h ^= buffer[i] * prime3;
+            h = std::rotl(h, 11) * prime1;
+        }
+
+        h ^= h >> 33;
+        h *= prime2;
+        h ^= h >> 29;
+        h *= prime3;
+        h ^= h >> 32;
+        return h;
+    }
+};
\ No newline at end of file
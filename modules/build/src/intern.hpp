@@ -0,0 +1,63 @@
+#pragma once
+
+#include <bldr.hpp>
+
+#include <memory>
+
+// Deduplicates strings into dense 32-bit ids, assigned in insertion order. Contents are
+// copied into fixed blocks that never move, so views stay valid for the interner's lifetime.
+// Mirrors nova::StringInterner, which bldr can't depend on as it builds nova.
+struct string_interner_t
+{
+    static constexpr size_t block_size = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>>                blocks;
+    char*                                            block = nullptr;
+    size_t                                      block_used = block_size;
+    std::vector<std::string_view>                      strings;
+    std::unordered_map<std::string_view, uint32_t>         ids;
+
+public:
+    uint32_t intern(std::string_view str)
+    {
+        if (auto i = ids.find(str); i != ids.end()) {
+            return i->second;
+        }
+
+        char* data;
+        if (str.size() > block_size / 4) {
+            // Large strings get their own block, leaving the current block open
+            data = blocks.emplace_back(new char[str.size()]).get();
+        } else {
+            if (block_used + str.size() > block_size) {
+                block = blocks.emplace_back(new char[block_size]).get();
+                block_used = 0;
+            }
+            data = block + block_used;
+            block_used += str.size();
+        }
+        std::copy(str.begin(), str.end(), data);
+
+        uint32_t id = uint32_t(strings.size());
+        auto& view = strings.emplace_back(data, str.size());
+        ids.emplace(view, id);
+        return id;
+    }
+
+    // Returns UINT32_MAX if the string has not been interned
+    uint32_t find(std::string_view str) const
+    {
+        auto i = ids.find(str);
+        return i != ids.end() ? i->second : UINT32_MAX;
+    }
+
+    std::string_view get(uint32_t id) const
+    {
+        return strings[id];
+    }
+
+    uint32_t size() const
+    {
+        return uint32_t(strings.size());
+    }
+};
\ No newline at end of file
@@ -0,0 +1,245 @@
+#include "jobserver.hpp"
+#include "log.hpp"
+
+#ifndef _WIN32
+
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+jobserver_t::~jobserver_t()
+{
+    // Return anything still held, a parent make waits for all of its tokens
+    if (write_fd >= 0 && !tokens.empty()) {
+        [[maybe_unused]] auto res = ::write(write_fd, tokens.data(), tokens.size());
+    }
+
+    if (read_fd >= 0) close(read_fd);
+    if (write_fd >= 0 && write_fd != read_fd) close(write_fd);
+    if (child_fd >= 0) close(child_fd);
+    if (wake_read >= 0) close(wake_read);
+    if (wake_write >= 0) close(wake_write);
+
+    if (!fifo.empty()) {
+        std::error_code ec;
+        fs::remove(fifo, ec);
+    }
+}
+
+void jobserver_t::init(uint32_t jobs)
+{
+    join(jobs);
+    if (read_fd < 0) {
+        return;
+    }
+
+    // Tokens are read without blocking once poll reports one, as another process may take it
+    // first. Inherited descriptors are reopened where /proc allows, so the flag does not change
+    // the parent's descriptor. Elsewhere (macOS) a duplicate shares the parent's file status
+    // flags, which GNU make tolerates as it also polls before reading and retries on EAGAIN.
+
+    if (!inherited) {
+        fcntl(read_fd, F_SETFL, fcntl(read_fd, F_GETFL) | O_NONBLOCK);
+    } else if (int fd = open(std::format("/proc/self/fd/{}", read_fd).c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC); fd >= 0) {
+        read_fd = fd;
+    } else if (int fd = fcntl(read_fd, F_DUPFD_CLOEXEC, 0); fd >= 0) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        read_fd = fd;
+    }
+
+    int wake[2];
+    if (pipe(wake) == 0) {
+        wake_read = wake[0];
+        wake_write = wake[1];
+        fcntl(wake_read, F_SETFD, FD_CLOEXEC);
+        fcntl(wake_write, F_SETFD, FD_CLOEXEC);
+    }
+}
+
+// Value of the last --jobserver-auth in MAKEFLAGS, empty if there is none
+static std::string_view get_jobserver_auth()
+{
+    auto makeflags = std::getenv("MAKEFLAGS");
+    if (!makeflags) {
+        return {};
+    }
+
+    std::string_view flags = makeflags;
+    constexpr std::string_view Auth = "--jobserver-auth=";
+    auto start = flags.rfind(Auth);
+    if (start == std::string_view::npos) {
+        return {};
+    }
+
+    auto auth = flags.substr(start + Auth.size());
+    return auth.substr(0, auth.find(' '));
+}
+
+bool get_jobserver_fds(int& read, int& write)
+{
+    auto auth = get_jobserver_auth();
+    auto comma = auth.find(',');
+    if (comma == std::string_view::npos) {
+        return false;
+    }
+
+    read = write = -1;
+    std::from_chars(auth.data(), auth.data() + comma, read);
+    std::from_chars(auth.data() + comma + 1, auth.data() + auth.size(), write);
+    return read >= 0 && write >= 0;
+}
+
+void jobserver_t::join(uint32_t jobs)
+{
+    // Client, join the jobserver of a parent make or bldr
+
+    if (auto auth = get_jobserver_auth(); !auth.empty()) {
+        if (auth.starts_with("fifo:")) {
+            auto path = std::string(auth.substr(5));
+            read_fd = open(path.c_str(), O_RDWR | O_CLOEXEC);
+            if (read_fd < 0) {
+                log_warn("Failed to open jobserver [{}]: {}", path, std::strerror(errno));
+                return;
+            }
+            write_fd = read_fd;
+            log_debug("Joined jobserver [{}]", path);
+            return;
+        }
+
+        if (int r, w; get_jobserver_fds(r, w)) {
+            // Descriptors are only inherited when the parent marked this process as recursive
+            if (fcntl(r, F_GETFD) >= 0 && fcntl(w, F_GETFD) >= 0) {
+                read_fd = r;
+                write_fd = w;
+                inherited = true;
+                log_debug("Joined jobserver [{},{}]", r, w);
+            } else {
+                log_warn("Jobserver descriptors in MAKEFLAGS are not available, ignoring");
+            }
+            return;
+        }
+    }
+
+    // Server, hand out jobs - 1 tokens to this process and its children
+
+    if (jobs <= 1) {
+        return;
+    }
+
+    fifo = s_paths.dir / std::format(".jobserver-{}", getpid());
+    auto path = fifo.string();
+    if (mkfifo(path.c_str(), 0600) != 0) {
+        log_warn("Failed to create jobserver [{}]: {}", path, std::strerror(errno));
+        fifo.clear();
+        return;
+    }
+
+    read_fd = open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (read_fd < 0) {
+        log_warn("Failed to open jobserver [{}]: {}", path, std::strerror(errno));
+        return;
+    }
+    write_fd = read_fd;
+
+    // Children get a blocking descriptor of their own, as R,W rather than fifo:, since make
+    // only understands the latter from 4.4. It is a separate open of the fifo, so making this
+    // process's reads non-blocking leaves it unchanged.
+    child_fd = open(path.c_str(), O_RDWR);
+    if (child_fd < 0) {
+        log_warn("Failed to open jobserver [{}]: {}", path, std::strerror(errno));
+        return;
+    }
+
+    std::string initial(jobs - 1, '+');
+    if (::write(write_fd, initial.data(), initial.size()) != ssize_t(initial.size())) {
+        log_warn("Failed to fill jobserver [{}]: {}", path, std::strerror(errno));
+    }
+
+    setenv("MAKEFLAGS", std::format("-j{} --jobserver-auth={},{}", jobs, child_fd, child_fd).c_str(), 1);
+}
+
+bool jobserver_t::acquire()
+{
+    if (read_fd < 0) {
+        return true;
+    }
+
+    std::array<pollfd, 2> fds {
+        pollfd{ .fd = read_fd,   .events = POLLIN },
+        pollfd{ .fd = wake_read, .events = POLLIN },
+    };
+
+    char token;
+    for (;;) {
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (fds[1].revents) {
+            return false; // Cancelled
+        }
+        auto res = ::read(read_fd, &token, 1);
+        if (res == 1) break;
+        if (res < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) continue;
+        return false;
+    }
+
+    std::scoped_lock lock{ mutex };
+    tokens.push_back(token);
+    return true;
+}
+
+void jobserver_t::release()
+{
+    if (write_fd < 0) {
+        return;
+    }
+
+    char token;
+    {
+        std::scoped_lock lock{ mutex };
+        if (tokens.empty()) return;
+        token = tokens.back();
+        tokens.pop_back();
+    }
+
+    while (::write(write_fd, &token, 1) < 0 && errno == EINTR);
+}
+
+void jobserver_t::cancel()
+{
+    if (wake_write >= 0) {
+        // Never read, so stays readable for every waiting and later acquire
+        while (::write(wake_write, "!", 1) < 0 && errno == EINTR);
+    }
+}
+
+#else
+
+jobserver_t::~jobserver_t() = default;
+
+void jobserver_t::init(uint32_t)
+{
+}
+
+bool jobserver_t::acquire()
+{
+    return true;
+}
+
+void jobserver_t::release()
+{
+}
+
+void jobserver_t::cancel()
+{
+}
+
+#endif
\ No newline at end of file
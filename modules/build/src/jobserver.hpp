@@ -0,0 +1,49 @@
+#pragma once
+
+#include <bldr.hpp>
+
+#include <mutex>
+
+// -----------------------------------------------------------------------------
+//                                 Jobserver
+// -----------------------------------------------------------------------------
+
+// GNU make compatible jobserver, so nested makes share bldr's job slots and bldr shares those
+// of a make it runs under. Every process owns one implicit slot; each further concurrent job
+// holds a token read from the jobserver, written back once the job finishes.
+//
+// Only implemented for POSIX, elsewhere acquire always succeeds without limiting jobs.
+struct jobserver_t
+{
+    int            read_fd = -1;
+    int           write_fd = -1;
+    int          wake_read = -1; // Readable once cancelled, waking blocked acquires
+    int         wake_write = -1;
+    int           child_fd = -1; // Served to children as --jobserver-auth=R,W
+    bool         inherited = false; // read_fd is shared with the parent
+    fs::path          fifo; // Created by this process, removed on destruction
+    std::mutex       mutex;
+    std::string     tokens; // Held tokens, returned as read
+
+public:
+    ~jobserver_t();
+
+    // Joins the jobserver named in MAKEFLAGS if present, otherwise serves jobs slots to child
+    // processes through MAKEFLAGS
+    void init(uint32_t jobs);
+
+    // Blocks until a token is available. Returns false if the jobserver has failed, in which
+    // case the job should run without one, or has been cancelled.
+    bool acquire();
+    void release();
+
+    // Wakes every thread blocked in acquire, and fails any later acquire. For when no more jobs
+    // will be started, so waiting threads can exit.
+    void cancel();
+
+private:
+    void join(uint32_t jobs);
+};
+
+// Descriptors named by --jobserver-auth=R,W in MAKEFLAGS, which child processes must inherit
+bool get_jobserver_fds(int& read, int& write);
\ No newline at end of file
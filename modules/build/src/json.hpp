@@ -1,21 +1,51 @@
 #include <bldr.hpp>
 
+#include <bit>
+#include <charconv>
+#include <cmath>
 #include <ostream>
 #include <string>
 
+#if defined(_M_X64) || defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+
+// Buffers output and flushes to the stream in large chunks. Numbers are formatted with
+// std::to_chars and strings are escaped.
 struct json_writer_t
 {
+    static constexpr size_t flush_threshold = 1024 * 1024;
+
     std::ostream&          out;
+    std::string         buffer;
     std::string  indent_string = "    ";
     uint32_t             depth = 0;
     bool         first_element = true;
     bool               has_key = false;
 
 public:
+    json_writer_t(std::ostream& _out)
+        : out(_out)
+    {}
+
+    ~json_writer_t()
+    {
+        flush();
+    }
+
+    json_writer_t(const json_writer_t&) = delete;
+    json_writer_t& operator=(const json_writer_t&) = delete;
+
+    void flush()
+    {
+        out.write(buffer.data(), std::streamsize(buffer.size()));
+        buffer.clear();
+    }
+
     void indent()
     {
         for (uint32_t i = 0; i < depth; ++i) {
-            out << indent_string;
+            buffer.append(indent_string);
         }
     }
 
@@ -26,22 +56,77 @@ public:
             return;
         }
 
+        if (buffer.size() >= flush_threshold) {
+            flush();
+        }
+
         if (!first_element) {
-            out << ',';
+            buffer.push_back(',');
         }
 
         if (depth > 0) {
-            out << '\n';
+            buffer.push_back('\n');
             indent();
         }
 
         first_element = false;
     }
 
+    static size_t find_escape(const char* str, size_t size)
+    {
+        size_t i = 0;
+#if defined(_M_X64) || defined(__x86_64__)
+        for (; i + 16 <= size; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+            __m128i special = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))),
+                _mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8(0x1f)), _mm_set1_epi8(0x1f)));
+            if (uint32_t mask = uint32_t(_mm_movemask_epi8(special))) {
+                return i + std::countr_zero(mask);
+            }
+        }
+#endif
+        for (; i < size; ++i) {
+            uint8_t c = uint8_t(str[i]);
+            if (c < 0x20 || c == '"' || c == '\\') {
+                break;
+            }
+        }
+        return i;
+    }
+
+    void append_string(std::string_view str)
+    {
+        buffer.push_back('"');
+        for (;;) {
+            size_t clean = find_escape(str.data(), str.size());
+            buffer.append(str.data(), clean);
+            if (clean == str.size()) {
+                break;
+            }
+
+            char c = str[clean];
+            switch (c) {
+                break;case '"':  buffer.append("\\\"");
+                break;case '\\': buffer.append("\\\\");
+                break;case '\n': buffer.append("\\n");
+                break;case '\r': buffer.append("\\r");
+                break;case '\t': buffer.append("\\t");
+                break;default: {
+                    char escaped[] = { '\\', 'u', '0', '0', "0123456789abcdef"[c >> 4], "0123456789abcdef"[c & 15] };
+                    buffer.append(escaped, sizeof(escaped));
+                }
+            }
+            str.remove_prefix(clean + 1);
+        }
+        buffer.push_back('"');
+    }
+
     json_writer_t& key(std::string_view key)
     {
         new_element();
-        out << '"' << key << "\": ";
+        append_string(key);
+        buffer.append(": ");
         has_key = true;
         return *this;
     }
@@ -54,7 +139,7 @@ public:
     void object()
     {
         new_element();
-        out << '{';
+        buffer.push_back('{');
         ++depth;
         first_element = true;
     }
@@ -63,17 +148,17 @@ public:
     {
         --depth;
         if (!first_element) {
-            out << '\n';
+            buffer.push_back('\n');
             indent();
         }
-        out << '}';
+        buffer.push_back('}');
         first_element = false;
     }
 
     void array()
     {
         new_element();
-        out << '[';
+        buffer.push_back('[');
         ++depth;
         first_element = true;
     }
@@ -82,43 +167,57 @@ public:
     {
         --depth;
         if (!first_element) {
-            out << '\n';
+            buffer.push_back('\n');
             indent();
         }
 
-        out << ']';
+        buffer.push_back(']');
         first_element = false;
     }
 
     void string(std::string_view str)
     {
         new_element();
-        out << '"' << str << '"';
+        append_string(str);
     }
 
     void operator=(std::string_view str) { string(str); }
     void operator=(char str)             { string({ &str, 1ull }); }
     void operator=(const char* str)      { string(str); }
 
-    template<typename T>
-    void value(T&& value)
+    void raw(std::string_view json)
     {
         new_element();
-        out << std::forward<T>(value);
-    }
-
-    void operator=(double       v) { value(v);                    }
-    void operator=(float        v) { value(v);                    }
-    void operator=(int64_t      v) { value(v);                    }
-    void operator=(int32_t      v) { value(v);                    }
-    void operator=(int16_t      v) { value(v);                    }
-    void operator=(int8_t       v) { value(v);                    }
-    void operator=(uint64_t     v) { value(v);                    }
-    void operator=(uint32_t     v) { value(v);                    }
-    void operator=(uint16_t     v) { value(v);                    }
-    void operator=(uint8_t      v) { value(v);                    }
-    void operator=(bool         v) { value(v ? "true" : "false"); }
-    void operator=(std::nullptr_t) { value("null");               }
+        buffer.append(json);
+    }
+
+    template<typename T>
+    void value(T v)
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (!std::isfinite(v)) {
+                raw("null");
+                return;
+            }
+        }
+
+        char chars[64];
+        auto result = std::to_chars(chars, chars + sizeof(chars), v);
+        raw({ chars, result.ptr });
+    }
+
+    void operator=(double       v) { value(v);                  }
+    void operator=(float        v) { value(v);                  }
+    void operator=(int64_t      v) { value(v);                  }
+    void operator=(int32_t      v) { value(v);                  }
+    void operator=(int16_t      v) { value(v);                  }
+    void operator=(int8_t       v) { value(v);                  }
+    void operator=(uint64_t     v) { value(v);                  }
+    void operator=(uint32_t     v) { value(v);                  }
+    void operator=(uint16_t     v) { value(v);                  }
+    void operator=(uint8_t      v) { value(v);                  }
+    void operator=(bool         v) { raw(v ? "true" : "false"); }
+    void operator=(std::nullptr_t) { raw("null");               }
 
     template<typename T>
     void operator<<(T&& t)
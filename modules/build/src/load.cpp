@@ -1,16 +1,25 @@
-#include <excpt.h>
+#ifdef _WIN32
+#  include <excpt.h>
+#endif
 
 #include "bldr.hpp"
+#include "state.hpp"
 #include <log.hpp>
 
 #include <sol/sol.hpp>
 
+#include <atomic>
 #include <unordered_set>
 #include <fstream>
+#include <memory>
+#include <random>
+#include <spanstream>
 
-#define NOMINMAX
-#define WIN32_LEAN_AND_MEAN
-#include <Windows.h>
+#ifdef _WIN32
+#  define NOMINMAX
+#  define WIN32_LEAN_AND_MEAN
+#  include <Windows.h>
+#endif
 
 struct values_t
 {
@@ -18,6 +27,36 @@ struct values_t
     std::unordered_map<std::string, std::string> options;
 };
 
+// What a filesystem query made while evaluating a bldr file saw. Cached evaluations are only
+// reused if every query still gives the same answer.
+enum class path_kind_t : uint32_t
+{
+    missing,
+    file,
+    directory,
+};
+
+struct path_probe_t
+{
+    fs::path        path;
+    path_kind_t     kind;
+};
+
+path_kind_t probe_path(const fs::path& path)
+{
+    std::error_code ec;
+    auto status = fs::status(path, ec);
+    if (ec || !fs::exists(status)) return path_kind_t::missing;
+    return fs::is_directory(status) ? path_kind_t::directory : path_kind_t::file;
+}
+
+// Projects declared by a single bldr file
+struct evaluated_file_t
+{
+    std::vector<project_t*>      projects;
+    std::vector<path_probe_t>      probes;
+};
+
 values_t get_values(const sol::object& obj)
 {
     values_t values;
@@ -45,7 +84,8 @@ values_t get_values(const sol::object& obj)
     return values;
 }
 
-void populate_artifactory_from_file(project_artifactory_t& artifactory, const fs::path& file, flags_t flags)
+// Returns false if the script threw, leaving only the projects declared before the error
+bool evaluate_file(evaluated_file_t& evaluated, const fs::path& file, flags_t flags)
 {
     (void)flags;
 
@@ -74,7 +114,7 @@ void populate_artifactory_from_file(project_artifactory_t& artifactory, const fs
         project->name = std::string(name);
         project->dir = default_dir;
 
-        artifactory.projects.insert({ project->name, project });
+        evaluated.projects.push_back(project);
 
         return true;
     });
@@ -111,9 +151,11 @@ void populate_artifactory_from_file(project_artifactory_t& artifactory, const fs
         auto values = get_values(obj);
         for (auto& value : values.values) {
             auto path = project->dir / value;
-            if (!fs::exists(path)) {
+            auto kind = probe_path(path);
+            evaluated.probes.push_back({ path, kind });
+            if (kind == path_kind_t::missing) {
                 // log_warn("Include path not found: {}", path.string());
-            } else if (fs::is_directory(path)) {
+            } else if (kind == path_kind_t::directory) {
                 project->includes.push_back(project->dir / value);
             } else {
                 project->force_includes.push_back(value);
@@ -121,6 +163,10 @@ void populate_artifactory_from_file(project_artifactory_t& artifactory, const fs
         }
     });
 
+    lua.set_function("Pch", [&](std::string_view header) {
+        project->pch = fs::absolute(project->dir / header);
+    });
+
     lua.set_function("LibPath", [&](const sol::object& obj) {
         auto values = get_values(obj);
         for (auto& value : values.values) {
@@ -182,10 +228,16 @@ void populate_artifactory_from_file(project_artifactory_t& artifactory, const fs
     });
 
     lua.set_function("Platform", [&](std::string_view str) {
+#ifdef _WIN32
         if (str == "Win32") return true;
+#else
+        if (str == "Linux") return true;
+#endif
+        if (str == "Win32" || str == "Linux") return false;
 
         log_error("Unrecognized platform: [{}]. Must be one of:", str);
         log_error(" - Win32");
+        log_error(" - Linux");
         std::exit(1);
     });
 
@@ -213,42 +265,310 @@ void populate_artifactory_from_file(project_artifactory_t& artifactory, const fs
         }
     } catch (const std::exception& e) {
         log_error("Exception thrown running bldr file: {}", e.what());
+        return false;
     } catch (...) {
         log_error("Unknown error thrown running bldr file");
+        return false;
     }
 
     // if (project && is_set(flags, flags_t::trace)) {
     //     debug_project(*project);
     // }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+//                          Project evaluation cache
+// -----------------------------------------------------------------------------
+
+// Evaluated projects are cached per working directory, keyed on the paths and contents of
+// every bldr file evaluated. File hashes come from the build state, so unchanged files are
+// only statted.
+//
+// Scripts reading other files through the io library are not tracked, -clean re-evaluates.
+
+static constexpr uint32_t s_project_cache_version = 3;
+
+fs::path get_project_cache_path()
+{
+    return s_paths.dir / "projects" / hasher_t().update(fs::current_path().string()).finish().to_string();
+}
+
+hash_t get_project_cache_key(std::span<const std::string> files)
+{
+    hasher_t hasher;
+    hasher.update(uint64_t(s_project_cache_version));
+    hasher.update(fs::current_path().string());
+#ifdef _WIN32
+    hasher.update("Win32");
+#else
+    hasher.update("Linux");
+#endif
+    auto content = s_build_state.hash_files(files);
+    hasher.update(content.low);
+    hasher.update(content.high);
+    return hasher.finish();
+}
+
+bool load_project_cache(const fs::path& path, hash_t key, std::vector<project_t*>& projects)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    std::vector<char> data;
+    data.resize(fs::file_size(path));
+    in.read(data.data(), data.size());
+
+    std::spanstream din{data};
+
+    auto ReadUInt32 = [&] {
+        uint32_t v = 0;
+        din.read((char*)&v, 4);
+        return v;
+    };
+
+    auto ReadUInt64 = [&] {
+        uint64_t v = 0;
+        din.read((char*)&v, 8);
+        return v;
+    };
+
+    auto ReadString = [&] {
+        auto size = ReadUInt32();
+        std::string str(std::min<size_t>(size, data.size()), '\0');
+        din.read(str.data(), str.size());
+        return str;
+    };
+
+    // Counts are bounded by the data left, so a corrupt cache can't allocate unbounded memory
+    auto ReadCount = [&] {
+        return std::min<size_t>(ReadUInt32(), data.size());
+    };
+
+    auto ReadPaths = [&](std::vector<fs::path>& paths) {
+        paths.resize(ReadCount());
+        for (auto& path : paths) path = ReadString();
+    };
+
+    auto ReadStrings = [&](std::vector<std::string>& strings) {
+        strings.resize(ReadCount());
+        for (auto& str : strings) str = ReadString();
+    };
+
+    auto ReadDefines = [&](std::vector<define_t>& defines) {
+        defines.resize(ReadCount());
+        for (auto& define : defines) {
+            define.key = ReadString();
+            define.value = ReadString();
+        }
+    };
+
+    if (ReadUInt32() != s_project_cache_version) return false;
+    hash_t cached_key;
+    cached_key.low = ReadUInt64();
+    cached_key.high = ReadUInt64();
+    if (!din || cached_key != key) return false;
+
+    for (size_t i = 0, count = ReadCount(); i < count && din; ++i) {
+        auto probe = ReadString();
+        auto kind = path_kind_t(ReadUInt32());
+        if (!din || probe_path(probe) != kind) return false;
+    }
+
+    std::vector<std::unique_ptr<project_t>> loaded(ReadCount());
+    for (auto& project : loaded) {
+        if (!din) break;
+        project = std::make_unique<project_t>();
+        project->name = ReadString();
+        project->dir = ReadString();
+        project->sources.resize(ReadCount());
+        for (auto& source : project->sources) {
+            source.file = ReadString();
+            source.type = source_type_t(std::min(ReadUInt32(), uint32_t(source_type_t::_max_enum)));
+        }
+        ReadPaths(project->includes);
+        ReadPaths(project->force_includes);
+        ReadPaths(project->lib_paths);
+        ReadStrings(project->imports);
+        ReadPaths(project->links);
+        ReadDefines(project->build_defines);
+        ReadDefines(project->defines);
+        ReadPaths(project->shared_libs);
+        project->pch = ReadString();
+        if (ReadUInt32()) {
+            artifact_t artifact;
+            artifact.path = ReadString();
+            artifact.type = artifact_type_t(std::min(ReadUInt32(), uint32_t(artifact_type_t::_max_enum)));
+            project->artifact = std::move(artifact);
+        }
+    }
+    if (!din) {
+        return false;
+    }
+
+    for (auto& project : loaded) {
+        projects.push_back(project.release());
+    }
+    return true;
+}
+
+void save_project_cache(const fs::path& path, hash_t key, std::span<const path_probe_t> probes, std::span<project_t* const> projects)
+{
+    fs::create_directories(path.parent_path());
+
+    auto target = fs::path(std::format("{}.{:08x}.tmp", path.string(), std::random_device{}()));
+    std::ofstream out(target, std::ios::binary | std::ios::trunc);
+
+    auto WriteUInt32 = [&](uint32_t v) {
+        out.write((const char*)&v, 4);
+    };
+
+    auto WriteUInt64 = [&](uint64_t v) {
+        out.write((const char*)&v, 8);
+    };
+
+    auto WriteString = [&](std::string_view s) {
+        WriteUInt32(uint32_t(s.size()));
+        out.write(s.data(), s.size());
+    };
+
+    auto WritePaths = [&](std::span<const fs::path> paths) {
+        WriteUInt32(uint32_t(paths.size()));
+        for (auto& p : paths) WriteString(p.string());
+    };
+
+    auto WriteStrings = [&](std::span<const std::string> strings) {
+        WriteUInt32(uint32_t(strings.size()));
+        for (auto& str : strings) WriteString(str);
+    };
+
+    auto WriteDefines = [&](std::span<const define_t> defines) {
+        WriteUInt32(uint32_t(defines.size()));
+        for (auto& define : defines) {
+            WriteString(define.key);
+            WriteString(define.value);
+        }
+    };
+
+    WriteUInt32(s_project_cache_version);
+    WriteUInt64(key.low);
+    WriteUInt64(key.high);
+
+    WriteUInt32(uint32_t(probes.size()));
+    for (auto& probe : probes) {
+        WriteString(probe.path.string());
+        WriteUInt32(uint32_t(probe.kind));
+    }
+
+    WriteUInt32(uint32_t(projects.size()));
+    for (auto* project : projects) {
+        WriteString(project->name);
+        WriteString(project->dir.string());
+        WriteUInt32(uint32_t(project->sources.size()));
+        for (auto& source : project->sources) {
+            WriteString(source.file.string());
+            WriteUInt32(uint32_t(source.type));
+        }
+        WritePaths(project->includes);
+        WritePaths(project->force_includes);
+        WritePaths(project->lib_paths);
+        WriteStrings(project->imports);
+        WritePaths(project->links);
+        WriteDefines(project->build_defines);
+        WriteDefines(project->defines);
+        WritePaths(project->shared_libs);
+        WriteString(project->pch.string());
+        WriteUInt32(project->artifact.has_value());
+        if (project->artifact) {
+            WriteString(project->artifact->path.string());
+            WriteUInt32(uint32_t(project->artifact->type));
+        }
+    }
+
+    out.close();
+
+    std::error_code ec;
+    if (out) {
+        fs::rename(target, path, ec);
+    }
+    if (!out || ec) {
+        fs::remove(target, ec);
+    }
 }
 
 void populate_artifactory(project_artifactory_t& artifactory, flags_t flags)
 {
+    std::vector<std::string> files;
+
     for (auto& file : fs::directory_iterator(fs::current_path())) {
         if (file.path().string().ends_with("bldr.lua")) {
-            if (is_set(flags, flags_t::trace)) {
-                log_debug("Loading bldr file: {}", file.path().string());
-            }
-            populate_artifactory_from_file(artifactory, file.path(), flags);
+            files.push_back(file.path().string());
         }
     }
 
-    std::unordered_set<fs::path> installed;
     {
         std::ifstream fs(s_paths.installed, std::ios::binary);
         if (fs.is_open()) {
+            std::unordered_set<std::string> installed;
             std::string line;
             while (std::getline(fs, line)) {
-                installed.insert(line);
+                if (installed.insert(line).second && s_build_state.stat(line).exists) {
+                    files.push_back(line);
+                }
             }
         }
     }
-    for (auto& file : installed) {
-        if (fs::exists(file)) {
+
+    // Projects are registered in file order, the first declaration of a name wins
+    auto add_projects = [&](std::span<project_t* const> projects) {
+        for (auto* project : projects) {
+            artifactory.projects.insert({ project->name, project });
+        }
+    };
+
+    auto cache_path = get_project_cache_path();
+    auto key = get_project_cache_key(files);
+
+    if (!is_set(flags, flags_t::clean)) {
+        std::vector<project_t*> projects;
+        if (load_project_cache(cache_path, key, projects)) {
             if (is_set(flags, flags_t::trace)) {
-                log_info("Loading installed bldr file: {}", file.string());
+                log_debug("Loaded {} projects from {} cached bldr files", projects.size(), files.size());
             }
-            populate_artifactory_from_file(artifactory, file, flags);
+            add_projects(projects);
+            return;
         }
     }
+
+    // Each file is evaluated in its own Lua state, so independent files run in parallel
+
+    std::vector<evaluated_file_t> evaluated(files.size());
+    std::atomic_bool any_failed = false;
+
+#pragma omp parallel for
+    for (int32_t i = 0; i < int32_t(files.size()); ++i) {
+        if (is_set(flags, flags_t::trace)) {
+            log_debug("Loading bldr file: {}", files[i]);
+        }
+        if (!evaluate_file(evaluated[i], files[i], flags)) {
+            any_failed = true;
+        }
+    }
+
+    std::vector<project_t*> projects;
+    std::vector<path_probe_t> probes;
+    for (auto& file : evaluated) {
+        add_projects(file.projects);
+        probes.insert(probes.end(), file.probes.begin(), file.probes.end());
+    }
+    for (auto&[name, project] : artifactory.projects) {
+        projects.push_back(project);
+    }
+
+    // Partially evaluated files are not cached, so their errors are reported again next run
+    if (!any_failed) {
+        save_project_cache(cache_path, key, probes, projects);
+    }
 }
\ No newline at end of file
@@ -1,42 +1,84 @@
 #pragma once
 
 #include <format>
-#include <syncstream>
 #include <iostream>
+#include <atomic>
+#include <mutex>
+#include <cstdio>
+
+enum class log_level_t
+{
+    trace,
+    debug,
+    info,
+    warn,
+    error,
+    off,
+};
+
+inline std::atomic<log_level_t> s_log_level = log_level_t::trace;
+
+namespace detail
+{
+    inline std::mutex log_mutex;
+
+    // Formats on the calling thread and emits each line with a single write, so parallel
+    // compile tasks only contend for the duration of the fwrite
+    template<class... Args>
+    void log_line(log_level_t level, std::string_view tag, const std::format_string<Args...> fmt, Args&&... args)
+    {
+        if (level < s_log_level.load(std::memory_order_relaxed)) return;
+
+        thread_local std::string line;
+        line.clear();
+        line.append(tag);
+        std::vformat_to(std::back_inserter(line), fmt.get(), std::make_format_args(args...));
+        line.push_back('\n');
+
+        std::scoped_lock lock{ log_mutex };
+        std::fwrite(line.data(), 1, line.size(), stdout);
+    }
+}
 
 template<class... Args>
 void log(const std::format_string<Args...> fmt, Args&&... args)
 {
-    std::osyncstream os(std::cout);
-    os << std::vformat(fmt.get(), std::make_format_args(args...)) << '\n';
+    detail::log_line(log_level_t::info, "", fmt, std::forward<Args>(args)...);
 }
 
 template<class... Args>
 void log_info(const std::format_string<Args...> fmt, Args&&... args)
 {
-    std::osyncstream os(std::cout);
-    os << "[\u001B[94mINFO\u001B[0m] " << std::vformat(fmt.get(), std::make_format_args(args...)) << '\n';
+    detail::log_line(log_level_t::info, "[\u001B[94mINFO\u001B[0m] ", fmt, std::forward<Args>(args)...);
 }
 
 template<class... Args>
 void log_debug(const std::format_string<Args...> fmt, Args&&... args)
 {
-    std::osyncstream os(std::cout);
-    os << "[\u001B[96mDEBUG\u001B[0m] " << std::vformat(fmt.get(), std::make_format_args(args...)) << '\n';
+    detail::log_line(log_level_t::debug, "[\u001B[96mDEBUG\u001B[0m] ", fmt, std::forward<Args>(args)...);
 }
 
 template<class... Args>
 void log_error(const std::format_string<Args...> fmt, Args&&... args)
 {
-    std::osyncstream os(std::cout);
-    os << "[\u001B[91mERROR\u001B[0m] " << std::vformat(fmt.get(), std::make_format_args(args...)) << '\n';
+    detail::log_line(log_level_t::error, "[\u001B[91mERROR\u001B[0m] ", fmt, std::forward<Args>(args)...);
 }
 
 template<class... Args>
 void log_warn(const std::format_string<Args...> fmt, Args&&... args)
 {
-    std::osyncstream os(std::cout);
-    os << "[\u001B[93mWARN\u001B[0m] " << std::vformat(fmt.get(), std::make_format_args(args...)) << '\n';
+    detail::log_line(log_level_t::warn, "[\u001B[93mWARN\u001B[0m] ", fmt, std::forward<Args>(args)...);
+}
+
+// Writes output captured from a build step in one go, so steps finishing together do not
+// interleave their lines
+inline
+void log_output(std::string_view output)
+{
+    if (output.empty() || s_log_level.load(std::memory_order_relaxed) == log_level_t::off) return;
+
+    std::scoped_lock lock{ detail::log_mutex };
+    std::fwrite(output.data(), 1, output.size(), stdout);
 }
 
 inline
@@ -0,0 +1,185 @@
+#ifndef _WIN32
+
+#include "bldr.hpp"
+#include "log.hpp"
+#include "diagnostics.hpp"
+#include "jobserver.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace
+{
+    // Both ends are close-on-exec. macOS has no pipe2, so a spawn on another thread may inherit
+    // the descriptors before the flag is set. Spawns there use POSIX_SPAWN_CLOEXEC_DEFAULT, so
+    // children only inherit what their file actions name.
+    bool create_pipe(int fds[2])
+    {
+#ifdef __APPLE__
+        if (pipe(fds) != 0) return false;
+        fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+        return true;
+#else
+        return pipe2(fds, O_CLOEXEC) == 0;
+#endif
+    }
+}
+
+void add_program(program_exec_t& info, std::string_view program)
+{
+    info.arguments.emplace_back(program);
+}
+
+uint32_t execute_program(const program_exec_t& info, [[maybe_unused]] flags_t flags, std::string_view name)
+{
+    if (is_set(flags, flags_t::trace)) {
+        std::stringstream ss;
+        for (auto& arg : info.arguments) {
+            if (arg.contains(' ')) {
+                ss << '"' << arg << "\" ";
+            } else {
+                ss << arg << ' ';
+            }
+        }
+        log_debug("{}", ss.str());
+    }
+
+    // Separate pipes for stdout and stderr, multiplexed with poll. Both ends are close-on-exec,
+    // the child only inherits the copies dup'ed onto its standard handles.
+
+    int stdout_pipe[2];
+    int stderr_pipe[2];
+    if (!create_pipe(stdout_pipe)) {
+        log_error("Failed to create pipe for executing process: {}", std::strerror(errno));
+        return 1;
+    }
+    if (!create_pipe(stderr_pipe)) {
+        log_error("Failed to create pipe for executing process: {}", std::strerror(errno));
+        close(stdout_pipe[0]);
+        close(stdout_pipe[1]);
+        return 1;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, stdout_pipe[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, stderr_pipe[1], STDERR_FILENO);
+    if (!info.working_directory.empty()) {
+        posix_spawn_file_actions_addchdir_np(&actions, info.working_directory.c_str());
+    }
+
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+#ifdef __APPLE__
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_CLOEXEC_DEFAULT);
+    posix_spawn_file_actions_addinherit_np(&actions, STDIN_FILENO);
+    if (int jobserver_read, jobserver_write; get_jobserver_fds(jobserver_read, jobserver_write)) {
+        // Nested makes find the jobserver through MAKEFLAGS, keep the descriptors it names open
+        posix_spawn_file_actions_addinherit_np(&actions, jobserver_read);
+        posix_spawn_file_actions_addinherit_np(&actions, jobserver_write);
+    }
+#endif
+
+    std::vector<char*> argv;
+    for (auto& arg : info.arguments) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    auto spawn_start = std::chrono::steady_clock::now();
+
+    pid_t pid;
+    int res = posix_spawnp(&pid, argv[0], &actions, &attributes, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attributes);
+    close(stdout_pipe[1]);
+    close(stderr_pipe[1]);
+
+    if (res != 0) {
+        log_error("Failed to launch process [{}]: {}", info.arguments[0], std::strerror(res));
+        close(stdout_pipe[0]);
+        close(stderr_pipe[0]);
+        return 1;
+    }
+
+    if (is_set(flags, flags_t::trace)) {
+        log_debug("Spawned [{}] in {}", name, duration_to_string(std::chrono::steady_clock::now() - spawn_start));
+    }
+
+    std::array<pollfd, 2> fds {
+        pollfd{ .fd = stdout_pipe[0], .events = POLLIN },
+        pollfd{ .fd = stderr_pipe[0], .events = POLLIN },
+    };
+    std::array<std::string, 2> lines;
+    std::array<char, UINT16_MAX> buffer;
+
+    // Output is collected whole lines at a time, keeping stdout and stderr lines in the order they
+    // arrived, and emitted once the process has finished
+    std::string output;
+    for (uint32_t open = 2; open > 0;) {
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            log_error("Failed to poll process output: {}", std::strerror(errno));
+            break;
+        }
+
+        for (uint32_t i = 0; i < fds.size(); ++i) {
+            if (fds[i].fd < 0 || !(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+
+            auto bytes_read = read(fds[i].fd, buffer.data(), buffer.size());
+            if (bytes_read < 0 && errno == EINTR) continue;
+            if (bytes_read <= 0) {
+                close(fds[i].fd);
+                fds[i].fd = -1;
+                open--;
+                continue;
+            }
+
+            for (char c : std::string_view(buffer.data(), size_t(bytes_read))) {
+                lines[i].push_back(c);
+                if (c == '\n') {
+                    output.append(lines[i]);
+                    lines[i].clear();
+                }
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < fds.size(); ++i) {
+        if (fds[i].fd >= 0) close(fds[i].fd);
+
+        // Flush remainder of output buffer
+        if (!lines[i].empty()) {
+            output.append(lines[i]);
+            output.push_back('\n');
+        }
+    }
+
+    log_output(output);
+    s_diagnostics.add(name, output);
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR);
+
+    if (WIFEXITED(status)) {
+        return uint32_t(WEXITSTATUS(status));
+    }
+    if (WIFSIGNALED(status)) {
+        log_error("Process [{}] terminated by signal {}", name, WTERMSIG(status));
+        return 128 + uint32_t(WTERMSIG(status));
+    }
+    return 1;
+}
+
+#endif
\ No newline at end of file
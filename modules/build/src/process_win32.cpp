@@ -0,0 +1,244 @@
+#ifdef _WIN32
+
+#include "bldr.hpp"
+#include "log.hpp"
+#include "diagnostics.hpp"
+
+#include <array>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include "Windows.h"
+
+std::string generate_env()
+{
+    auto env_file = s_paths.environments / "msvc";
+    fs::create_directories(s_paths.environments);
+
+    {
+        std::ifstream in(env_file, std::ios::binary | std::ios::ate);
+        if (in.is_open()) {
+            std::string str;
+            str.resize(in.tellg());
+            in.seekg(0);
+            in.read(str.data(), str.size());
+            return str;
+        }
+    }
+
+    // TODO: Move all of this process execution + input + output into unified helper
+    STARTUPINFOA startup{};
+    PROCESS_INFORMATION process{};
+
+    std::string cmd = "cmd /c call \"C:/Program Files/Microsoft Visual Studio/2022/Community/VC/Auxiliary/Build/vcvarsx86_amd64.bat\" && set";
+
+    SECURITY_ATTRIBUTES sec_attribs;
+    SecureZeroMemory(&sec_attribs, sizeof(sec_attribs));
+    sec_attribs.nLength = sizeof(sec_attribs);
+    sec_attribs.bInheritHandle = true;
+    sec_attribs.lpSecurityDescriptor = nullptr;
+
+    HANDLE stdout_read_handle;
+    HANDLE stdout_write_handle;
+
+    CreatePipe(&stdout_read_handle, &stdout_write_handle, &sec_attribs, 0);
+
+    startup.cb = sizeof(startup);
+    startup.hStdError = stdout_write_handle;
+    startup.hStdOutput = stdout_write_handle;
+    startup.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+    startup.dwFlags = STARTF_USESTDHANDLES;
+
+    auto res = CreateProcessA(
+        nullptr,
+        cmd.data(),
+        nullptr,
+        nullptr,
+        true,
+        0,
+        nullptr,
+        nullptr,
+        &startup,
+        &process);
+
+    if (!res) {
+        log_error("Error creating environment: {}", GetLastError());
+    } else {
+        CloseHandle(stdout_write_handle);
+
+        log_info("Generating MSVC environment...");
+
+        std::string output;
+        std::array<char, 4096> buffer{};
+        DWORD bytes_read;
+        BOOL success;
+        for (;;) {
+            success = ReadFile(stdout_read_handle, buffer.data(), DWORD(buffer.size()) - 1, &bytes_read, 0);
+            if (!success || bytes_read == 0) break;
+            output.append(buffer.data(), bytes_read);
+        }
+
+        WaitForSingleObject(process.hProcess, INFINITE);
+        CloseHandle(stdout_read_handle);
+
+        std::string env;
+        std::string line;
+        std::stringstream ss(output);
+        while (std::getline(ss, line)) {
+            if (line.ends_with('\r')) {
+                line = line.substr(0, line.size() - 1);
+            }
+            if (line.find_first_of('=') != std::string::npos) {
+                env.append(line);
+                env.push_back('\0');
+            }
+        }
+        env.push_back('\0');
+
+        {
+            std::ofstream out(env_file, std::ios::binary);
+            out.write(env.data(), env.size());
+        }
+
+        log_info("MSVC environment generated");
+
+        return env;
+    }
+
+    std::exit(1);
+}
+
+const std::string& get_build_environment()
+{
+    static std::string env = generate_env();
+    return env;
+}
+
+void add_program(program_exec_t& info, std::string_view program)
+{
+    info.arguments.emplace_back("cmd");
+    info.arguments.emplace_back("/c");
+    info.arguments.emplace_back(program);
+}
+
+uint32_t execute_program(const program_exec_t& info, [[maybe_unused]] flags_t flags, std::string_view name)
+{
+    // auto start = std::chrono::steady_clock::now();
+
+    std::stringstream ss;
+    auto cmd = [&](std::string_view value)
+    {
+        if (value.contains(' ')) {
+            ss << '"' << value << "\" ";
+        } else {
+            ss << value << ' ';
+        }
+    };
+
+    for (auto& arg : info.arguments) cmd(arg);
+
+    std::string cmd_line = ss.str();
+    if (is_set(flags, flags_t::trace)) {
+        log_debug("{}", cmd_line);
+    }
+
+    SECURITY_ATTRIBUTES sa = {};
+    sa.nLength = sizeof(sa);
+    sa.bInheritHandle = true;
+    sa.lpSecurityDescriptor = nullptr;
+
+    HANDLE stdout_read = {};
+    HANDLE stdout_write = {};
+
+    // Create a pipe for the child process' STDOUT.
+    if (!CreatePipe(&stdout_read, &stdout_write, &sa, 0)) {
+        log_error("Failed to create pipe for executing process");
+        return 1;
+    }
+
+    // Ensure the read handle to the pipe for STDOUT is not inherit
+    if (!SetHandleInformation(stdout_read, HANDLE_FLAG_INHERIT, 0)) {
+        log_error("Failed to disable inheritance for stdout read handle");
+        CloseHandle(stdout_write);
+        CloseHandle(stdout_read);
+        return 1;
+    }
+
+    STARTUPINFOA si = {};
+    si.cb = sizeof(si);
+    si.hStdError = stdout_write;
+    si.hStdOutput = stdout_write;
+    si.dwFlags |= STARTF_USESTDHANDLES;
+
+    PROCESS_INFORMATION pi = {};
+
+    if (!CreateProcessA(
+            nullptr,
+            cmd_line.data(),
+            nullptr,
+            nullptr,
+            true, // Inherit Handles
+            0,    // Creation flags
+            (void*)get_build_environment().c_str(),
+            info.working_directory.string().c_str(),
+            &si,
+            &pi)) {
+        log_error("Failed to launch process");
+        CloseHandle(stdout_write);
+        CloseHandle(stdout_read);
+        return 1;
+    }
+
+    // Output is collected whole lines at a time and emitted once the process has finished
+    std::string output;
+
+    std::jthread reader_thread {
+        [&] {
+            std::string line;
+            for (;;) {
+                std::array<char, UINT16_MAX> buffer = {};
+                DWORD bytes_read;
+                if (!ReadFile(stdout_read, buffer.data(), DWORD(buffer.size()), &bytes_read, 0)) {
+                    break;
+                }
+
+                for (char c : std::string_view(buffer.data(), bytes_read)) {
+                    line.push_back(c);
+                    if (c == '\n') {
+                        output.append(line);
+                        line.clear();
+                    }
+                }
+            }
+
+            // Flush remainder of output buffer
+            if (!line.empty()) {
+                output.append(line);
+                output.push_back('\n');
+            }
+        }
+    };
+
+    WaitForSingleObject(pi.hProcess, INFINITE);
+
+    DWORD ec;
+    GetExitCodeProcess(pi.hProcess, &ec);
+
+    CloseHandle(stdout_write);
+    reader_thread.join();
+    CloseHandle(stdout_read);
+    CloseHandle(pi.hProcess);
+
+    log_output(output);
+    s_diagnostics.add(name, output);
+
+    // auto end = std::chrono::steady_clock::now();
+    // log_debug("{} - {}", name, duration_to_string(end - start));
+
+    return ec;
+}
+
+#endif
\ No newline at end of file
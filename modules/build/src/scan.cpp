@@ -0,0 +1,250 @@
+#include "scan.hpp"
+
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <unordered_set>
+
+void find_includes(std::string_view text, std::vector<include_t>& out)
+{
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    const char* p = begin;
+
+    auto skip_blanks = [&] {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+    };
+
+    while ((p = static_cast<const char*>(std::memchr(p, '#', size_t(end - p))))) {
+        const char* line = p;
+        while (line > begin && (line[-1] == ' ' || line[-1] == '\t')) line--;
+        p++;
+        if (line > begin && line[-1] != '\n') {
+            continue;
+        }
+
+        skip_blanks();
+        if (end - p < 7 || std::memcmp(p, "include", 7) != 0) {
+            continue;
+        }
+        p += 7;
+        skip_blanks();
+        if (p == end) {
+            break;
+        }
+
+        char close;
+        if      (*p == '"') close = '"';
+        else if (*p == '<') close = '>';
+        else continue;
+
+        const char* name = ++p;
+        while (p < end && *p != close && *p != '\n') p++;
+        if (p == end) {
+            break;
+        }
+        if (*p == close) {
+            out.push_back({ std::string_view(name, p), close == '"' });
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+include_scanner_t::file_t& include_scanner_t::get(uint32_t id)
+{
+    if (id >= files.size()) {
+        files.resize(id + 1);
+    }
+    return files[id];
+}
+
+uint32_t include_scanner_t::lookup(const fs::path& dir, std::string_view name)
+{
+    uint64_t key = (uint64_t(paths.intern(dir.string())) << 32) | paths.intern(name);
+    if (auto i = resolved.find(key); i != resolved.end()) {
+        return i->second;
+    }
+
+    auto candidate = (dir / name).lexically_normal();
+    std::error_code ec;
+    uint32_t id = fs::is_regular_file(candidate, ec) ? paths.intern(candidate.string()) : UINT32_MAX;
+    resolved.emplace(key, id);
+    return id;
+}
+
+uint32_t include_scanner_t::resolve(uint32_t from, std::string_view name, bool local, std::span<const fs::path> include_dirs)
+{
+    if (local) {
+        if (auto id = lookup(fs::path(paths.get(from)).parent_path(), name); id != UINT32_MAX) {
+            return id;
+        }
+    }
+
+    for (auto& dir : include_dirs) {
+        if (auto id = lookup(dir, name); id != UINT32_MAX) {
+            return id;
+        }
+    }
+
+    return UINT32_MAX;
+}
+
+void include_scanner_t::scan(std::span<const fs::path> sources, std::span<const fs::path> include_dirs)
+{
+    // Files already scanned for another project are not read again, but their includes are
+    // still resolved against these include directories
+    std::unordered_set<uint32_t> visited;
+    std::vector<uint32_t> frontier;
+    for (auto& source : sources) {
+        auto id = paths.intern(source.lexically_normal().string());
+        if (visited.insert(id).second) {
+            frontier.push_back(id);
+        }
+    }
+
+    while (!frontier.empty()) {
+        // Files are only read and scanned in parallel. Paths are interned beforehand and
+        // includes resolved afterwards, as neither the interner nor the deque can grow there
+        std::vector<uint32_t> unscanned;
+        std::vector<std::string_view> names;
+        for (auto id : frontier) {
+            if (!get(id).scanned) {
+                unscanned.push_back(id);
+                names.push_back(paths.get(id));
+            }
+        }
+
+#pragma omp parallel for
+        for (int32_t i = 0; i < int32_t(unscanned.size()); ++i) {
+            auto& file = files[unscanned[i]];
+            auto path = fs::path(names[i]);
+            file.scanned = true;
+
+            std::error_code ec;
+            file.last_write = fs::last_write_time(path, ec);
+            file.exists = !ec;
+            if (!file.exists) {
+                continue;
+            }
+
+            std::string text;
+            std::ifstream in(path, std::ios::binary | std::ios::ate);
+            if (!in.is_open()) {
+                continue;
+            }
+            text.resize(in.tellg());
+            in.seekg(0);
+            in.read(text.data(), text.size());
+
+            std::vector<include_t> includes;
+            find_includes(text, includes);
+            file.includes.reserve(includes.size());
+            for (auto& include : includes) {
+                file.includes.push_back({ std::string(include.name), include.local });
+            }
+        }
+
+        std::vector<uint32_t> next;
+        for (auto id : frontier) {
+            for (auto& include : files[id].includes) {
+                auto resolved_id = resolve(id, include.name, include.local, include_dirs);
+                if (resolved_id != UINT32_MAX && visited.insert(resolved_id).second) {
+                    next.push_back(resolved_id);
+                }
+            }
+        }
+        frontier = std::move(next);
+    }
+}
+
+bool include_scanner_t::is_dirty(const fs::path& source, std::span<const fs::path> include_dirs, fs::file_time_type time)
+{
+    auto source_id = paths.find(source.lexically_normal().string());
+    if (source_id == UINT32_MAX) {
+        return true;
+    }
+
+    std::vector<uint32_t> stack{ source_id };
+    std::unordered_set<uint32_t> visited{ source_id };
+    while (!stack.empty()) {
+        auto id = stack.back();
+        stack.pop_back();
+
+        auto& file = get(id);
+        if (!file.scanned || !file.exists || file.last_write > time) {
+            return true;
+        }
+
+        for (auto& include : file.includes) {
+            auto resolved_id = resolve(id, include.name, include.local, include_dirs);
+            if (resolved_id != UINT32_MAX && visited.insert(resolved_id).second) {
+                stack.push_back(resolved_id);
+            }
+        }
+    }
+
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
+void find_module_directives(std::string_view text, module_unit_t& out)
+{
+    auto is_blank = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+
+    auto skip_blanks = [&](std::string_view& str) {
+        while (!str.empty() && is_blank(str.front())) str.remove_prefix(1);
+    };
+
+    // Consumes keyword if followed by a blank, or by one of the given characters
+    auto keyword = [&](std::string_view& str, std::string_view word, std::string_view followers = {}) {
+        if (!str.starts_with(word) || str.size() == word.size()) return false;
+        char next = str[word.size()];
+        if (!is_blank(next) && !followers.contains(next)) return false;
+        str.remove_prefix(word.size());
+        skip_blanks(str);
+        return true;
+    };
+
+    auto read_name = [&](std::string_view& str) {
+        size_t size = 0;
+        while (size < str.size() && str[size] != ';' && !is_blank(str[size]) && str[size] != '[') size++;
+        return str.substr(0, size);
+    };
+
+    while (!text.empty()) {
+        auto end = text.find('\n');
+        auto line = text.substr(0, end);
+        text = (end == std::string_view::npos) ? std::string_view{} : text.substr(end + 1);
+
+        skip_blanks(line);
+        bool exported = keyword(line, "export");
+
+        if (keyword(line, "module", ";")) {
+            auto name = read_name(line);
+            if (name.empty() || name.starts_with(':')) {
+                continue; // Global module fragment or private module fragment
+            }
+            out.name = name;
+            out.interface = exported;
+            if (!exported && !name.contains(':')) {
+                out.imports.emplace_back(name);
+            }
+        } else if (keyword(line, "import", "<\":")) {
+            if (line.starts_with('<') || line.starts_with('"')) {
+                continue;
+            }
+            auto name = read_name(line);
+            if (name.empty()) {
+                continue;
+            }
+            if (name.starts_with(':')) {
+                auto primary = std::string_view(out.name).substr(0, out.name.find(':'));
+                out.imports.push_back(std::format("{}{}", primary, name));
+            } else {
+                out.imports.emplace_back(name);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "intern.hpp"
+
+#include <deque>
+
+// -----------------------------------------------------------------------------
+//                              Include scanning
+// -----------------------------------------------------------------------------
+
+// Finds #include directives without running a preprocessor. Conditional and macro includes
+// are not understood, so results are approximate, and only used for objects the compiler has
+// not reported dependencies for (e.g. built by an older bldr).
+
+struct include_t
+{
+    std::string_view name;
+    bool            local;
+};
+
+// Directives must be the first token on their line. '#' is located with memchr, which the
+// CRT vectorizes, and "include" is matched by hand.
+void find_includes(std::string_view text, std::vector<include_t>& out);
+
+struct include_scanner_t
+{
+    struct file_include_t
+    {
+        std::string name;
+        bool       local;
+    };
+
+    struct file_t
+    {
+        bool                          scanned = false;
+        bool                           exists = false;
+        fs::file_time_type         last_write = {};
+        std::vector<file_include_t>  includes;
+    };
+
+    string_interner_t                          paths;
+    std::deque<file_t>                         files; // Indexed by path id
+    std::unordered_map<uint64_t, uint32_t>  resolved; // (directory id, name id) -> path id
+
+public:
+    // Scans sources and everything they include. Each breadth first level of newly
+    // discovered files is read and scanned in parallel.
+    void scan(std::span<const fs::path> sources, std::span<const fs::path> include_dirs);
+
+    // True if the source or anything it includes is missing or newer than time. Files must
+    // have been scanned with the same include directories.
+    bool is_dirty(const fs::path& source, std::span<const fs::path> include_dirs, fs::file_time_type time);
+
+private:
+    uint32_t resolve(uint32_t from, std::string_view name, bool local, std::span<const fs::path> include_dirs);
+    uint32_t lookup(const fs::path& dir, std::string_view name);
+    file_t& get(uint32_t id);
+};
+
+// -----------------------------------------------------------------------------
+//                              Module scanning
+// -----------------------------------------------------------------------------
+
+struct module_unit_t
+{
+    std::string                 name; // Module the unit belongs to, empty outside of modules
+    bool                   interface = false; // Declared with "export module", builds a BMI
+    std::vector<std::string> imports; // Partitions as Module:Partition. Header units are skipped.
+};
+
+// Reads module declarations and imports, which must start their line. As with includes,
+// preprocessor conditions are not evaluated. Implementation units ("module M;") import their
+// primary interface.
+void find_module_directives(std::string_view text, module_unit_t& out);
\ No newline at end of file
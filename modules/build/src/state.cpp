@@ -0,0 +1,513 @@
+#include "state.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <spanstream>
+
+#ifdef _WIN32
+#  define NOMINMAX
+#  define WIN32_LEAN_AND_MEAN
+#  include "Windows.h"
+#else
+#  include <sys/stat.h>
+#endif
+
+// -----------------------------------------------------------------------------
+//                                 File stats
+// -----------------------------------------------------------------------------
+
+file_stat_t stat_file(const fs::path& path)
+{
+    file_stat_t stat;
+
+#ifdef _WIN32
+    // Retrieving the file index requires opening the file, so Windows identifies files
+    // by size and time alone
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &data)) {
+        stat.exists = true;
+        stat.size = (uint64_t(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+
+        // file_clock counts 100ns FILETIME intervals since 1601
+        stat.last_write = fs::file_time_type(fs::file_time_type::duration(
+            int64_t((uint64_t(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime)));
+    }
+#else
+    struct stat st;
+    if (::stat(path.c_str(), &st) == 0) {
+        stat.exists = true;
+        stat.size = uint64_t(st.st_size);
+        stat.id = uint64_t(st.st_ino) ^ (uint64_t(st.st_dev) << 40);
+
+        auto since_epoch = std::chrono::seconds(st.st_mtim.tv_sec) + std::chrono::nanoseconds(st.st_mtim.tv_nsec);
+        stat.last_write = std::chrono::time_point_cast<fs::file_time_type::duration>(
+            fs::file_time_type::clock::from_sys(std::chrono::sys_time<std::chrono::nanoseconds>(since_epoch)));
+    }
+#endif
+
+    return stat;
+}
+
+// -----------------------------------------------------------------------------
+//                                  Journal
+// -----------------------------------------------------------------------------
+
+static constexpr std::string_view s_build_state_name = ".build-state";
+static constexpr uint32_t      s_build_state_version = 1;
+
+enum class journal_record_t : uint32_t
+{
+    path,     // Assigned the next path id
+    object,   // Replaces the object's dependency list
+    file,     // Replaces the file's stat and content hash
+    duration, // Replaces the output's build duration
+};
+
+// Hashes of files written more recently than this may share their modification time with a
+// later edit, and are only trusted for the current run
+static constexpr auto s_racy_write_window = std::chrono::seconds(2);
+
+void load_build_state()
+{
+    // Superseded by the build state journal
+    std::error_code ec;
+    fs::remove(s_paths.dir / ".include-cache", ec);
+    fs::remove(s_paths.dir / ".dependencies", ec);
+
+    s_build_state.load(s_paths.dir / s_build_state_name);
+}
+
+void save_build_state()
+{
+    s_build_state.save(s_paths.dir / s_build_state_name);
+}
+
+void build_state_t::load(const fs::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return;
+    }
+    std::vector<char> data;
+    data.resize(fs::file_size(path));
+    in.read(data.data(), data.size());
+
+    std::spanstream din{data};
+
+    auto ReadUInt32 = [&] {
+        uint32_t v = 0;
+        din.read((char*)&v, 4);
+        return v;
+    };
+
+    auto ReadUInt64 = [&] {
+        uint64_t v = 0;
+        din.read((char*)&v, 8);
+        return v;
+    };
+
+    auto ReadString = [&] {
+        auto size = ReadUInt32();
+        std::string str(std::min<size_t>(size, data.size()), '\0');
+        din.read(str.data(), str.size());
+        return str;
+    };
+
+    if (ReadUInt32() != s_build_state_version || !din) {
+        return;
+    }
+
+    // Each record is applied only once fully read. A run interrupted while appending leaves
+    // a partial record at the end, which is dropped, and the journal rewritten on save.
+    journal_valid = true;
+    while (din.peek() != std::spanstream::traits_type::eof()) {
+        switch (journal_record_t(ReadUInt32())) {
+            break;case journal_record_t::path: {
+                auto str = ReadString();
+                if (!din) break;
+                paths.intern(str);
+                journal_paths = paths.size();
+            }
+            break;case journal_record_t::object: {
+                auto object = ReadUInt32();
+                std::vector<uint32_t> dependencies(std::min<size_t>(ReadUInt32(), data.size() / 4));
+                for (auto& id : dependencies) {
+                    id = ReadUInt32();
+                }
+                if (!din) break;
+                if (object >= journal_paths || std::ranges::any_of(dependencies, [&](auto id) { return id >= journal_paths; })) {
+                    din.setstate(std::ios::failbit);
+                    break;
+                }
+                objects[object] = std::move(dependencies);
+                journal_records++;
+            }
+            break;case journal_record_t::file: {
+                auto id = ReadUInt32();
+                file_stat_t stat{ .exists = true };
+                stat.size = ReadUInt64();
+                stat.last_write = fs::file_time_type(fs::file_time_type::duration(int64_t(ReadUInt64())));
+                stat.id = ReadUInt64();
+                hash_t content;
+                content.low = ReadUInt64();
+                content.high = ReadUInt64();
+                if (!din) break;
+                if (id >= journal_paths) {
+                    din.setstate(std::ios::failbit);
+                    break;
+                }
+                auto& state = get_state(id);
+                state.stat = stat;
+                state.hashed = true;
+                state.durable = true;
+                state.content = content;
+                journal_records++;
+            }
+            break;case journal_record_t::duration: {
+                auto id = ReadUInt32();
+                auto duration = std::chrono::nanoseconds(int64_t(ReadUInt64()));
+                if (!din) break;
+                if (id >= journal_paths) {
+                    din.setstate(std::ios::failbit);
+                    break;
+                }
+                durations[id] = duration;
+                journal_records++;
+            }
+            break;default:
+                din.setstate(std::ios::failbit);
+        }
+
+        if (!din) {
+            log_warn("Build state [{}] is truncated, discarding partial records", path.string());
+            journal_valid = false;
+            break;
+        }
+    }
+}
+
+void build_state_t::save(const fs::path& path)
+{
+    bool pending = !pending_objects.empty() || !pending_durations.empty() || std::ranges::any_of(files, &file_state_t::pending);
+    if (journal_valid && !pending) {
+        return;
+    }
+
+    // Rewrite once superseded records outnumber live ones, or if the journal can't be appended to
+    size_t live = objects.size() + durations.size() + std::ranges::count_if(files, [](auto& state) { return state.hashed && state.durable; });
+    bool append = journal_valid && journal_records <= live * 2 + 1024;
+
+    if (!write(path, append)) {
+        log_warn("Failed to write build state [{}]", path.string());
+    }
+}
+
+bool build_state_t::write(const fs::path& path, bool append)
+{
+    // Appends reuse the ids already in the journal. Rewrites drop paths no longer referenced,
+    // renumbering the rest.
+    std::vector<uint32_t> remap(paths.size(), UINT32_MAX);
+    std::vector<uint32_t> new_paths;
+    auto use = [&](uint32_t id) {
+        if (remap[id] == UINT32_MAX) {
+            remap[id] = uint32_t(new_paths.size());
+            new_paths.push_back(id);
+        }
+    };
+
+    std::vector<uint32_t> object_ids;
+    std::vector<uint32_t> file_ids;
+    std::vector<uint32_t> duration_ids;
+    if (append) {
+        for (uint32_t id = 0; id < paths.size(); ++id) {
+            remap[id] = id;
+        }
+        new_paths.resize(paths.size() - journal_paths);
+        std::iota(new_paths.begin(), new_paths.end(), journal_paths);
+        object_ids.assign(pending_objects.begin(), pending_objects.end());
+        duration_ids.assign(pending_durations.begin(), pending_durations.end());
+        for (uint32_t id = 0; id < files.size(); ++id) {
+            if (files[id].pending) file_ids.push_back(id);
+        }
+    } else {
+        for (auto&[object, dependencies] : objects) {
+            object_ids.push_back(object);
+            use(object);
+            for (auto id : dependencies) use(id);
+        }
+        for (uint32_t id = 0; id < files.size(); ++id) {
+            if (files[id].hashed && files[id].durable) {
+                file_ids.push_back(id);
+                use(id);
+            }
+        }
+        for (auto&[output, duration] : durations) {
+            duration_ids.push_back(output);
+            use(output);
+        }
+    }
+
+    auto target = append ? path : fs::path(std::format("{}.{:08x}.tmp", path.string(), std::random_device{}()));
+    std::ofstream out(target, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+
+    auto WriteUInt32 = [&](uint32_t v) {
+        out.write((const char*)&v, 4);
+    };
+
+    auto WriteUInt64 = [&](uint64_t v) {
+        out.write((const char*)&v, 8);
+    };
+
+    auto WriteString = [&](std::string_view s) {
+        WriteUInt32(uint32_t(s.size()));
+        out.write(s.data(), s.size());
+    };
+
+    if (!append) {
+        WriteUInt32(s_build_state_version);
+    }
+
+    for (auto id : new_paths) {
+        WriteUInt32(uint32_t(journal_record_t::path));
+        WriteString(paths.get(id));
+    }
+
+    for (auto object : object_ids) {
+        auto& dependencies = objects[object];
+        WriteUInt32(uint32_t(journal_record_t::object));
+        WriteUInt32(remap[object]);
+        WriteUInt32(uint32_t(dependencies.size()));
+        for (auto id : dependencies) {
+            WriteUInt32(remap[id]);
+        }
+    }
+
+    for (auto id : file_ids) {
+        auto& state = files[id];
+        WriteUInt32(uint32_t(journal_record_t::file));
+        WriteUInt32(remap[id]);
+        WriteUInt64(state.stat.size);
+        WriteUInt64(uint64_t(state.stat.last_write.time_since_epoch().count()));
+        WriteUInt64(state.stat.id);
+        WriteUInt64(state.content.low);
+        WriteUInt64(state.content.high);
+    }
+
+    for (auto id : duration_ids) {
+        WriteUInt32(uint32_t(journal_record_t::duration));
+        WriteUInt32(remap[id]);
+        WriteUInt64(uint64_t(durations[id].count()));
+    }
+
+    out.close();
+    if (!out) {
+        return false;
+    }
+
+    if (!append) {
+        std::error_code ec;
+        fs::rename(target, path, ec);
+        if (ec) {
+            fs::remove(target, ec);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+//                                  Queries
+// -----------------------------------------------------------------------------
+
+file_state_t& build_state_t::get_state(uint32_t id)
+{
+    if (id >= files.size()) {
+        files.resize(id + 1);
+    }
+    return files[id];
+}
+
+file_stat_t build_state_t::stat(uint32_t id)
+{
+    std::string path;
+    {
+        std::scoped_lock lock{ mutex };
+        auto& state = get_state(id);
+        if (state.statted) {
+            return state.stat;
+        }
+        path = paths.get(id);
+    }
+
+    // Stat without holding the lock, concurrent threads agree on the result
+    auto stat = stat_file(path);
+
+    std::scoped_lock lock{ mutex };
+    auto& state = get_state(id);
+    if (!state.statted) {
+        if (stat != state.stat) {
+            state.hashed = false;
+            state.pending = false;
+        }
+        state.stat = stat;
+        state.statted = true;
+    }
+    return state.stat;
+}
+
+file_stat_t build_state_t::stat(const fs::path& path)
+{
+    uint32_t id;
+    {
+        std::scoped_lock lock{ mutex };
+        id = paths.intern(path.string());
+    }
+    return stat(id);
+}
+
+void build_state_t::record(const fs::path& object, std::span<const std::string> dependencies)
+{
+    std::scoped_lock lock{ mutex };
+
+    std::vector<uint32_t> ids;
+    ids.reserve(dependencies.size());
+    for (auto& dependency : dependencies) {
+        ids.push_back(paths.intern(dependency));
+    }
+
+    auto object_id = paths.intern(object.string());
+    get_state(object_id).statted = false;
+
+    auto& recorded = objects[object_id];
+    if (recorded != ids) {
+        recorded = std::move(ids);
+        pending_objects.insert(object_id);
+    }
+}
+
+void build_state_t::record_duration(const fs::path& output, std::chrono::nanoseconds duration)
+{
+    std::scoped_lock lock{ mutex };
+
+    auto id = paths.intern(output.string());
+    durations[id] = duration;
+    pending_durations.insert(id);
+}
+
+std::chrono::nanoseconds build_state_t::get_duration(const fs::path& output)
+{
+    std::scoped_lock lock{ mutex };
+
+    auto id = paths.find(output.string());
+    auto i = durations.find(id);
+    return (id != UINT32_MAX && i != durations.end()) ? i->second : std::chrono::nanoseconds{};
+}
+
+bool build_state_t::contains(const fs::path& object)
+{
+    std::scoped_lock lock{ mutex };
+
+    auto id = paths.find(object.string());
+    auto i = objects.find(id);
+    return id != UINT32_MAX && i != objects.end() && !i->second.empty();
+}
+
+std::vector<std::string> build_state_t::get(const fs::path& object)
+{
+    std::scoped_lock lock{ mutex };
+
+    std::vector<std::string> out;
+    auto id = paths.find(object.string());
+    if (auto i = objects.find(id); id != UINT32_MAX && i != objects.end()) {
+        for (auto dependency : i->second) {
+            out.emplace_back(paths.get(dependency));
+        }
+    }
+    return out;
+}
+
+bool build_state_t::is_dirty(const fs::path& object, fs::file_time_type time)
+{
+    std::vector<uint32_t> dependencies;
+    {
+        std::scoped_lock lock{ mutex };
+
+        auto id = paths.find(object.string());
+        auto i = objects.find(id);
+        if (id == UINT32_MAX || i == objects.end() || i->second.empty()) {
+            return true;
+        }
+        dependencies = i->second;
+    }
+
+    for (auto dependency : dependencies) {
+        auto stat = this->stat(dependency);
+        if (!stat.exists || stat.last_write > time) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+hash_t build_state_t::hash_files(std::span<const std::string> files_to_hash)
+{
+    hasher_t hasher;
+
+    for (auto& file : files_to_hash) {
+        hasher.update(file);
+
+        uint32_t id;
+        {
+            std::scoped_lock lock{ mutex };
+            id = paths.intern(file);
+        }
+
+        auto stat = this->stat(id);
+        {
+            std::scoped_lock lock{ mutex };
+            auto& state = get_state(id);
+            if (state.hashed || !stat.exists) {
+                hasher.update(uint64_t(stat.exists));
+                hasher.update(stat.exists ? state.content : hash_t{});
+                continue;
+            }
+        }
+
+        // Read without holding the lock. Concurrent compile threads may hash the same
+        // file twice, but always arrive at the same digest.
+        hash_t content;
+        bool exists = false;
+        {
+            std::ifstream in(file, std::ios::binary | std::ios::ate);
+            if (in.is_open()) {
+                std::string str;
+                str.resize(in.tellg());
+                in.seekg(0);
+                in.read(str.data(), str.size());
+                content = hasher_t().update(str.data(), str.size()).finish();
+                exists = true;
+            }
+        }
+
+        if (exists) {
+            std::scoped_lock lock{ mutex };
+            auto& state = get_state(id);
+            if (!state.hashed) {
+                state.hashed = true;
+                state.content = content;
+                state.durable = stat.last_write + s_racy_write_window < fs::file_time_type::clock::now();
+                state.pending = state.durable;
+            }
+        }
+
+        hasher.update(uint64_t(exists));
+        hasher.update(content);
+    }
+
+    return hasher.finish();
+}
\ No newline at end of file
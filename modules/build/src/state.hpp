@@ -0,0 +1,97 @@
+#pragma once
+
+#include "hash.hpp"
+#include "intern.hpp"
+
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+
+// -----------------------------------------------------------------------------
+//                                 File stats
+// -----------------------------------------------------------------------------
+
+struct file_stat_t
+{
+    bool                   exists = false;
+    uint64_t                 size = 0;
+    fs::file_time_type last_write = {};
+    uint64_t                   id = 0; // Inode and device where available, 0 on Windows
+
+    bool operator==(const file_stat_t&) const = default;
+};
+
+// A single GetFileAttributesEx / stat call
+file_stat_t stat_file(const fs::path& path);
+
+// -----------------------------------------------------------------------------
+//                                Build state
+// -----------------------------------------------------------------------------
+
+struct file_state_t
+{
+    bool       statted = false; // stat is current for this run
+    file_stat_t   stat;
+    bool        hashed = false; // content was hashed with the file matching stat
+    hash_t     content = {};
+    bool       durable = false; // Hash can be trusted by later runs
+    bool       pending = false; // Hash not yet written to the journal
+};
+
+// Everything bldr remembers between runs: the dependency lists compilers reported for each
+// object, the content hash of each file along with the stat it was taken at, and how long each
+// output last took to build.
+//
+// Stored as an append-only journal of path, object, file and duration records, replayed on load with
+// later records replacing earlier ones. Runs that change nothing write nothing, others only
+// append their new records. The journal is rewritten once superseded records dominate it.
+struct build_state_t
+{
+    std::mutex                                               mutex;
+    string_interner_t                                        paths;
+    std::unordered_map<uint32_t, std::vector<uint32_t>>    objects;
+    std::deque<file_state_t>                                 files; // Indexed by path id
+    std::unordered_map<uint32_t, std::chrono::nanoseconds> durations;
+
+    uint32_t                                         journal_paths = 0; // Paths already in the journal
+    size_t                                         journal_records = 0; // Object and file records in the journal
+    bool                                             journal_valid = false;
+    std::unordered_set<uint32_t>                   pending_objects;
+    std::unordered_set<uint32_t>                 pending_durations;
+
+public:
+    void load(const fs::path& path);
+    void save(const fs::path& path);
+
+    // Stats each path at most once per run. Outputs written during the run are refreshed by
+    // record, other files are assumed not to change while building.
+    file_stat_t stat(const fs::path& path);
+
+    void record(const fs::path& object, std::span<const std::string> dependencies);
+
+    // True if a non-empty dependency list has been recorded for the object
+    bool contains(const fs::path& object);
+
+    // Returns an empty list if no dependencies have been recorded for the object
+    std::vector<std::string> get(const fs::path& object);
+
+    // True if the object has no (or an empty) record, or a recorded dependency is missing or
+    // newer than time
+    bool is_dirty(const fs::path& object, fs::file_time_type time);
+
+    void record_duration(const fs::path& output, std::chrono::nanoseconds duration);
+
+    // Returns zero if the output has not been built before
+    std::chrono::nanoseconds get_duration(const fs::path& output);
+
+    // Digest of the paths and contents of files. Contents are only read when a file's stat
+    // differs from the one its last hash was taken at
+    hash_t hash_files(std::span<const std::string> files);
+
+private:
+    file_state_t& get_state(uint32_t id);
+    file_stat_t stat(uint32_t id);
+    bool write(const fs::path& path, bool append);
+};
+
+inline build_state_t s_build_state;
\ No newline at end of file
@@ -0,0 +1,529 @@
+#include "toolchain.hpp"
+#include "state.hpp"
+#include "log.hpp"
+
+#include <cstdlib>
+#include <ranges>
+#include <sstream>
+
+namespace
+{
+    void arg(program_exec_t& info, auto&&... args)
+    {
+        std::stringstream ss;
+        (ss << ... << args);
+        info.arguments.push_back(ss.str());
+    }
+
+    void args(program_exec_t& info, auto&&... _args)
+    {
+        (arg(info, _args), ...);
+    }
+}
+
+// -----------------------------------------------------------------------------
+//                                    MSVC
+// -----------------------------------------------------------------------------
+
+static void msvc_compile(program_exec_t& info, const project_t& project, const source_t& source,
+    const fs::path& object, const fs::path& dependencies, flags_t flags, const compile_inputs_t& inputs, bool create_pch)
+{
+    add_program(info, "cl");
+
+    // TODO: Parameterize
+
+    arg(info, "/c");               // Compile without linking
+    arg(info, "/nologo");          // Suppress banner
+    arg(info, "/arch:AVX2");       // AVX2 vector extensions
+    if (is_set(flags, flags_t::debug)) {
+        arg(info, "/MDd");         // Use dynamic debug CRT
+    } else {
+        arg(info, "/MD");          // Use dynamic non-debug CRT
+    }
+    arg(info, "/Zc:preprocessor"); // Use conforming preprocessor
+    arg(info, "/permissive-");     // Disable permissive mode
+    // arg(info, "/fp:fast");      // Allow floating point reordering
+    arg(info, "/utf-8");           // Set source and execution character sets
+    arg(info, "/Zc:char8_t-");     // Treat u8"" strings as char instead of char8_t
+
+    if (!is_set(flags, flags_t::noopt)) {
+        arg(info, "/O2");          // Maximum optimization level
+        arg(info, "/Ob3");         // Maximum inlining level
+    }
+
+    arg(info, "/cgthreads8");      // threads for optimization + code generation
+
+    arg(info, "/DUNICODE");        // Specify UNICODE for win32
+    arg(info, "/D_UNICODE");
+
+    if (is_set(flags, flags_t::lto)) {
+        arg(info, "/GL");          // Enable whole program optimization
+        arg(info, "/Gw");          // Optimize global data
+    }
+
+    if (!is_set(flags, flags_t::strip)) {
+        arg(info, "/Z7");          // Generate debug info and include in object files
+        arg(info, "/DEBUG");
+    }
+
+    arg(info, "/constexpr:steps10000000"); // Increase constexpr step limit
+
+    arg(info, "/D_CRT_SECURE_NO_WARNINGS"); // Suppress MS "security" warnings
+
+    if (!is_set(flags, flags_t::nowarn)) {
+        arg(info, "/W4");     // Warning level 4
+        arg(info, "/WX");     // Warnings as errors
+
+        arg(info, "/we4289"); // nonstandard extension used: 'variable': loop control variable declared in the for-loop is used outside the for-loop scope
+
+        arg(info, "/w14242"); // 'identifier': conversion from 'type1' to 'type1', possible loss of data
+        arg(info, "/w14254"); // 'operator': conversion from 'type1:field_bits' to 'type2:field_bits', possible loss of data
+        arg(info, "/w14263"); // 'function': member function does not override any base class virtual member function
+        arg(info, "/w14265"); // 'classname': class has virtual functions, but destructor is not virtual instances of this class may not be destructed correctly
+        arg(info, "/w14287"); // 'operator': unsigned/negative constant mismatch
+        arg(info, "/w14296"); // 'operator': expression is always 'boolean_value'
+        arg(info, "/w14311"); // 'variable': pointer truncation from 'type1' to 'type2'
+        arg(info, "/w14545"); // expression before comma evaluates to a function which is missing an argument list
+        arg(info, "/w14546"); // function call before comma missing argument list
+        arg(info, "/w14547"); // 'operator': operator before comma has no effect; expected operator with side effect
+        arg(info, "/w14549"); // 'operator': operator before comma has no effect; did you intend 'operator'?
+        arg(info, "/w14555"); // expression has no effect; expected expression with side- effect
+        arg(info, "/w14640"); // Enable warning on thread unsafe static member initialization
+        arg(info, "/w14826"); // Conversion from 'type1' to 'type_2' is sign-extended. This may cause unexpected runtime behavior.
+        arg(info, "/w14905"); // wide string literal cast to 'LPSTR'
+        arg(info, "/w14906"); // string literal cast to 'LPWSTR'
+        arg(info, "/w14928"); // illegal copy-initialization; more than one user-defined conversion has been implicitly applied
+
+        arg(info, "/wd4324"); // 'struct': structure was padded due to alignment specifier
+        arg(info, "/wd4505"); // 'function': unreferenced function with internal linkage has been removed
+
+        arg(info, "/permissive-"); // standards conformance mode for MSVC compiler.
+    }
+
+    if (is_set(flags, flags_t::debug)) {
+        arg(info, "/DDEBUG");   // Enable debug checks
+        arg(info, "/D_DEBUG");
+    }
+
+    if (source.type == source_type_t::c) {
+        arg(info, "/std:c23");
+        arg(info, "/Tc", source.file.string());
+    } else {
+        arg(info, "/EHsc");           // Full exception unwinding
+        arg(info, "/openmp:llvm");    // LLVM openmp (enables unsigned loop counters)
+        arg(info, "/Zc:__cplusplus"); // Use correct __cplusplus macro value
+        arg(info, "/std:c++latest");  // Use latest C++ language version
+        if (source.type == source_type_t::cpp) {
+            arg(info, "/experimental:module"); // Enable modules
+            arg(info, "/translateInclude");    // Enable header include -> module import translation
+        }
+        if (!inputs.interface.empty()) {
+            arg(info, "/interface");           // Compile as a module interface
+            args(info, "/ifcOutput", inputs.interface.string());
+        }
+        for (auto& import : inputs.imports) {
+            args(info, "/reference", std::format("{}={}", import.name, import.bmi.string()));
+        }
+        arg(info, "/Tp", source.file.string());
+    }
+
+    // The PCH must be the first force include. Its creator includes the header from the stub,
+    // so nothing precedes it there either.
+
+    if (!inputs.pch.empty()) {
+        arg(info, create_pch ? "/Yc" : "/Yu", project.pch.generic_string());
+        arg(info, "/Fp", inputs.pch.string());
+        if (!create_pch) {
+            arg(info, "/FI", project.pch.generic_string());
+        }
+    }
+
+    for (auto& include : project.includes) arg(info, "/I",  include.string());
+    if (!create_pch) {
+        for (auto& include : project.force_includes) arg(info, "/FI", include.string());
+    }
+    for (auto& define  : project.build_defines)  arg(info, "/D", to_string(define));
+
+    arg(info, "/Fo", object.string());
+    arg(info, "/sourceDependencies", dependencies.string());
+}
+
+static size_t msvc_link(program_exec_t& info, const project_t& project, const fs::path& output,
+    std::span<const std::string> objects, flags_t flags)
+{
+    add_program(info, "link");
+    arg(info, "/nologo");
+    auto prefix = info.arguments.size();
+
+
+    arg(info, "/IGNORE:4099");     // PDB 'filename' was not found with 'object/library' or at 'path'; linking object as if no debug info
+    if (is_set(flags, flags_t::lto)) {
+        arg(info, "/LTCG");
+    } else {
+        arg(info, "/INCREMENTAL"); // Incremental build when not optimizing
+    }
+    arg(info, "/DYNAMICBASE:NO");  // Disable address space layout randomization.
+
+    arg(info, "/DEBUG");
+
+    if (is_set(flags, flags_t::debug)) {
+        arg(info, "/NODEFAULTLIB:msvcrt.lib");
+    } else {
+        arg(info, "/NODEFAULTLIB:msvcrtd.lib");
+    }
+    arg(info, "/NODEFAULTLIB:libcmt.lib");
+    arg(info, "/NODEFAULTLIB:libcmtd.lib");
+
+    // Target
+
+    auto& artifact = project.artifact.value();
+    if (artifact.type == artifact_type_t::console || artifact.type == artifact_type_t::window) {
+        arg(info, "/SUBSYSTEM:", artifact.type == artifact_type_t::console ? "CONSOLE" : "WINDOWS");
+    } else if (artifact.type == artifact_type_t::shared_library) {
+        arg(info, "/DLL");
+    }
+
+    arg(info, "/OUT:", output.string());
+
+    // Library paths
+
+    for (auto& lib_path : project.lib_paths) {
+        arg(info, "/LIBPATH:", lib_path.string());
+    }
+
+    // Additional Links
+
+    for (auto& link : project.links) {
+        arg(info, link.string());
+    }
+
+    // Objects
+
+    for (auto& object : objects) {
+        arg(info, object);
+    }
+
+    // // Mark dlls as lazy load
+    // // TODO: ONLY do this for dlls with a specific flag set in the bldr script
+    // {
+    //     for (auto& shared_lib_glob : project.shared_libs) {
+    //         for (auto& shared_lib : resolve_glob(shared_lib_glob)) {
+    //             arg(info, "/DELAYLOAD:", shared_lib.filename().string());
+    //             // auto slib_target = path.parent_path() / shared_lib.filename();
+    //             // fs::remove(slib_target);
+    //             // fs::copy(shared_lib, slib_target);
+    //         }
+    //     }
+    // }
+    // arg(info, "delayimp.lib");
+
+    // Add default windows libraries
+
+    arg(info, "user32.lib");
+    arg(info, "gdi32.lib");
+    arg(info, "shell32.lib");
+    arg(info, "Winmm.lib");
+    arg(info, "Advapi32.lib");
+    arg(info, "Comdlg32.lib");
+    arg(info, "comsuppw.lib");
+    arg(info, "onecore.lib");
+
+    arg(info, "D3D12.lib");
+    arg(info, "DXGI.lib");
+    arg(info, "dcomp.lib");
+    arg(info, "d3d11.lib");
+
+    return prefix;
+}
+
+// -----------------------------------------------------------------------------
+//                                 GCC / Clang
+// -----------------------------------------------------------------------------
+
+static void gnu_compile(const toolchain_t& toolchain, program_exec_t& info, const project_t& project, const source_t& source,
+    const fs::path& object, const fs::path& dependencies, flags_t flags, const compile_inputs_t& inputs, bool create_pch)
+{
+    bool is_c = source.type == source_type_t::c;
+    bool is_clang = toolchain.type == toolchain_type_t::clang;
+    add_program(info, is_c ? toolchain.c_driver : toolchain.cpp_driver);
+
+    if (!create_pch) {
+        arg(info, "-c");           // Compile without linking
+    }
+#if defined(__x86_64__) || defined(_M_X64)
+    arg(info, "-march=x86-64-v3"); // AVX2 vector extensions
+#endif
+    arg(info, "-fPIC");            // Objects may be linked into shared libraries
+
+    if (!is_set(flags, flags_t::noopt)) {
+        arg(info, "-O2");          // Optimize without trading size for speed
+    }
+
+    if (is_set(flags, flags_t::lto)) {
+        arg(info, "-flto");        // Enable whole program optimization
+    }
+
+    if (!is_set(flags, flags_t::strip)) {
+        arg(info, "-g");           // Generate debug info
+    }
+
+    if (!is_set(flags, flags_t::nowarn)) {
+        arg(info, "-Wall");        // Warnings roughly matching MSVC /W4
+        arg(info, "-Wextra");
+        arg(info, "-Werror");      // Warnings as errors
+        arg(info, "-Wno-missing-field-initializers");
+    }
+
+    if (is_set(flags, flags_t::debug)) {
+        arg(info, "-DDEBUG");      // Enable debug checks
+        arg(info, "-D_DEBUG");
+    }
+
+    if (is_c) {
+        args(info, "-x", "c");
+        arg(info, "-std=c2x");
+    } else {
+        if (create_pch) {
+            args(info, "-x", "c++-header");
+        } else if (is_clang && !inputs.interface.empty()) {
+            args(info, "-x", "c++-module");
+        } else {
+            args(info, "-x", "c++");
+        }
+        arg(info, "-std=c++23");
+        arg(info, "-fopenmp");     // OpenMP pragmas
+    }
+
+    // Modules. gcc finds BMIs through a mapper file, clang is told each one.
+
+    if (!inputs.interface.empty() || !inputs.imports.empty()) {
+        if (is_clang) {
+            if (!inputs.interface.empty()) {
+                arg(info, "-fmodule-output=", inputs.interface.string());
+            }
+            for (auto& import : inputs.imports) {
+                arg(info, "-fmodule-file=", import.name, "=", import.bmi.string());
+            }
+        } else {
+            arg(info, "-fmodules-ts");
+            arg(info, "-fmodule-mapper=", inputs.module_map.string());
+        }
+    }
+
+    // The PCH must be the first include. gcc finds it next to the stub, and falls back to
+    // parsing the header when it cannot be used.
+
+    if (!inputs.pch.empty() && !create_pch) {
+        if (is_clang) {
+            args(info, "-include-pch", inputs.pch.string());
+        } else {
+            arg(info, "-Winvalid-pch");
+            args(info, "-include", fs::path(inputs.pch).replace_extension().string());
+        }
+    }
+
+    for (auto& include : project.includes) args(info, "-I", include.string());
+    if (!create_pch) {
+        for (auto& include : project.force_includes) args(info, "-include", include.string());
+    }
+    for (auto& define  : project.build_defines)  arg(info, "-D", to_string(define));
+
+    args(info, "-o", object.string());
+    args(info, "-MD", "-MF", dependencies.string());
+
+    arg(info, source.file.string());
+}
+
+static size_t gnu_link(const toolchain_t& toolchain, program_exec_t& info, const project_t& project, const fs::path& output,
+    std::span<const std::string> objects, flags_t flags)
+{
+    add_program(info, toolchain.cpp_driver);
+    auto prefix = info.arguments.size();
+
+    if (project.artifact->type == artifact_type_t::shared_library) {
+        arg(info, "-shared");
+    }
+
+    if (is_set(flags, flags_t::lto)) {
+        arg(info, "-flto");
+    }
+
+    if (is_set(flags, flags_t::strip)) {
+        arg(info, "-s");
+    }
+
+    args(info, "-o", output.string());
+
+    for (auto& lib_path : project.lib_paths) {
+        args(info, "-L", lib_path.string());
+    }
+
+    // Libraries after objects, as they are only searched for symbols already referenced
+
+    for (auto& object : objects) {
+        arg(info, object);
+    }
+
+    for (auto& link : project.links) {
+        arg(info, link.string());
+    }
+
+    arg(info, "-fopenmp");
+    arg(info, "-pthread");
+    arg(info, "-ldl");
+
+    return prefix;
+}
+
+// -----------------------------------------------------------------------------
+
+// Resolves a program the way the shell would, returns an empty path if not found
+static fs::path find_on_path(std::string_view program)
+{
+#ifdef _WIN32
+    constexpr char separator = ';';
+    constexpr std::string_view extensions[] = { "", ".exe" };
+#else
+    constexpr char separator = ':';
+    constexpr std::string_view extensions[] = { "" };
+#endif
+
+    auto* path_var = std::getenv("PATH");
+    if (!path_var) return {};
+
+    for (auto dir : std::views::split(std::string_view(path_var), separator)) {
+        if (dir.empty()) continue;
+        for (auto extension : extensions) {
+            auto candidate = fs::path(std::string_view(dir)) / (std::string(program) + std::string(extension));
+            if (stat_file(candidate).exists) {
+                return candidate;
+            }
+        }
+    }
+
+    return {};
+}
+
+hash_t toolchain_t::identity() const
+{
+    hasher_t hasher;
+    hasher.update(uint64_t(type));
+
+    if (type == toolchain_type_t::msvc) {
+#ifdef _WIN32
+        // The MSVC environment pins the toolset version, SDK and library paths
+        hasher.update(get_build_environment());
+#endif
+        return hasher.finish();
+    }
+
+    // Identify drivers by their resolved path and stat, and the variables they search
+    for (auto& driver : { c_driver, cpp_driver }) {
+        hasher.update(driver);
+        if (auto candidate = find_on_path(driver); !candidate.empty()) {
+            auto resolved = fs::weakly_canonical(candidate);
+            auto target = stat_file(resolved);
+            hasher.update(resolved.string());
+            hasher.update(target.size);
+            hasher.update(uint64_t(target.last_write.time_since_epoch().count()));
+        }
+    }
+
+    for (auto* name : { "CPATH", "C_INCLUDE_PATH", "CPLUS_INCLUDE_PATH", "LIBRARY_PATH" }) {
+        auto* value = std::getenv(name);
+        hasher.update(std::string_view(value ? value : ""));
+    }
+
+    return hasher.finish();
+}
+
+void toolchain_t::compile(program_exec_t& info, const project_t& project, const source_t& source,
+    const fs::path& object, const fs::path& dependencies, flags_t flags, const compile_inputs_t& inputs) const
+{
+    if (type == toolchain_type_t::msvc) {
+        msvc_compile(info, project, source, object, dependencies, flags, inputs, false);
+    } else {
+        gnu_compile(*this, info, project, source, object, dependencies, flags, inputs, false);
+    }
+}
+
+void toolchain_t::precompile(program_exec_t& info, const project_t& project, const fs::path& stub, const fs::path& pch,
+    const fs::path& object, const fs::path& dependencies, flags_t flags) const
+{
+    source_t source{ {stub.string()}, source_type_t::cpp };
+    compile_inputs_t inputs;
+    inputs.pch = pch;
+
+    if (type == toolchain_type_t::msvc) {
+        msvc_compile(info, project, source, object, dependencies, flags, inputs, true);
+    } else {
+        gnu_compile(*this, info, project, source, pch, dependencies, flags, inputs, true);
+    }
+}
+
+fs::path toolchain_t::pch_path(const fs::path& stub) const
+{
+    auto path = stub;
+    path += (type == toolchain_type_t::gcc) ? ".gch" : ".pch";
+    return path;
+}
+
+std::string_view toolchain_t::bmi_extension() const
+{
+    switch (type) {
+        break;case toolchain_type_t::msvc:  return ".ifc";
+        break;case toolchain_type_t::gcc:   return ".gcm";
+        break;case toolchain_type_t::clang: return ".pcm";
+    }
+    return ".bmi";
+}
+
+fs::path toolchain_t::output_path(const artifact_t& artifact) const
+{
+    auto path = artifact.path;
+#ifdef _WIN32
+    path.replace_extension(artifact.type == artifact_type_t::shared_library ? ".dll" : ".exe");
+#else
+    path.replace_extension(artifact.type == artifact_type_t::shared_library ? ".so" : "");
+#endif
+    return path;
+}
+
+size_t toolchain_t::link(program_exec_t& info, const project_t& project, const fs::path& output,
+    std::span<const std::string> objects, flags_t flags) const
+{
+    return (type == toolchain_type_t::msvc)
+        ? msvc_link(info, project, output, objects, flags)
+        : gnu_link(*this, info, project, output, objects, flags);
+}
+
+const toolchain_t& get_toolchain()
+{
+    static toolchain_t toolchain = [] {
+        std::string_view name = std::getenv("BLDR_TOOLCHAIN") ? std::getenv("BLDR_TOOLCHAIN") :
+#ifdef _WIN32
+            "msvc";
+#else
+            "gcc";
+#endif
+
+        if (name == "msvc") {
+#ifndef _WIN32
+            log_error("The MSVC toolchain is only available on Windows");
+            std::exit(1);
+#endif
+            return toolchain_t{ toolchain_type_t::msvc, "cl", "cl", dependency_format_t::msvc_json };
+        } else if (name == "gcc") {
+            return toolchain_t{ toolchain_type_t::gcc, "gcc", "g++", dependency_format_t::makefile };
+        } else if (name == "clang") {
+            return toolchain_t{ toolchain_type_t::clang, "clang", "clang++", dependency_format_t::makefile };
+        }
+
+        log_error("Unrecognized toolchain: [{}]. Must be one of:", name);
+        log_error(" - msvc");
+        log_error(" - gcc");
+        log_error(" - clang");
+        std::exit(1);
+    }();
+    return toolchain;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "deps.hpp"
+#include "hash.hpp"
+
+// -----------------------------------------------------------------------------
+//                                 Toolchains
+// -----------------------------------------------------------------------------
+
+enum class toolchain_type_t
+{
+    msvc,
+    gcc,
+    clang,
+};
+
+struct module_reference_t
+{
+    std::string name; // Module, or Module:Partition
+    fs::path     bmi;
+};
+
+// Precompiled header and module interfaces read or written by a compile
+struct compile_inputs_t
+{
+    fs::path                             pch; // Written by precompile, empty to parse headers as usual
+    fs::path                       interface; // BMI to write, for module interface units
+    std::vector<module_reference_t>  imports; // Every module imported, directly or not
+    fs::path                      module_map; // gcc mapper file naming the BMI of every module
+};
+
+// Translates projects into compiler and linker command lines
+struct toolchain_t
+{
+    toolchain_type_t                type;
+    std::string                  c_driver; // Compiler drivers, found through PATH
+    std::string                cpp_driver;
+    dependency_format_t dependency_format;
+
+public:
+    // Digest identifying the compiler installation, so cached outputs are never shared
+    // between compiler versions
+    hash_t identity() const;
+
+    // Compiles source to object, with the files read reported to dependencies
+    void compile(program_exec_t& info, const project_t& project, const source_t& source,
+        const fs::path& object, const fs::path& dependencies, flags_t flags, const compile_inputs_t& inputs = {}) const;
+
+    // Precompiles project.pch through a stub header including it, with the same options as the
+    // project's C++ sources. MSVC also writes an object, which must be linked with every consumer.
+    void precompile(program_exec_t& info, const project_t& project, const fs::path& stub, const fs::path& pch,
+        const fs::path& object, const fs::path& dependencies, flags_t flags) const;
+
+    // Where precompile writes the PCH for a stub. gcc only finds it next to the stub.
+    fs::path pch_path(const fs::path& stub) const;
+
+    // Extension of the BMIs written for module interfaces
+    std::string_view bmi_extension() const;
+
+    // Where an artifact is installed, with the platform's executable or library extension
+    fs::path output_path(const artifact_t& artifact) const;
+
+    // Links objects into output. Returns the number of leading arguments naming the linker,
+    // the remainder can be passed in a response file.
+    size_t link(program_exec_t& info, const project_t& project, const fs::path& output,
+        std::span<const std::string> objects, flags_t flags) const;
+};
+
+// Selected with BLDR_TOOLCHAIN (msvc, gcc or clang), defaulting to MSVC on Windows and gcc
+// elsewhere
+const toolchain_t& get_toolchain();
\ No newline at end of file
@@ -58,6 +58,11 @@ if Project "nova" then
             "src/nova/rhi/vulkan/gdi/*",
         }
     end
+
+    if Platform "Linux" then
+        Define "NOVA_PLATFORM_LINUX"
+        Compile "src/nova/core/linux/**"
+    end
 end
 
 --------------------------------------------------------------------------------
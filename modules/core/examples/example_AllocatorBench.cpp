@@ -0,0 +1,517 @@
+#include "main/example_Main.hpp"
+
+#include <nova/core/nova_Pool.hpp>
+
+using namespace std::chrono;
+
+namespace
+{
+// -----------------------------------------------------------------------------
+//                               Allocators
+// -----------------------------------------------------------------------------
+
+    struct BenchAllocator
+    {
+        const char* name;
+
+        void* (*alloc)(usz size);
+        void  (*free)(void* ptr, usz size);
+
+        // Optional, called instead of individual frees at the end of each batch
+        void  (*release_all)() = nullptr;
+
+        bool supports_random_free = true;
+        bool supports_remote_free = true;
+    };
+
+    template<usz Size>
+    struct alignas(16) SizeClassBlock
+    {
+        b8 data[Size];
+    };
+
+    constexpr u32 PoolMinShift = 4;
+    constexpr u32 PoolMaxShift = 14;
+
+    template<u32... Shifts>
+    constexpr auto MakePoolAllocFns(std::integer_sequence<u32, Shifts...>)
+    {
+        return std::array {
+            +[]() -> void* { return nova::Pool<SizeClassBlock<(1ull << (Shifts + PoolMinShift))>>::Get().Allocate(); }...
+        };
+    }
+
+    template<u32... Shifts>
+    constexpr auto MakePoolFreeFns(std::integer_sequence<u32, Shifts...>)
+    {
+        return std::array {
+            +[](void* ptr) { nova::Pool<SizeClassBlock<(1ull << (Shifts + PoolMinShift))>>::Get().Free(ptr); }...
+        };
+    }
+
+    constexpr auto PoolAllocFns = MakePoolAllocFns(std::make_integer_sequence<u32, PoolMaxShift - PoolMinShift + 1>{});
+    constexpr auto PoolFreeFns  = MakePoolFreeFns (std::make_integer_sequence<u32, PoolMaxShift - PoolMinShift + 1>{});
+
+    u32 PoolSizeClass(usz size)
+    {
+        return std::max(u32(std::bit_width(size - 1)), PoolMinShift) - PoolMinShift;
+    }
+
+    nova::Arena& GetBenchArena()
+    {
+        thread_local nova::Arena arena(64ull << 30);
+        return arena;
+    }
+
+    const std::array Allocators {
+        BenchAllocator {
+            .name = "mimalloc",
+            .alloc = [](usz size) { return nova::Alloc(size); },
+            .free = [](void* ptr, usz) { nova::Free(ptr); },
+        },
+        BenchAllocator {
+            .name = "malloc",
+            .alloc = [](usz size) { return std::malloc(size); },
+            .free = [](void* ptr, usz) { std::free(ptr); },
+        },
+        BenchAllocator {
+            .name = "nova::Pool",
+            .alloc = [](usz size) -> void* {
+                u32 size_class = PoolSizeClass(size);
+                return size_class < PoolAllocFns.size() ? PoolAllocFns[size_class]() : nova::Alloc(size);
+            },
+            .free = [](void* ptr, usz size) {
+                u32 size_class = PoolSizeClass(size);
+                if (size_class < PoolFreeFns.size()) PoolFreeFns[size_class](ptr);
+                else nova::Free(ptr);
+            },
+        },
+        BenchAllocator {
+            .name = "nova::Arena",
+            .alloc = [](usz size) { return GetBenchArena().Alloc(size); },
+            .free = [](void*, usz) {},
+            .release_all = [] { GetBenchArena().Reset(); },
+            .supports_random_free = false,
+            .supports_remote_free = false,
+        },
+    };
+
+// -----------------------------------------------------------------------------
+//                            Size distributions
+// -----------------------------------------------------------------------------
+
+    struct SizeDistribution
+    {
+        const char*     name;
+        std::vector<u32> bins;
+    };
+
+    const std::array SizeDistributions {
+        SizeDistribution { "small", { 8, 16, 24, 32, 48, 64 } },
+        SizeDistribution { "mixed", {
+            8, 16, 32, 64,
+            8, 16, 32, 64,
+            8, 16, 32, 64,
+            8, 16, 32, 64,
+            128, 256, 512, 1024,
+            128, 256, 512, 1024,
+            2048, 4096, 8192 } },
+        SizeDistribution { "large", { 1024, 2048, 4096, 8192, 16384, 32768, 65536 } },
+    };
+
+    // Sizes are pre-generated so that RNG cost stays out of the measured loop
+    std::vector<u32> GenerateSizes(const SizeDistribution& dist, u32 seed)
+    {
+        std::mt19937 rng{ seed };
+        std::uniform_int_distribution<u32> bin_dist{ 0, u32(dist.bins.size()) - 1 };
+        std::vector<u32> sizes(1 << 16);
+        for (auto& size : sizes) {
+            size = dist.bins[bin_dist(rng)];
+        }
+        return sizes;
+    }
+
+// -----------------------------------------------------------------------------
+//                               Measurement
+// -----------------------------------------------------------------------------
+
+    // One in every SampleRate operations is individually timed
+    constexpr u64 SampleRate = 64;
+
+    struct ThreadResult
+    {
+        u64                         ops = 0;
+        std::vector<u32> latency_samples;
+        nanoseconds             cpu_time = {};
+    };
+
+    struct ThreadRecorder
+    {
+        ThreadResult& result;
+        nanoseconds  cpu_start = nova::env::GetThreadCpuTime();
+
+        ThreadRecorder(ThreadResult& _result)
+            : result(_result)
+        {
+            result.latency_samples.reserve(1 << 20);
+        }
+
+        ~ThreadRecorder()
+        {
+            result.cpu_time = nova::env::GetThreadCpuTime() - cpu_start;
+        }
+
+        template<typename Fn>
+        NOVA_FORCE_INLINE
+        decltype(auto) Op(Fn&& fn)
+        {
+            if (result.ops++ % SampleRate == 0) [[unlikely]] {
+                auto start = steady_clock::now();
+                if constexpr (std::is_void_v<decltype(fn())>) {
+                    fn();
+                    result.latency_samples.push_back(u32(duration_cast<nanoseconds>(steady_clock::now() - start).count()));
+                } else {
+                    auto value = fn();
+                    result.latency_samples.push_back(u32(duration_cast<nanoseconds>(steady_clock::now() - start).count()));
+                    return value;
+                }
+            } else {
+                return fn();
+            }
+        }
+    };
+
+    // Polls process RSS while a benchmark is running to capture its peak
+    struct RssSampler
+    {
+        std::atomic<usz>  peak = 0;
+        std::jthread    thread;
+
+        RssSampler()
+            : thread([this](std::stop_token stop) {
+                while (!stop.stop_requested()) {
+                    nova::AtomicSetMax(peak, nova::env::GetProcessMemoryUsage().resident);
+                    std::this_thread::sleep_for(5ms);
+                }
+            })
+        {}
+    };
+
+// -----------------------------------------------------------------------------
+//                                Reporter
+// -----------------------------------------------------------------------------
+
+    struct BenchReport
+    {
+        std::string  allocator;
+        std::string    profile;
+        std::string      sizes;
+        u32            threads = 0;
+
+        u64                ops = 0;
+        f64       wall_seconds = 0;
+        f64        cpu_seconds = 0;
+
+        u32 p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;
+
+        usz rss_delta = 0;
+    };
+
+    BenchReport MakeReport(const BenchAllocator& allocator, std::string_view profile, const SizeDistribution& sizes,
+        std::span<ThreadResult> results, f64 wall_seconds, usz rss_delta)
+    {
+        BenchReport report {
+            .allocator = allocator.name,
+            .profile = std::string(profile),
+            .sizes = sizes.name,
+            .threads = u32(results.size()),
+            .wall_seconds = wall_seconds,
+            .rss_delta = rss_delta,
+        };
+
+        std::vector<u32> samples;
+        for (auto& result : results) {
+            report.ops += result.ops;
+            report.cpu_seconds += duration_cast<duration<f64>>(result.cpu_time).count();
+            samples.insert(samples.end(), result.latency_samples.begin(), result.latency_samples.end());
+        }
+
+        if (!samples.empty()) {
+            std::ranges::sort(samples);
+            auto percentile = [&](f64 p) { return samples[std::min(usz(p * samples.size()), samples.size() - 1)]; };
+            report.p50  = percentile(0.5);
+            report.p90  = percentile(0.9);
+            report.p99  = percentile(0.99);
+            report.p999 = percentile(0.999);
+            report.max  = samples.back();
+        }
+
+        return report;
+    }
+
+    void PrintReports(std::span<const BenchReport> reports)
+    {
+        nova::Log("\n{:<12} {:<8} {:<6} {:>3} | {:>10} {:>10} {:>10} | {:>7} {:>7} {:>7} {:>7} {:>7} | {:>9}",
+            "allocator", "profile", "sizes", "thr",
+            "Mops/s", "wall", "cpu/op",
+            "p50", "p90", "p99", "p99.9", "max",
+            "rss");
+
+        for (auto& r : reports) {
+            nova::Log("{:<12} {:<8} {:<6} {:>3} | {:>10.2f} {:>10} {:>10} | {:>7} {:>7} {:>7} {:>7} {:>7} | {:>9}",
+                r.allocator, r.profile, r.sizes, r.threads,
+                (r.ops / r.wall_seconds) / 1e6,
+                nova::DurationToString(duration<f64>(r.wall_seconds)),
+                nova::DurationToString(duration<f64>(r.cpu_seconds / r.ops)),
+                nova::DurationToString(nanoseconds(r.p50)),
+                nova::DurationToString(nanoseconds(r.p90)),
+                nova::DurationToString(nanoseconds(r.p99)),
+                nova::DurationToString(nanoseconds(r.p999)),
+                nova::DurationToString(nanoseconds(r.max)),
+                nova::ByteSizeToString(r.rss_delta));
+        }
+    }
+
+// -----------------------------------------------------------------------------
+//                            Workload profiles
+// -----------------------------------------------------------------------------
+
+    struct Allocation
+    {
+        void* ptr;
+        u32  size;
+    };
+
+    // Random alloc/free over a bounded live set
+    void RunChurn(const BenchAllocator& allocator, const std::vector<u32>& sizes, u64 ops, ThreadResult& result)
+    {
+        constexpr u32 MaxLive = 10'000;
+
+        ThreadRecorder recorder{ result };
+
+        std::vector<Allocation> live;
+        live.reserve(MaxLive);
+
+        std::mt19937 rng{ u32(sizes.size()) };
+        u64 size_index = 0;
+
+        for (u64 i = 0; i < ops; ++i) {
+            if (live.size() < MaxLive) {
+                u32 size = sizes[size_index++ & (sizes.size() - 1)];
+                live.emplace_back(recorder.Op([&] { return allocator.alloc(size); }), size);
+            } else {
+                u32 to_free = std::uniform_int_distribution<u32>(0, u32(live.size()) - 1)(rng);
+                auto allocation = live[to_free];
+                recorder.Op([&] { allocator.free(allocation.ptr, allocation.size); });
+                live[to_free] = live.back();
+                live.pop_back();
+            }
+        }
+
+        for (auto& allocation : live) {
+            allocator.free(allocation.ptr, allocation.size);
+        }
+    }
+
+    // Allocate a long lived working set, then release it all at once
+    void RunBatch(const BenchAllocator& allocator, const std::vector<u32>& sizes, u64 ops, ThreadResult& result)
+    {
+        constexpr u32 BatchSize = 100'000;
+
+        ThreadRecorder recorder{ result };
+
+        std::vector<Allocation> live;
+        live.reserve(BatchSize);
+
+        u64 size_index = 0;
+
+        for (u64 i = 0; i < ops;) {
+            for (u32 j = 0; j < BatchSize && i < ops; ++j, ++i) {
+                u32 size = sizes[size_index++ & (sizes.size() - 1)];
+                void* ptr = recorder.Op([&] { return allocator.alloc(size); });
+
+                // Touch the allocation so that lazily committed memory is counted
+                static_cast<volatile b8*>(ptr)[0] = b8(0);
+
+                live.emplace_back(ptr, size);
+            }
+
+            if (allocator.release_all) {
+                recorder.Op([&] { allocator.release_all(); });
+
+                // Count the release as one free per allocation so that throughput stays comparable
+                result.ops += live.size() - 1;
+            } else {
+                for (auto& allocation : live) {
+                    recorder.Op([&] { allocator.free(allocation.ptr, allocation.size); });
+                }
+            }
+            live.clear();
+        }
+    }
+
+    // Single producer single consumer ring for cross-thread frees
+    struct RemoteQueue
+    {
+        static constexpr u32 Capacity = 4096;
+
+        std::array<Allocation, Capacity> slots;
+        alignas(64) std::atomic<u64> head = 0;
+        alignas(64) std::atomic<u64> tail = 0;
+        alignas(64) std::atomic<bool> done = false;
+
+        void Push(Allocation allocation)
+        {
+            u64 h = head.load(std::memory_order_relaxed);
+            while (h - tail.load(std::memory_order_acquire) >= Capacity) {
+                std::this_thread::yield();
+            }
+            slots[h % Capacity] = allocation;
+            head.store(h + 1, std::memory_order_release);
+        }
+
+        bool Pop(Allocation& allocation)
+        {
+            u64 t = tail.load(std::memory_order_relaxed);
+            while (t == head.load(std::memory_order_acquire)) {
+                if (done.load(std::memory_order_acquire) && t == head.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                std::this_thread::yield();
+            }
+            allocation = slots[t % Capacity];
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+    };
+
+    void RunProducer(const BenchAllocator& allocator, const std::vector<u32>& sizes, u64 ops, RemoteQueue& queue, ThreadResult& result)
+    {
+        ThreadRecorder recorder{ result };
+
+        for (u64 i = 0; i < ops; ++i) {
+            u32 size = sizes[i & (sizes.size() - 1)];
+            queue.Push({ recorder.Op([&] { return allocator.alloc(size); }), size });
+        }
+
+        queue.done.store(true, std::memory_order_release);
+    }
+
+    void RunConsumer(const BenchAllocator& allocator, RemoteQueue& queue, ThreadResult& result)
+    {
+        ThreadRecorder recorder{ result };
+
+        Allocation allocation;
+        while (queue.Pop(allocation)) {
+            recorder.Op([&] { allocator.free(allocation.ptr, allocation.size); });
+        }
+    }
+
+// -----------------------------------------------------------------------------
+
+    std::optional<BenchReport> RunProfile(std::string_view profile, const BenchAllocator& allocator,
+        const SizeDistribution& dist, u32 num_threads, u64 ops_per_thread)
+    {
+        if (profile == "churn"  && !allocator.supports_random_free) return std::nullopt;
+        if (profile == "remote" && !allocator.supports_remote_free) return std::nullopt;
+
+        if (profile == "remote") {
+            num_threads = std::max(2u, num_threads & ~1u);
+        }
+
+        nova::Log("Running {} / {} / {}...", allocator.name, profile, dist.name);
+
+        std::vector<std::vector<u32>> sizes(num_threads);
+        for (u32 i = 0; i < num_threads; ++i) {
+            sizes[i] = GenerateSizes(dist, i + 1);
+        }
+
+        std::vector<ThreadResult> results(num_threads);
+        std::vector<std::unique_ptr<RemoteQueue>> queues;
+        if (profile == "remote") {
+            for (u32 i = 0; i < num_threads / 2; ++i) {
+                queues.emplace_back(std::make_unique<RemoteQueue>());
+            }
+        }
+
+        usz rss_start = nova::env::GetProcessMemoryUsage().resident;
+        RssSampler rss;
+
+        auto wall_start = steady_clock::now();
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(num_threads);
+
+            for (u32 i = 0; i < num_threads; ++i) {
+                threads.emplace_back([&, i] {
+                    if (profile == "churn") {
+                        RunChurn(allocator, sizes[i], ops_per_thread, results[i]);
+                    } else if (profile == "batch") {
+                        RunBatch(allocator, sizes[i], ops_per_thread, results[i]);
+                    } else if (i % 2 == 0) {
+                        RunProducer(allocator, sizes[i], ops_per_thread, *queues[i / 2], results[i]);
+                    } else {
+                        RunConsumer(allocator, *queues[i / 2], results[i]);
+                    }
+                });
+            }
+        }
+        auto wall_end = steady_clock::now();
+
+        rss.thread.request_stop();
+        rss.thread.join();
+        usz rss_peak = std::max(rss.peak.load(), rss_start);
+
+        return MakeReport(allocator, profile, dist, results,
+            duration_cast<duration<f64>>(wall_end - wall_start).count(),
+            rss_peak - rss_start);
+    }
+}
+
+NOVA_EXAMPLE(AllocatorBench, "alloc")
+{
+    auto usage = [] {
+        NOVA_THROW_STACKLESS("Usage: <num threads> [churn|batch|remote|all] [small|mixed|large|all] [ops per thread]");
+    };
+
+    auto parse_uint = [](nova::StringView str, auto& value) {
+        return std::from_chars(str.Data(), str.Data() + str.Size(), value).ec == std::errc{};
+    };
+
+    u32 num_threads;
+    if (args.empty() || !parse_uint(args[0], num_threads) || num_threads == 0) {
+        usage();
+    }
+
+    std::string_view profile_arg = args.size() > 1 ? std::string_view(args[1]) : "all"sv;
+    std::string_view sizes_arg   = args.size() > 2 ? std::string_view(args[2]) : "mixed"sv;
+
+    u64 ops_per_thread = 10'000'000;
+    if (args.size() > 3 && !parse_uint(args[3], ops_per_thread)) {
+        usage();
+    }
+
+    constexpr std::array Profiles { "churn"sv, "batch"sv, "remote"sv };
+
+    std::vector<BenchReport> reports;
+
+    for (auto profile : Profiles) {
+        if (profile_arg != "all" && profile_arg != profile) continue;
+
+        for (auto& dist : SizeDistributions) {
+            if (sizes_arg != "all" && sizes_arg != dist.name) continue;
+
+            for (auto& allocator : Allocators) {
+                if (auto report = RunProfile(profile, allocator, dist, num_threads, ops_per_thread)) {
+                    reports.emplace_back(std::move(*report));
+                }
+            }
+        }
+    }
+
+    if (reports.empty()) {
+        usage();
+    }
+
+    PrintReports(reports);
+}
\ No newline at end of file
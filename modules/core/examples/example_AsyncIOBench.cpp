@@ -0,0 +1,55 @@
+#include "main/example_Main.hpp"
+
+#include <nova/core/nova_AsyncIO.hpp>
+#include <nova/core/nova_Files.hpp>
+
+using namespace std::chrono;
+
+NOVA_EXAMPLE(AsyncIOBench, "io")
+{
+    // Defaults to the working directory, many small files is the interesting case
+    fs::path root = args.size() > 0 ? fs::path(std::string(args[0].Data(), args[0].Size())) : fs::current_path();
+
+    std::vector<std::string> paths;
+    for (auto& entry : fs::recursive_directory_iterator(root, fs::directory_options::skip_permission_denied)) {
+        if (entry.is_regular_file()) {
+            paths.emplace_back(entry.path().string());
+        }
+    }
+
+    u64 total_bytes = 0;
+    auto start = steady_clock::now();
+    for (auto& path : paths) {
+        total_bytes += nova::files::ReadBinaryFile(path).size();
+    }
+    f64 blocking_time = duration<f64>(steady_clock::now() - start).count();
+
+    nova::Log("\n{} files, {}", paths.size(), nova::ByteSizeToString(total_bytes));
+    nova::Log("  blocking:   {:>8.2f} ms", blocking_time * 1e3);
+
+    nova::JobSystem jobs{ std::thread::hardware_concurrency() };
+
+    for (bool allow_io_uring : { false, true }) {
+        auto queue = nova::io::Queue::Create({ .jobs = &jobs, .allow_io_uring = allow_io_uring });
+        NOVA_DEFER(&) { queue.Destroy(); };
+        if (allow_io_uring && queue.GetBackend() != nova::io::Backend::IoUring) {
+            continue;
+        }
+
+        std::atomic<u64> bytes = 0;
+        std::atomic<u32> failures = 0;
+        start = steady_clock::now();
+        nova::io::ReadFiles(queue, paths, [&](u32, std::vector<char> contents, const nova::io::Completion& result) {
+            if (result.Ok()) {
+                bytes += contents.size();
+            } else {
+                failures++;
+            }
+        });
+        queue.Wait();
+        f64 time = duration<f64>(steady_clock::now() - start).count();
+
+        nova::Log("  {:<11} {:>8.2f} ms ({} failed, {})", nova::Fmt("{}:", nova::io::BackendToString(queue.GetBackend())),
+            time * 1e3, failures.load(), nova::ByteSizeToString(bytes.load()));
+    }
+}
\ No newline at end of file
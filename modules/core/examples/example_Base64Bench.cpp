@@ -0,0 +1,91 @@
+#include "main/example_Main.hpp"
+
+#include <nova/core/nova_Base64.hpp>
+
+namespace
+{
+    struct BenchResult
+    {
+        std::string     backend;
+        std::string_view   mode;
+        f64       encode_gbps;
+        f64       decode_gbps;
+    };
+}
+
+NOVA_EXAMPLE(Base64Bench, "base64")
+{
+    u32 size_mb = 64;
+    u32 iterations = 10;
+    ParseArg(args, 0, size_mb);
+    ParseArg(args, 1, iterations);
+
+    // Incompressible payload, as with embedded texture and mesh data
+    std::vector<b8> input(usz(size_mb) * 1024 * 1024);
+    std::mt19937_64 rng{ 1 };
+    for (usz i = 0; i + 8 <= input.size(); i += 8) {
+        u64 value = rng();
+        std::memcpy(input.data() + i, &value, 8);
+    }
+
+    std::string encoded(nova::base64::EncodedSize(input.size()), '\0');
+    std::vector<b8> decoded(input.size());
+
+    std::vector<BenchResult> results;
+    auto default_backend = nova::base64::GetBackend();
+
+    for (auto backend : { nova::base64::Backend::Scalar, nova::base64::Backend::SSSE3, nova::base64::Backend::AVX2, nova::base64::Backend::Neon }) {
+        if (!nova::base64::IsSupported(backend)) {
+            continue;
+        }
+        nova::base64::SetBackend(backend);
+
+        // Throughput is measured against the binary size in both directions
+        auto& result = results.emplace_back(nova::base64::BackendToString(backend), "one-shot");
+        result.encode_gbps = MeasureGBps(input.size(), iterations, [&] {
+            nova::base64::Encode(encoded.data(), encoded.size(), input.data(), input.size());
+        });
+        result.decode_gbps = MeasureGBps(input.size(), iterations, [&] {
+            nova::base64::Decode(decoded.data(), decoded.size(), encoded.data(), encoded.size());
+        });
+
+        if (decoded != input) {
+            NOVA_THROW("Round trip mismatch with backend {}", result.backend);
+        }
+    }
+
+    nova::base64::SetBackend(default_backend);
+
+    // Streaming in odd sized chunks so that every call carries a partial group
+    {
+        constexpr usz ChunkSize = 64 * 1024 + 1;
+
+        auto& result = results.emplace_back(nova::base64::BackendToString(default_backend), "streamed");
+        result.encode_gbps = MeasureGBps(input.size(), iterations, [&] {
+            nova::base64::Encoder encoder;
+            usz written = 0;
+            for (usz offset = 0; offset < input.size(); offset += ChunkSize) {
+                written += encoder.Update(encoded.data() + written, input.data() + offset, std::min(ChunkSize, input.size() - offset));
+            }
+            encoder.Finish(encoded.data() + written);
+        });
+        result.decode_gbps = MeasureGBps(input.size(), iterations, [&] {
+            nova::base64::Decoder decoder;
+            usz written = 0;
+            for (usz offset = 0; offset < encoded.size(); offset += ChunkSize) {
+                written += decoder.Update(decoded.data() + written, encoded.data() + offset, std::min(ChunkSize, encoded.size() - offset));
+            }
+            decoder.Finish(decoded.data() + written);
+        });
+
+        if (decoded != input) {
+            NOVA_THROW("Streamed round trip mismatch");
+        }
+    }
+
+    nova::Log("\nPayload: {}, {} iterations", nova::ByteSizeToString(input.size()), iterations);
+    nova::Log("{:<8} {:<10} {:>12} {:>12}", "backend", "mode", "encode GB/s", "decode GB/s");
+    for (auto& result : results) {
+        nova::Log("{:<8} {:<10} {:>12.2f} {:>12.2f}", result.backend, result.mode, result.encode_gbps, result.decode_gbps);
+    }
+}
\ No newline at end of file
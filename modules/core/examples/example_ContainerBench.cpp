@@ -0,0 +1,198 @@
+#include "main/example_Main.hpp"
+
+#include <nova/core/nova_SmallVector.hpp>
+
+using namespace std::chrono;
+
+namespace
+{
+    // Synthetic inputs shaped after the indexer (many short paths and tokens) and bldr
+    // (per-file include lists, compiler defines) workloads.
+
+    struct Corpus
+    {
+        std::vector<std::string>          paths;
+        std::vector<std::string>         tokens;
+        std::vector<u32>          include_counts;
+    };
+
+    Corpus GenerateCorpus(u32 count)
+    {
+        constexpr std::array Dirs  { "src", "nova", "core", "rhi", "vulkan", "build", "vendor", "include", "detail" };
+        constexpr std::array Stems { "Core", "JobSystem", "VulkanImage", "Pool", "Files", "Timer", "Base64", "Json" };
+        constexpr std::array Exts  { ".hpp", ".cpp", ".inl", ".h" };
+
+        std::mt19937 rng{ 1 };
+        auto pick = [&](const auto& array) { return array[std::uniform_int_distribution<usz>(0, array.size() - 1)(rng)]; };
+
+        Corpus corpus;
+        corpus.paths.reserve(count);
+        corpus.tokens.reserve(count);
+        corpus.include_counts.reserve(count);
+
+        // Most headers include a handful of files, a few include dozens
+        std::geometric_distribution<u32> include_dist{ 0.15 };
+        std::uniform_int_distribution<u32> token_len{ 2, 24 };
+        std::uniform_int_distribution<u32> depth_dist{ 1, 4 };
+
+        for (u32 i = 0; i < count; ++i) {
+            std::string path;
+            for (u32 d = depth_dist(rng); d > 0; --d) {
+                path.append(pick(Dirs)).push_back('/');
+            }
+            path.append("nova_").append(pick(Stems)).append(pick(Exts));
+            corpus.paths.emplace_back(std::move(path));
+
+            std::string token(token_len(rng), 'a');
+            for (auto& c : token) c = char('a' + rng() % 26);
+            corpus.tokens.emplace_back(std::move(token));
+
+            corpus.include_counts.push_back(include_dist(rng));
+        }
+
+        return corpus;
+    }
+
+// -----------------------------------------------------------------------------
+
+    struct BenchResult
+    {
+        std::string_view workload;
+        std::string_view container;
+        f64          ns_per_item;
+    };
+
+    template<typename Fn>
+    BenchResult Measure(std::string_view workload, std::string_view container, u32 items, u32 iterations, Fn&& fn)
+    {
+        return { workload, container, duration<f64, std::nano>(MeasureMean(iterations, fn)).count() / f64(items) };
+    }
+
+    // Prevents the optimizer from discarding benchmark results
+    volatile usz Sink;
+
+// -----------------------------------------------------------------------------
+
+    template<typename String>
+    usz BuildTokens(const Corpus& corpus)
+    {
+        std::vector<String> out;
+        out.reserve(corpus.tokens.size());
+        for (auto& token : corpus.tokens) {
+            out.emplace_back(token);
+        }
+
+        usz total = 0;
+        for (auto& token : out) {
+            total += std::string_view(token).size();
+        }
+        return total;
+    }
+
+    template<typename String>
+    usz BuildPaths(const Corpus& corpus)
+    {
+        usz total = 0;
+        for (auto& path : corpus.paths) {
+            // Normalize separators as the indexer/bldr do when keying file caches
+            String normalized{ std::string_view(path) };
+            for (auto& c : normalized) {
+                if (c == '/') c = '\\';
+            }
+            total += std::string_view(normalized).size();
+        }
+        return total;
+    }
+
+    struct IncludeDep
+    {
+        std::string_view name;
+        bool            local;
+    };
+
+    template<typename Includes>
+    usz BuildIncludeLists(const Corpus& corpus)
+    {
+        std::vector<Includes> files(corpus.paths.size());
+        for (usz i = 0; i < files.size(); ++i) {
+            auto& includes = files[i];
+            for (u32 j = 0; j < corpus.include_counts[i]; ++j) {
+                includes.emplace_back(corpus.paths[(i + j + 1) % corpus.paths.size()], (j & 1) != 0);
+            }
+        }
+
+        usz total = 0;
+        for (auto& includes : files) {
+            for (auto& dep : includes) {
+                total += dep.name.size() + dep.local;
+            }
+        }
+        return total;
+    }
+
+    template<typename String>
+    usz BuildDefines(const Corpus& corpus)
+    {
+        struct Define { String key; String value; };
+
+        std::vector<Define> defines;
+        defines.reserve(corpus.tokens.size());
+        for (usz i = 0; i < corpus.tokens.size(); ++i) {
+            auto& token = corpus.tokens[i];
+            defines.emplace_back(String(token), String(std::string_view(token).substr(0, token.size() / 2)));
+        }
+        return defines.size();
+    }
+
+    template<typename Signals>
+    usz BuildSignalLists(u32 count)
+    {
+        static u32 barriers[4];
+
+        usz total = 0;
+        for (u32 i = 0; i < count; ++i) {
+            Signals signals;
+            signals.push_back(&barriers[i & 3]);
+            if ((i & 7) == 0) signals.push_back(&barriers[(i + 1) & 3]);
+            for (auto* signal : signals) {
+                total += usz(signal - barriers);
+            }
+        }
+        return total;
+    }
+}
+
+NOVA_EXAMPLE(ContainerBench, "containers")
+{
+    u32 count = 100'000;
+    u32 iterations = 20;
+    ParseArg(args, 0, count);
+    ParseArg(args, 1, iterations);
+
+    auto corpus = GenerateCorpus(count);
+
+    std::vector<BenchResult> results;
+    auto run = [&](std::string_view workload, std::string_view container, auto&& fn) {
+        results.emplace_back(Measure(workload, container, count, iterations, [&] { Sink = fn(); }));
+    };
+
+    run("tokens", "std::string",         [&] { return BuildTokens<std::string>(corpus);           });
+    run("tokens", "InlineString<24>",    [&] { return BuildTokens<nova::InlineString<24>>(corpus); });
+
+    run("paths",  "std::string",         [&] { return BuildPaths<std::string>(corpus);            });
+    run("paths",  "InlineString<64>",    [&] { return BuildPaths<nova::InlineString<64>>(corpus);  });
+
+    run("includes", "std::vector",       [&] { return BuildIncludeLists<std::vector<IncludeDep>>(corpus);          });
+    run("includes", "SmallVector<8>",    [&] { return BuildIncludeLists<nova::SmallVector<IncludeDep, 8>>(corpus);  });
+
+    run("defines", "std::string",        [&] { return BuildDefines<std::string>(corpus);           });
+    run("defines", "InlineString<24>",   [&] { return BuildDefines<nova::InlineString<24>>(corpus); });
+
+    run("signals", "std::vector",        [&] { return BuildSignalLists<std::vector<u32*>>(count);         });
+    run("signals", "SmallVector<2>",     [&] { return BuildSignalLists<nova::SmallVector<u32*, 2>>(count); });
+
+    nova::Log("\n{:<10} {:<18} {:>10}", "workload", "container", "ns/item");
+    for (auto& result : results) {
+        nova::Log("{:<10} {:<18} {:>10.2f}", result.workload, result.container, result.ns_per_item);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "main/example_Main.hpp"
+
+#include <nova/core/nova_Hash.hpp>
+
+NOVA_EXAMPLE(HashBench, "hash")
+{
+    u32 size_mb = 256;
+    u32 iterations = 10;
+    ParseArg(args, 0, size_mb);
+    ParseArg(args, 1, iterations);
+
+    std::vector<b8> input(usz(size_mb) * 1024 * 1024);
+    std::mt19937_64 rng{ 1 };
+    for (usz i = 0; i + 8 <= input.size(); i += 8) {
+        u64 value = rng();
+        std::memcpy(input.data() + i, &value, 8);
+    }
+
+    nova::Log("\nPayload: {}, {} iterations", nova::ByteSizeToString(input.size()), iterations);
+    nova::Log("{:<8} {:<10} {:>8}", "backend", "mode", "GB/s");
+
+    auto default_backend = nova::hash::GetBackend();
+    auto expected = nova::hash::Hash128(input.data(), input.size());
+
+    for (auto backend : { nova::hash::Backend::Scalar, nova::hash::Backend::SSE2, nova::hash::Backend::AVX2, nova::hash::Backend::Neon }) {
+        if (!nova::hash::IsSupported(backend)) {
+            continue;
+        }
+        nova::hash::SetBackend(backend);
+
+        nova::hash::Digest digest;
+        f64 gbps = MeasureGBps(input.size(), iterations, [&] {
+            digest = nova::hash::Hash128(input.data(), input.size());
+        });
+        if (digest != expected) {
+            NOVA_THROW("Digest mismatch with backend {}", nova::hash::BackendToString(backend));
+        }
+        nova::Log("{:<8} {:<10} {:>8.2f}", nova::hash::BackendToString(backend), "one-shot", gbps);
+    }
+
+    nova::hash::SetBackend(default_backend);
+
+    // Odd sized updates so that every call straddles a stripe
+    {
+        constexpr usz ChunkSize = 64 * 1024 + 1;
+
+        nova::hash::Digest digest;
+        f64 gbps = MeasureGBps(input.size(), iterations, [&] {
+            nova::hash::Hasher hasher;
+            for (usz offset = 0; offset < input.size(); offset += ChunkSize) {
+                hasher.Update(input.data() + offset, std::min(ChunkSize, input.size() - offset));
+            }
+            digest = hasher.Digest128();
+        });
+        if (digest != expected) {
+            NOVA_THROW("Streamed digest mismatch");
+        }
+        nova::Log("{:<8} {:<10} {:>8.2f}", nova::hash::BackendToString(default_backend), "streamed", gbps);
+    }
+
+    {
+        f64 gbps = MeasureGBps(input.size(), iterations, [&] {
+            nova::hash::HashParallel(input.data(), input.size());
+        });
+        nova::Log("{:<8} {:<10} {:>8.2f}", nova::hash::BackendToString(default_backend), "parallel", gbps);
+    }
+
+    // Small key hash for comparison
+    {
+        f64 gbps = MeasureGBps(input.size(), iterations, [&] {
+            nova::hash::Hash(input.data(), input.size());
+        });
+        nova::Log("{:<8} {:<10} {:>8.2f}", "wyhash", "one-shot", gbps);
+    }
+}
\ No newline at end of file
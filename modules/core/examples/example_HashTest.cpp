@@ -0,0 +1,109 @@
+#include "main/example_Main.hpp"
+
+#include <nova/core/nova_Hash.hpp>
+
+namespace
+{
+    struct KnownAnswer
+    {
+        usz                   size;
+        u64                   seed;
+        u64                 hash64;
+        nova::hash::Digest hash128;
+    };
+
+    // XXH3_64bits_withSeed and XXH3_128bits_withSeed of the xxhsum sanity buffer, from the
+    // reference implementation (libxxhash 0.8.1). Sizes cover each length class: 0, 1-3,
+    // 4-8, 9-16, 17-128, 129-240 and long inputs over one or more 1024 byte blocks.
+    constexpr KnownAnswer KnownAnswers[] {
+        {      0, 0x0000000000000000, 0x2D06800538D394C2, { 0x6001C324468D497F, 0x99AA06D3014798D8 } },
+        {      1, 0x0000000000000000, 0xC44BDFF4074EECDB, { 0xC44BDFF4074EECDB, 0xA6CD5E9392000F6A } },
+        {      3, 0x0000000000000000, 0x54247382A8D6B94D, { 0x54247382A8D6B94D, 0x20EFC49FF02422EA } },
+        {      4, 0x0000000000000000, 0xE5DC74BC51848A51, { 0x2E7D8D6876A39FE9, 0x970D585AC632BF8E } },
+        {      8, 0x0000000000000000, 0x24CCC9ACAA9F65E4, { 0x64C69CAB4BB21DC5, 0x47A7F080D82BB456 } },
+        {      9, 0x0000000000000000, 0x14D5001C15DD3F2B, { 0xED7CCBC501EB7501, 0x564EF6078950D457 } },
+        {     16, 0x0000000000000000, 0x981B17D36C7498C9, { 0x562980258A998629, 0xC68C368ECF8A9C05 } },
+        {     17, 0x0000000000000000, 0x796F5ACD3A60F862, { 0xABBC12D11973D7DB, 0x955FA78643ED3669 } },
+        {    128, 0x0000000000000000, 0xFCFF24126754D861, { 0xEBB15E34A7FB5AB1, 0x39992220E045260A } },
+        {    129, 0x0000000000000000, 0x98F1B0A679A2CA29, { 0x86C9E3BC8F0A3B5C, 0x03815FC91F1B30B6 } },
+        {    240, 0x0000000000000000, 0x81C3C2B67F568CCF, { 0x5C9AAE94C8EBE5A0, 0xAA4202DAA2769DC8 } },
+        {    241, 0x0000000000000000, 0xC5A639ECD2030E5E, { 0xC5A639ECD2030E5E, 0x99A80ECF0ECFC647 } },
+        {   1024, 0x0000000000000000, 0xDD85C9B5C1109C5C, { 0xDD85C9B5C1109C5C, 0x0D30D24071C64C57 } },
+        {   1025, 0x0000000000000000, 0xD870C0FA13211C6A, { 0xD870C0FA13211C6A, 0xFD3EE4FE7F2954C6 } },
+        {   4113, 0x0000000000000000, 0x01F24DFB53ED6D89, { 0x01F24DFB53ED6D89, 0x83C02DCC7A806596 } },
+        { 100000, 0x0000000000000000, 0x34D658192A014311, { 0x34D658192A014311, 0x351330331BC078FB } },
+        {      0, 0x9E3779B185EBCA8D, 0xA8A6B918B2F0364A, { 0xA986DFC5D7605BFE, 0x00FEAA732A3CE25E } },
+        {      1, 0x9E3779B185EBCA8D, 0x032BE332DD766EF8, { 0x032BE332DD766EF8, 0x20E49ABCC53B3842 } },
+        {      3, 0x9E3779B185EBCA8D, 0x634B8990B4976373, { 0x634B8990B4976373, 0x1C7ECF6A308CF00E } },
+        {      4, 0x9E3779B185EBCA8D, 0xAA2E7ECCB0C8F747, { 0xBFAF51F1E67E0B0F, 0x3D53E5DFD837D927 } },
+        {      8, 0x9E3779B185EBCA8D, 0x8F973410999B8F6B, { 0x7B29471DC729B5FF, 0xF50CEC145BCD5C5A } },
+        {      9, 0x9E3779B185EBCA8D, 0xB3AE7333D9013F60, { 0xAEF5DFC0AC9F9044, 0x6B380B43FFA61042 } },
+        {     16, 0x9E3779B185EBCA8D, 0x663F29333B4DB6B1, { 0x0346D13A7A5498C7, 0x6FFCB80CD33085C8 } },
+        {     17, 0x9E3779B185EBCA8D, 0xF3EC5067F4306DB3, { 0x980A14119985A7DF, 0xD77681219E464828 } },
+        {    128, 0x9E3779B185EBCA8D, 0x73FDE75280646649, { 0x8394F5C51F1D8246, 0xA0F7CCB68EE02ADD } },
+        {    129, 0x9E3779B185EBCA8D, 0x21FFFDBCA099C844, { 0xD4AAE26FCEC7DC03, 0xAD559266067C0BF3 } },
+        {    240, 0x9E3779B185EBCA8D, 0xCC0F58C27EF3D8EE, { 0x604E98DB085C1864, 0x29D2133D6EA58C5B } },
+        {    241, 0x9E3779B185EBCA8D, 0xDDA9B0A161D4829A, { 0xDDA9B0A161D4829A, 0xEC64AFAE6A137582 } },
+        {   1024, 0x9E3779B185EBCA8D, 0xEF368A8A2EBABAEF, { 0xEF368A8A2EBABAEF, 0x17600EFE2B493A18 } },
+        {   1025, 0x9E3779B185EBCA8D, 0x96792BCF9AF88519, { 0x96792BCF9AF88519, 0x2C383949F57BF7E1 } },
+        {   4113, 0x9E3779B185EBCA8D, 0x3912A517D7CB58BE, { 0x3912A517D7CB58BE, 0xE3BB5D1F48B74DC6 } },
+        { 100000, 0x9E3779B185EBCA8D, 0x0682260A8A5AFE82, { 0x0682260A8A5AFE82, 0x5A7AE76762E52B20 } },
+    };
+
+    // Same generator as xxhsum's sanity check
+    std::vector<b8> GenerateSanityBuffer(usz size)
+    {
+        std::vector<b8> buffer(size);
+        u64 generator = 2654435761u;
+        for (auto& byte : buffer) {
+            byte = b8(generator >> 56);
+            generator *= 11400714785074694797ull;
+        }
+        return buffer;
+    }
+}
+
+NOVA_EXAMPLE(HashTest, "hash-test")
+{
+    auto buffer = GenerateSanityBuffer(std::ranges::max(KnownAnswers, {}, &KnownAnswer::size).size);
+
+    u32 failures = 0;
+    auto check = [&](bool ok, std::string_view mode, const KnownAnswer& answer) {
+        if (!ok) {
+            nova::Log("FAILED {} {} - size = {}, seed = {:#x}",
+                nova::hash::BackendToString(nova::hash::GetBackend()), mode, answer.size, answer.seed);
+            failures++;
+        }
+    };
+
+    auto default_backend = nova::hash::GetBackend();
+    NOVA_DEFER(&) { nova::hash::SetBackend(default_backend); };
+
+    for (auto backend : { nova::hash::Backend::Scalar, nova::hash::Backend::SSE2, nova::hash::Backend::AVX2, nova::hash::Backend::Neon }) {
+        if (!nova::hash::IsSupported(backend)) {
+            continue;
+        }
+        nova::hash::SetBackend(backend);
+
+        for (auto& answer : KnownAnswers) {
+            check(nova::hash::Hash64(buffer.data(), answer.size, answer.seed) == answer.hash64, "Hash64", answer);
+            check(nova::hash::Hash128(buffer.data(), answer.size, answer.seed) == answer.hash128, "Hash128", answer);
+
+            // Splits on either side of the 64 byte stripe and 256 byte internal buffer
+            for (usz split : { 1, 63, 64, 255, 257, 1025 }) {
+                nova::hash::Hasher hasher{ answer.seed };
+                for (usz offset = 0; offset < answer.size; offset += split) {
+                    hasher.Update(buffer.data() + offset, std::min(split, answer.size - offset));
+                }
+                check(hasher.Digest64() == answer.hash64, "Hasher::Digest64", answer);
+                check(hasher.Digest128() == answer.hash128, "Hasher::Digest128", answer);
+            }
+        }
+    }
+
+    if (failures) {
+        NOVA_THROW("{} XXH3 known answer checks failed", failures);
+    }
+
+    nova::Log("All {} XXH3 known answers match", std::size(KnownAnswers));
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "main/example_Main.hpp"
+
+#include <nova/core/nova_JsonReader.hpp>
+#include <nova/core/nova_JsonWriter.hpp>
+
+using namespace std::chrono;
+
+NOVA_EXAMPLE(JsonBench, "json")
+{
+    u32 entries = 1'000'000;
+    u32 iterations = 5;
+    ParseArg(args, 0, entries);
+    ParseArg(args, 1, iterations);
+
+    // Shaped like an index manifest: mostly short paths, sizes and hashes
+    auto write = [&] {
+        std::mt19937_64 rng{ 1 };
+        nova::JsonWriter json;
+        json.pretty = false;
+        json.Object();
+        json["version"] = 1;
+        json["files"].Array();
+        for (u32 i = 0; i < entries; ++i) {
+            json.Object();
+            json["path"] = nova::Fmt("C:\\data\\assets\\mesh_{}.bin", i);
+            json["size"] = u32(rng() % (1 << 24));
+            json["hash"] = rng();
+            json["weight"] = f64(i) / 7.0;
+            json["tags"].Array();
+            json << "static";
+            json << (i % 3 == 0);
+            json.EndArray();
+            json.EndObject();
+        }
+        json.EndArray();
+        json.EndObject();
+        return json.Take();
+    };
+
+    std::string text = write();
+
+    auto start = steady_clock::now();
+    for (u32 i = 0; i < iterations; ++i) {
+        write();
+    }
+    f64 write_time = duration<f64>(steady_clock::now() - start).count() / iterations;
+
+    nova::JsonDocument document;
+    start = steady_clock::now();
+    for (u32 i = 0; i < iterations; ++i) {
+        document = nova::JsonDocument::Parse(text);
+    }
+    f64 read_time = duration<f64>(steady_clock::now() - start).count() / iterations;
+
+    // Spot check that values survive the round trip
+    std::mt19937_64 rng{ 1 };
+    auto& files = document.Root()["files"];
+    for (u32 i = 0; i < entries; ++i) {
+        auto& entry = files[i];
+        u64 size = rng() % (1 << 24);
+        u64 hash = rng();
+        if (entry["path"].AsString() != nova::Fmt("C:\\data\\assets\\mesh_{}.bin", i)
+                || entry["size"].AsU64() != size
+                || entry["hash"].AsU64() != hash
+                || entry["weight"].AsF64() != f64(i) / 7.0
+                || entry["tags"][1].AsBool() != (i % 3 == 0)) {
+            NOVA_THROW("Round trip mismatch at entry {}", i);
+        }
+    }
+
+    nova::Log("\nDocument: {}, {} entries, {} iterations", nova::ByteSizeToString(text.size()), entries, iterations);
+    nova::Log("  write: {:>8.2f} ms {:>6.2f} GB/s", write_time * 1e3, f64(text.size()) / write_time / 1e9);
+    nova::Log("  read:  {:>8.2f} ms {:>6.2f} GB/s ({} DOM)", read_time * 1e3, f64(text.size()) / read_time / 1e9,
+        nova::ByteSizeToString(document.MemoryUsed()));
+}
\ No newline at end of file
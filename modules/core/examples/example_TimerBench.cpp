@@ -0,0 +1,95 @@
+#include "main/example_Main.hpp"
+
+#include <nova/core/nova_Timer.hpp>
+
+using namespace std::chrono;
+
+namespace
+{
+    struct JitterStats
+    {
+        f64  p50 = 0;
+        f64  p99 = 0;
+        f64  max = 0;
+        f64  cpu = 0;
+    };
+
+    // Measures wakeup lateness against fixed frame boundaries in microseconds, and the
+    // fraction of a core used while waiting.
+    template<typename Fn>
+    JitterStats Measure(nanoseconds interval, u32 frames, Fn&& wait_until)
+    {
+        std::vector<f64> late;
+        late.reserve(frames);
+
+        auto cpu_start = nova::env::GetThreadCpuTime();
+        auto start = steady_clock::now();
+        auto next = start;
+        for (u32 i = 0; i < frames; ++i) {
+            next += interval;
+            wait_until(next);
+            late.push_back(duration<f64, std::micro>(steady_clock::now() - next).count());
+        }
+        auto elapsed = steady_clock::now() - start;
+        auto cpu = nova::env::GetThreadCpuTime() - cpu_start;
+
+        std::ranges::sort(late);
+        return {
+            .p50 = late[late.size() / 2],
+            .p99 = late[std::min(late.size() - 1, late.size() * 99 / 100)],
+            .max = late.back(),
+            .cpu = duration<f64>(cpu).count() / duration<f64>(elapsed).count(),
+        };
+    }
+
+    void Report(std::string_view method, nanoseconds interval, const JitterStats& stats)
+    {
+        nova::Log("{:<12} {:>8.3f} {:>10.1f} {:>10.1f} {:>10.1f} {:>7.1f}%",
+            method, duration<f64, std::milli>(interval).count(), stats.p50, stats.p99, stats.max, stats.cpu * 100.0);
+    }
+}
+
+NOVA_EXAMPLE(TimerBench, "timer")
+{
+    u32 frames = 500;
+    ParseArg(args, 0, frames);
+
+    nova::Log("\nFrames per interval: {}", frames);
+    nova::Log("{:<12} {:>8} {:>10} {:>10} {:>10} {:>8}", "method", "ms", "p50 us", "p99 us", "max us", "cpu");
+
+    nova::Timer timer;
+
+    for (nanoseconds interval : { nanoseconds(1ms), nanoseconds(4ms), nanoseconds(16'666'667ns) }) {
+        Report("sleep_until", interval, Measure(interval, frames, [](auto deadline) {
+            std::this_thread::sleep_until(deadline);
+        }));
+
+        Report("Timer", interval, Measure(interval, frames, [&](auto deadline) {
+            timer.WaitUntil(deadline);
+        }));
+    }
+
+    nova::Log("Timer spin margin: {:.1f} us", duration<f64, std::micro>(timer.GetSpinMargin()).count());
+
+    // Interrupting a paced loop from another thread
+    {
+        nova::FramePacer pacer{ 16'666'667ns };
+        u32 interrupted = 0;
+
+        std::jthread interrupter{ [&](std::stop_token token) {
+            while (!token.stop_requested()) {
+                std::this_thread::sleep_for(50ms);
+                pacer.Interrupt();
+            }
+        }};
+
+        auto start = steady_clock::now();
+        while (steady_clock::now() - start < 1s) {
+            if (!pacer.WaitForNextFrame()) {
+                interrupted++;
+            }
+        }
+
+        nova::Log("FramePacer: {} frames, {} missed, {} interrupted in 1s", pacer.GetFrameCount(), pacer.GetMissedFrames(), interrupted);
+    }
+}
\ No newline at end of file
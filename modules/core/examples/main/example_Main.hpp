@@ -1,5 +1,7 @@
 #include <nova/core/nova_Core.hpp>
 
+#include <charconv>
+
 using namespace nova::types;
 
 using ExampleEntryFnPtr = void(*)(nova::Span<nova::StringView>);
@@ -17,3 +19,37 @@ std::monostate RegisterExample(nova::StringView, ExampleEntryFnPtr fn);
     void example_##name(nova::Span<nova::StringView> args); \
     static auto example_##name##_state = RegisterExample(strName, example_##name); \
     void example_##name([[maybe_unused]] nova::Span<nova::StringView> args)
+
+// -----------------------------------------------------------------------------
+//                             Benchmark helpers
+// -----------------------------------------------------------------------------
+
+// Parses the numeric argument at index into value, left unchanged if missing or malformed
+template<typename T>
+void ParseArg(nova::Span<nova::StringView> args, usz index, T& value)
+{
+    if (args.size() > index) {
+        std::from_chars(args[index].Data(), args[index].Data() + args[index].Size(), value);
+    }
+}
+
+// Mean wall time per call of fn over iterations, after one untimed warm-up call
+template<typename Fn>
+std::chrono::duration<f64> MeasureMean(u32 iterations, Fn&& fn)
+{
+    fn();
+
+    auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < iterations; ++i) {
+        fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<f64>(end - start) / iterations;
+}
+
+template<typename Fn>
+f64 MeasureGBps(usz bytes, u32 iterations, Fn&& fn)
+{
+    return f64(bytes) / MeasureMean(iterations, fn).count() / 1e9;
+}
@@ -0,0 +1,379 @@
+#include <nova/core/nova_AsyncIO.hpp>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// -----------------------------------------------------------------------------
+//                              Blocking fallback
+// -----------------------------------------------------------------------------
+
+namespace nova::io::detail
+{
+    namespace
+    {
+        int ToOpenFlags(OpenFlags flags)
+        {
+            int result = O_CLOEXEC;
+            if (flags >= (OpenFlags::Read | OpenFlags::Write)) result |= O_RDWR;
+            else if (flags >= OpenFlags::Write)                result |= O_WRONLY;
+            else                                               result |= O_RDONLY;
+            if (flags >= OpenFlags::Create)   result |= O_CREAT;
+            if (flags >= OpenFlags::Truncate) result |= O_TRUNC;
+            return result;
+        }
+
+        // Single reads and writes are capped at just under 2GiB
+        constexpr u64 MaxTransfer = 0x7fff'f000;
+
+        void SetResult(Completion& result, i64 value)
+        {
+            if (value < 0) {
+                result.error = errno;
+            } else {
+                result.result = value;
+            }
+        }
+    }
+
+    void Execute(Operation& op)
+    {
+        auto& request = op.request;
+        auto& result = op.result;
+
+        switch (request.type) {
+            break;case OpType::Open:
+                SetResult(result, ::open(request.path.c_str(), ToOpenFlags(request.flags), 0644));
+            break;case OpType::Close:
+                SetResult(result, ::close(int(request.file)));
+            break;case OpType::Read:
+                SetResult(result, ::pread(int(request.file), request.buffer, std::min(request.size, MaxTransfer), off_t(request.offset)));
+            break;case OpType::Write:
+                SetResult(result, ::pwrite(int(request.file), request.buffer, std::min(request.size, MaxTransfer), off_t(request.offset)));
+            break;case OpType::Stat: {
+                struct stat st;
+                SetResult(result, ::stat(request.path.c_str(), &st));
+                if (result.Ok()) {
+                    request.stat->size = u64(st.st_size);
+                    request.stat->last_write_ns = i64(st.st_mtim.tv_sec) * 1'000'000'000 + st.st_mtim.tv_nsec;
+                    request.stat->is_directory = S_ISDIR(st.st_mode);
+                }
+            }
+        }
+    }
+
+// -----------------------------------------------------------------------------
+//                                  io_uring
+// -----------------------------------------------------------------------------
+
+    namespace
+    {
+        int SysSetup(u32 entries, io_uring_params* params)
+        {
+            return int(::syscall(__NR_io_uring_setup, entries, params));
+        }
+
+        int SysEnter(int fd, u32 to_submit, u32 min_complete, u32 flags)
+        {
+            return int(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+        }
+
+        int SysRegister(int fd, u32 opcode, void* arg, u32 count)
+        {
+            return int(::syscall(__NR_io_uring_register, fd, opcode, arg, count));
+        }
+
+        // Stat completions land in a statx buffer that must outlive the submission
+        struct StatOperation
+        {
+            Operation*        op;
+            struct statx  buffer;
+        };
+
+        // user_data tags. Operations are at least 8 byte aligned
+        constexpr u64 WakeTag = 0;
+        constexpr u64 StatTag = 1;
+    }
+
+    struct RingBackend
+    {
+        Queue::Impl* queue = nullptr;
+        int             fd = -1;
+
+        void*     sq_ring = nullptr;
+        usz  sq_ring_size = 0;
+        void*     cq_ring = nullptr;
+        usz  cq_ring_size = 0;
+        io_uring_sqe* sqes = nullptr;
+        usz     sqes_size = 0;
+
+        std::atomic<u32>* sq_head;
+        std::atomic<u32>* sq_tail;
+        u32               sq_mask;
+        u32*             sq_array;
+        u32            sq_entries;
+
+        std::atomic<u32>* cq_head;
+        std::atomic<u32>* cq_tail;
+        u32               cq_mask;
+        io_uring_cqe*        cqes;
+
+        // Guards the submission ring and backlog. Completions are only reaped by the
+        // completion thread and need no lock.
+        std::mutex              mutex;
+        std::deque<Operation*> backlog;
+        u32                  in_flight = 0;
+        bool                  stopping = false;
+
+        std::thread completion_thread;
+
+    public:
+        ~RingBackend()
+        {
+            if (sqes)                         ::munmap(sqes, sqes_size);
+            if (cq_ring && cq_ring != sq_ring) ::munmap(cq_ring, cq_ring_size);
+            if (sq_ring)                      ::munmap(sq_ring, sq_ring_size);
+            if (fd >= 0)                      ::close(fd);
+        }
+
+        // Requires the lock. Returns false if the ring is full
+        bool Prepare(Operation* op)
+        {
+            u32 tail = sq_tail->load(std::memory_order_relaxed);
+            if (in_flight >= sq_entries || tail - sq_head->load(std::memory_order_acquire) >= sq_entries) {
+                return false;
+            }
+
+            auto& request = op->request;
+            io_uring_sqe* sqe = &sqes[tail & sq_mask];
+            std::memset(sqe, 0, sizeof(*sqe));
+            sqe->user_data = u64(op);
+
+            switch (request.type) {
+                break;case OpType::Open:
+                    sqe->opcode = IORING_OP_OPENAT;
+                    sqe->fd = AT_FDCWD;
+                    sqe->addr = u64(request.path.c_str());
+                    sqe->len = 0644;
+                    sqe->open_flags = u32(ToOpenFlags(request.flags));
+                break;case OpType::Close:
+                    sqe->opcode = IORING_OP_CLOSE;
+                    sqe->fd = i32(request.file);
+                break;case OpType::Read:
+                case OpType::Write:
+                    sqe->opcode = request.type == OpType::Read ? IORING_OP_READ : IORING_OP_WRITE;
+                    sqe->fd = i32(request.file);
+                    sqe->addr = u64(request.buffer);
+                    sqe->len = u32(std::min(request.size, MaxTransfer));
+                    sqe->off = request.offset;
+                break;case OpType::Stat: {
+                    auto* stat = new StatOperation{ op };
+                    sqe->opcode = IORING_OP_STATX;
+                    sqe->fd = AT_FDCWD;
+                    sqe->addr = u64(request.path.c_str());
+                    sqe->len = STATX_TYPE | STATX_SIZE | STATX_MTIME;
+                    sqe->off = u64(&stat->buffer);
+                    sqe->user_data = u64(stat) | StatTag;
+                }
+            }
+
+            sq_array[tail & sq_mask] = tail & sq_mask;
+            sq_tail->store(tail + 1, std::memory_order_release);
+            in_flight++;
+            return true;
+        }
+
+        // Requires the lock
+        void Enter(u32 count)
+        {
+            while (count > 0) {
+                int submitted = SysEnter(fd, count, 0, 0);
+                if (submitted < 0) {
+                    if (errno == EINTR || errno == EAGAIN) {
+                        continue;
+                    }
+                    NOVA_THROW("io_uring_enter failed: {}", std::system_category().message(errno));
+                }
+                count -= u32(submitted);
+            }
+        }
+
+        // Requires the lock. Moves backlog into free submission slots
+        void Drain()
+        {
+            u32 count = 0;
+            while (!backlog.empty() && Prepare(backlog.front())) {
+                backlog.pop_front();
+                count++;
+            }
+            Enter(count);
+        }
+
+        void CompletionLoop()
+        {
+            NOVA_PROFILE_THREAD("I/O Completions");
+
+            std::vector<Operation*> completed;
+            for (;;) {
+                if (SysEnter(fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                    NOVA_THROW("io_uring_enter failed: {}", std::system_category().message(errno));
+                }
+
+                bool wake = false;
+                u32 head = cq_head->load(std::memory_order_relaxed);
+                u32 tail = cq_tail->load(std::memory_order_acquire);
+                for (; head != tail; ++head) {
+                    const io_uring_cqe& cqe = cqes[head & cq_mask];
+                    if (cqe.user_data == WakeTag) {
+                        wake = true;
+                        continue;
+                    }
+
+                    Operation* op;
+                    if (cqe.user_data & StatTag) {
+                        auto* stat = reinterpret_cast<StatOperation*>(cqe.user_data & ~StatTag);
+                        op = stat->op;
+                        if (cqe.res >= 0) {
+                            op->request.stat->size = stat->buffer.stx_size;
+                            op->request.stat->last_write_ns = i64(stat->buffer.stx_mtime.tv_sec) * 1'000'000'000 + stat->buffer.stx_mtime.tv_nsec;
+                            op->request.stat->is_directory = S_ISDIR(stat->buffer.stx_mode);
+                        }
+                        delete stat;
+                    } else {
+                        op = reinterpret_cast<Operation*>(cqe.user_data);
+                    }
+
+                    if (cqe.res < 0) {
+                        op->result.error = -cqe.res;
+                    } else {
+                        op->result.result = cqe.res;
+                    }
+                    completed.push_back(op);
+                }
+                cq_head->store(head, std::memory_order_release);
+
+                {
+                    std::scoped_lock lock{ mutex };
+                    in_flight -= u32(completed.size());
+                    Drain();
+                    if (wake && stopping) {
+                        return;
+                    }
+                }
+
+                for (auto* op : completed) {
+                    Complete(queue, op);
+                }
+                completed.clear();
+            }
+        }
+    };
+
+    RingBackend* CreateRing(Queue::Impl* queue, u32 depth)
+    {
+        auto ring = std::make_unique<RingBackend>();
+        ring->queue = queue;
+
+        io_uring_params params = {};
+        ring->fd = SysSetup(depth, &params);
+        if (ring->fd < 0) {
+            return nullptr;
+        }
+
+        // Every operation the queue uses must be supported (Linux 5.6+)
+        {
+            constexpr u32 ProbeOps = 256;
+            auto probe_storage = std::make_unique<b8[]>(sizeof(io_uring_probe) + ProbeOps * sizeof(io_uring_probe_op));
+            auto* probe = new (probe_storage.get()) io_uring_probe{};
+            if (SysRegister(ring->fd, IORING_REGISTER_PROBE, probe, ProbeOps) < 0) {
+                return nullptr;
+            }
+            for (u32 opcode : { IORING_OP_OPENAT, IORING_OP_CLOSE, IORING_OP_READ, IORING_OP_WRITE, IORING_OP_STATX, IORING_OP_NOP }) {
+                if (opcode > probe->last_op || !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED)) {
+                    return nullptr;
+                }
+            }
+        }
+
+        ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+        ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP) {
+            ring->sq_ring_size = ring->cq_ring_size = std::max(ring->sq_ring_size, ring->cq_ring_size);
+        }
+
+        auto map = [&](usz size, off_t offset) -> void* {
+            void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, offset);
+            return ptr == MAP_FAILED ? nullptr : ptr;
+        };
+
+        ring->sq_ring = map(ring->sq_ring_size, IORING_OFF_SQ_RING);
+        if (!ring->sq_ring) {
+            return nullptr;
+        }
+        ring->cq_ring = (params.features & IORING_FEAT_SINGLE_MMAP) ? ring->sq_ring : map(ring->cq_ring_size, IORING_OFF_CQ_RING);
+        ring->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        ring->sqes = static_cast<io_uring_sqe*>(map(ring->sqes_size, IORING_OFF_SQES));
+        if (!ring->cq_ring || !ring->sqes) {
+            return nullptr;
+        }
+
+        auto* sq = static_cast<b8*>(ring->sq_ring);
+        ring->sq_head    = reinterpret_cast<std::atomic<u32>*>(sq + params.sq_off.head);
+        ring->sq_tail    = reinterpret_cast<std::atomic<u32>*>(sq + params.sq_off.tail);
+        ring->sq_mask    = *reinterpret_cast<u32*>(sq + params.sq_off.ring_mask);
+        ring->sq_array   = reinterpret_cast<u32*>(sq + params.sq_off.array);
+        ring->sq_entries = params.sq_entries;
+
+        auto* cq = static_cast<b8*>(ring->cq_ring);
+        ring->cq_head = reinterpret_cast<std::atomic<u32>*>(cq + params.cq_off.head);
+        ring->cq_tail = reinterpret_cast<std::atomic<u32>*>(cq + params.cq_off.tail);
+        ring->cq_mask = *reinterpret_cast<u32*>(cq + params.cq_off.ring_mask);
+        ring->cqes    = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        ring->completion_thread = std::thread([ring = ring.get()] {
+            ring->CompletionLoop();
+        });
+
+        return ring.release();
+    }
+
+    void DestroyRing(RingBackend* ring)
+    {
+        // The queue has no requests outstanding, wake the completion thread with a no-op
+        {
+            std::scoped_lock lock{ ring->mutex };
+            ring->stopping = true;
+
+            u32 tail = ring->sq_tail->load(std::memory_order_relaxed);
+            io_uring_sqe* sqe = &ring->sqes[tail & ring->sq_mask];
+            std::memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_NOP;
+            sqe->user_data = WakeTag;
+            ring->sq_array[tail & ring->sq_mask] = tail & ring->sq_mask;
+            ring->sq_tail->store(tail + 1, std::memory_order_release);
+            ring->Enter(1);
+        }
+
+        ring->completion_thread.join();
+        delete ring;
+    }
+
+    void SubmitRing(RingBackend* ring, std::span<Operation*> ops)
+    {
+        std::scoped_lock lock{ ring->mutex };
+
+        // Preserve submission order behind any existing backlog
+        u32 count = 0;
+        for (auto* op : ops) {
+            if (ring->backlog.empty() && ring->Prepare(op)) {
+                count++;
+            } else {
+                ring->backlog.push_back(op);
+            }
+        }
+        ring->Enter(count);
+    }
+}
\ No newline at end of file
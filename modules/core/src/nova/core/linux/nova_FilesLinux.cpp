@@ -0,0 +1,94 @@
+#include <nova/core/nova_Files.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nova
+{
+    template<>
+    struct Handle<MappedFile>::Impl
+    {
+        int       file = -1;
+        void*   mapped = {};
+        usz       size = {};
+
+        void*     head = {};
+    };
+
+    MappedFile MappedFile::Open(StringView path, bool write)
+    {
+        auto impl = new Impl;
+
+        NOVA_CLEANUP_ON_EXCEPTION(&) { MappedFile(impl).Destroy(); };
+
+        impl->file = ::open(path.CStr(), (write ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+        if (impl->file < 0) {
+            NOVA_THROW("Failed to open file [{}]: {}", path, std::strerror(errno));
+        }
+
+        struct stat st;
+        if (::fstat(impl->file, &st) != 0) {
+            NOVA_THROW("Failed to stat file [{}]: {}", path, std::strerror(errno));
+        }
+        impl->size = usz(st.st_size);
+
+        int protect = write ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        impl->mapped = ::mmap(nullptr, impl->size, protect, MAP_SHARED, impl->file, 0);
+        if (impl->mapped == MAP_FAILED) {
+            impl->mapped = nullptr;
+            NOVA_THROW("Failed to map file [{}]: {}", path, std::strerror(errno));
+        }
+
+        // Mapped files are mostly read front to back
+        ::madvise(impl->mapped, impl->size, MADV_SEQUENTIAL);
+
+        impl->head = impl->mapped;
+
+        return { impl };
+    }
+
+    void MappedFile::Destroy()
+    {
+        if (!impl) return;
+
+        if (impl->mapped) ::munmap(impl->mapped, impl->size);
+        if (impl->file >= 0) ::close(impl->file);
+
+        delete impl;
+        impl = nullptr;
+    }
+
+    void* MappedFile::GetAddress() const
+    {
+        return impl->mapped;
+    }
+
+    usz MappedFile::GetSize() const
+    {
+        return impl->size;
+    }
+
+    void MappedFile::Seek(usz offset) const
+    {
+        impl->head = ByteOffsetPointer(impl->mapped, offset);
+    }
+
+    usz MappedFile::GetOffset() const
+    {
+        return ByteDistance(impl->mapped, impl->head);
+    }
+
+    void MappedFile::Write(const void* data, usz size) const
+    {
+        std::memcpy(impl->head, data, size);
+        impl->head = ByteOffsetPointer(impl->head, size);
+    }
+
+    void MappedFile::Read(void* data, usz size) const
+    {
+        std::memcpy(data, impl->head, size);
+        impl->head = ByteOffsetPointer(impl->head, size);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include <nova/core/nova_Core.hpp>
+
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+// -----------------------------------------------------------------------------
+//                          Linux Virtual Allocation
+// -----------------------------------------------------------------------------
+
+namespace nova
+{
+    void* AllocVirtual(AllocationType type, usz size, void* address)
+    {
+        int protect = (type >= AllocationType::Commit) ? (PROT_READ | PROT_WRITE) : PROT_NONE;
+
+        if (address) {
+            // Commit into an existing reservation
+            return ::mprotect(address, size, protect) == 0 ? address : nullptr;
+        }
+
+        void* ptr = ::mmap(nullptr, size, protect, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+    void FreeVirtual(FreeType type, void* ptr, usz size)
+    {
+        if (type >= FreeType::Release) {
+            ::munmap(ptr, size);
+        } else {
+            ::madvise(ptr, size, MADV_DONTNEED);
+            ::mprotect(ptr, size, PROT_NONE);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+//                            Linux Environment
+// -----------------------------------------------------------------------------
+
+namespace nova::env
+{
+    std::string GetValue(StringView name)
+    {
+        const char* value = std::getenv(name.CStr());
+        return value ? std::string(value) : std::string();
+    }
+
+    fs::path GetExecutablePath()
+    {
+        return fs::read_symlink("/proc/self/exe");
+    }
+
+    fs::path GetUserDirectory()
+    {
+        return fs::path(GetValue("HOME"));
+    }
+
+    std::string GetCmdLineArgs()
+    {
+        std::ifstream in("/proc/self/cmdline", std::ios::binary);
+        std::string raw{ std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+
+        // Arguments are null separated, re-join them with quoting that ParseCmdLineArgs understands
+        std::string args;
+        usz start = 0;
+        while (start < raw.size()) {
+            usz end = raw.find('\0', start);
+            if (end == std::string::npos) end = raw.size();
+            auto arg = std::string_view(raw).substr(start, end - start);
+
+            if (!args.empty()) args.push_back(' ');
+            if (arg.empty() || arg.find_first_of(" \t\"") != std::string_view::npos) {
+                args.push_back('"');
+                for (char c : arg) {
+                    if (c == '"') args.push_back('\\');
+                    args.push_back(c);
+                }
+                args.push_back('"');
+            } else {
+                args.append(arg);
+            }
+
+            start = end + 1;
+        }
+
+        return args;
+    }
+
+    std::vector<std::string> ParseCmdLineArgs(StringView args)
+    {
+        std::vector<std::string> out;
+        std::string cur;
+        bool in_arg = false;
+        bool quoted = false;
+
+        for (auto i = args.begin(); i != args.end(); ++i) {
+            char c = *i;
+            if (c == '\\' && quoted && (i + 1) != args.end() && *(i + 1) == '"') {
+                cur.push_back('"');
+                ++i;
+            } else if (c == '"') {
+                quoted = !quoted;
+                in_arg = true;
+            } else if ((c == ' ' || c == '\t') && !quoted) {
+                if (in_arg) {
+                    out.emplace_back(std::move(cur));
+                    cur.clear();
+                    in_arg = false;
+                }
+            } else {
+                cur.push_back(c);
+                in_arg = true;
+            }
+        }
+
+        if (in_arg) {
+            out.emplace_back(std::move(cur));
+        }
+
+        return out;
+    }
+}
+
+// -----------------------------------------------------------------------------
+//                          Linux Resource Usage
+// -----------------------------------------------------------------------------
+
+namespace nova::env
+{
+    std::chrono::nanoseconds GetThreadCpuTime()
+    {
+        timespec ts;
+        if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts)) {
+            NOVA_THROW("Failed to query thread CPU time: {}", std::strerror(errno));
+        }
+
+        return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+    }
+
+    MemoryUsage GetProcessMemoryUsage()
+    {
+        MemoryUsage usage;
+
+        // statm reports sizes in pages: size resident shared text lib data dt
+        {
+            std::ifstream in("/proc/self/statm");
+            usz size_pages = 0, resident_pages = 0;
+            in >> size_pages >> resident_pages;
+            usage.resident = resident_pages * usz(::sysconf(_SC_PAGESIZE));
+        }
+
+        rusage ru;
+        if (::getrusage(RUSAGE_SELF, &ru) == 0) {
+            // ru_maxrss is reported in KiB
+            usage.peak_resident = usz(ru.ru_maxrss) * 1024;
+        }
+
+        return usage;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include <nova/core/nova_Timer.hpp>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace nova
+{
+    // timerfd expirations are hrtimers armed with zero slack, unlike nanosleep and poll
+    // timeouts which are subject to the thread's timer slack (50us by default).
+    struct Timer::Impl
+    {
+        int timer_fd = -1;
+        int event_fd = -1;
+    };
+
+    Timer::Timer()
+    {
+        impl = new Impl;
+        NOVA_CLEANUP_ON_EXCEPTION(&) {
+            if (impl->timer_fd != -1) ::close(impl->timer_fd);
+            delete impl;
+        };
+
+        impl->timer_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        if (impl->timer_fd == -1) {
+            NOVA_THROW("Failed to create timerfd: {}", std::strerror(errno));
+        }
+
+        impl->event_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (impl->event_fd == -1) {
+            NOVA_THROW("Failed to create eventfd: {}", std::strerror(errno));
+        }
+
+        SetInitialLatency(std::chrono::microseconds(50));
+    }
+
+    Timer::~Timer()
+    {
+        ::close(impl->timer_fd);
+        ::close(impl->event_fd);
+        delete impl;
+    }
+
+    void Timer::Signal()
+    {
+        signaled.store(true, std::memory_order_release);
+        u64 value = 1;
+        (void)::write(impl->event_fd, &value, sizeof(value));
+    }
+
+    void Timer::ClearWakeup()
+    {
+        u64 value;
+        (void)::read(impl->event_fd, &value, sizeof(value));
+    }
+
+    bool Timer::SleepUntil(std::chrono::steady_clock::time_point target)
+    {
+        // steady_clock is CLOCK_MONOTONIC, so the deadline can be armed as an absolute time
+        auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(target.time_since_epoch());
+        itimerspec spec = {};
+        spec.it_value.tv_sec  = time_t(since_epoch.count() / 1'000'000'000);
+        spec.it_value.tv_nsec = long(since_epoch.count() % 1'000'000'000);
+        if (::timerfd_settime(impl->timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr)) {
+            NOVA_THROW("Failed to arm timerfd: {}", std::strerror(errno));
+        }
+
+        std::array<pollfd, 2> fds {
+            pollfd { .fd = impl->timer_fd, .events = POLLIN },
+            pollfd { .fd = impl->event_fd, .events = POLLIN },
+        };
+
+        for (;;) {
+            if (::poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) continue;
+                NOVA_THROW("Failed to wait on timer: {}", std::strerror(errno));
+            }
+
+            if (fds[1].revents & POLLIN) {
+                ClearWakeup();
+
+                // The wakeup may be left over from a signal already consumed by a previous wait
+                if (signaled.load(std::memory_order_acquire)) {
+                    spec = {};
+                    ::timerfd_settime(impl->timer_fd, 0, &spec, nullptr);
+                    return false;
+                }
+            }
+
+            if (fds[0].revents & POLLIN) {
+                u64 expirations;
+                (void)::read(impl->timer_fd, &expirations, sizeof(expirations));
+                return true;
+            }
+        }
+    }
+}
\ No newline at end of file
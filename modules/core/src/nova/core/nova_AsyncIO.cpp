@@ -0,0 +1,361 @@
+#include "nova_AsyncIO.hpp"
+
+namespace nova
+{
+    template<>
+    struct Handle<io::Queue>::Impl
+    {
+        io::QueueConfig            config;
+        io::detail::RingBackend*     ring = nullptr;
+
+        // Requests submitted but not yet delivered to their callback. Only reaches zero
+        // under idle_mutex, so that a waiter may destroy the queue once it observes zero.
+        std::atomic<u32>          pending = 0;
+        std::mutex             idle_mutex;
+        std::condition_variable   idle_cv;
+
+        // Thread pool backend
+        std::vector<std::jthread>      workers;
+        std::deque<io::detail::Operation*> queue;
+        std::mutex                      mutex;
+        std::condition_variable            cv;
+        bool                          running = true;
+    };
+}
+
+namespace nova::io
+{
+    std::string Completion::ErrorString() const
+    {
+        return std::system_category().message(error);
+    }
+
+    Request Request::Open(std::string path, OpenFlags flags, CompletionFn callback)
+    {
+        Request request;
+        request.type = OpType::Open;
+        request.path = std::move(path);
+        request.flags = flags;
+        request.callback = std::move(callback);
+        return request;
+    }
+
+    Request Request::Close(NativeFile file, CompletionFn callback)
+    {
+        Request request;
+        request.type = OpType::Close;
+        request.file = file;
+        request.callback = std::move(callback);
+        return request;
+    }
+
+    Request Request::Read(NativeFile file, void* buffer, u64 size, u64 offset, CompletionFn callback)
+    {
+        Request request;
+        request.type = OpType::Read;
+        request.file = file;
+        request.buffer = buffer;
+        request.size = size;
+        request.offset = offset;
+        request.callback = std::move(callback);
+        return request;
+    }
+
+    Request Request::Write(NativeFile file, const void* data, u64 size, u64 offset, CompletionFn callback)
+    {
+        Request request;
+        request.type = OpType::Write;
+        request.file = file;
+        request.buffer = const_cast<void*>(data);
+        request.size = size;
+        request.offset = offset;
+        request.callback = std::move(callback);
+        return request;
+    }
+
+    Request Request::Stat(std::string path, FileStat* stat, CompletionFn callback)
+    {
+        Request request;
+        request.type = OpType::Stat;
+        request.path = std::move(path);
+        request.stat = stat;
+        request.callback = std::move(callback);
+        return request;
+    }
+
+    const char* BackendToString(Backend backend)
+    {
+        switch (backend) {
+            break;case Backend::ThreadPool: return "ThreadPool";
+            break;case Backend::IoUring:    return "io_uring";
+        }
+        return "Unknown";
+    }
+
+// -----------------------------------------------------------------------------
+
+    namespace
+    {
+        void Worker(Queue::Impl* impl, u32 index)
+        {
+            NOVA_PROFILE_THREAD(Fmt("I/O Worker {}", index));
+
+            for (;;) {
+                std::unique_lock lock{ impl->mutex };
+                while (impl->queue.empty()) {
+                    if (!impl->running) {
+                        return;
+                    }
+                    impl->cv.wait(lock);
+                }
+                auto* op = impl->queue.front();
+                impl->queue.pop_front();
+                lock.unlock();
+
+                detail::Execute(*op);
+                detail::Complete(impl, op);
+            }
+        }
+
+        void Finish(Queue::Impl* impl, detail::Operation* op)
+        {
+            delete op;
+
+            std::scoped_lock lock{ impl->idle_mutex };
+            if (impl->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                impl->idle_cv.notify_all();
+            }
+        }
+    }
+
+    void detail::Complete(Queue::Impl* impl, Operation* op)
+    {
+        auto& result = op->result;
+        result.type = op->request.type;
+        if (!result.Ok()) {
+            stats::Failures.Add();
+        } else if (result.type == OpType::Read) {
+            stats::BytesRead.Add(u64(result.result));
+        } else if (result.type == OpType::Write) {
+            stats::BytesWritten.Add(u64(result.result));
+        }
+
+        if (!op->request.callback) {
+            Finish(impl, op);
+        } else if (impl->config.jobs) {
+            Job::Create(impl->config.jobs, [impl, op] {
+                op->request.callback(op->result);
+                Finish(impl, op);
+            })->Submit();
+        } else {
+            op->request.callback(op->result);
+            Finish(impl, op);
+        }
+    }
+
+// -----------------------------------------------------------------------------
+
+    Queue Queue::Create(const QueueConfig& config)
+    {
+        auto impl = new Impl;
+        impl->config = config;
+
+        if (config.allow_io_uring) {
+            impl->ring = detail::CreateRing(impl, std::max(config.depth, 1u));
+        }
+
+        if (!impl->ring) {
+            for (u32 i = 0; i < std::max(config.threads, 1u); ++i) {
+                impl->workers.emplace_back([impl, i] {
+                    Worker(impl, i);
+                });
+            }
+        }
+
+        return { impl };
+    }
+
+    void Queue::Destroy()
+    {
+        if (!impl) {
+            return;
+        }
+
+        Wait();
+
+        if (impl->ring) {
+            detail::DestroyRing(impl->ring);
+        }
+
+        {
+            std::scoped_lock lock{ impl->mutex };
+            impl->running = false;
+            impl->cv.notify_all();
+        }
+        impl->workers.clear();
+
+        delete impl;
+        impl = nullptr;
+    }
+
+    Backend Queue::GetBackend() const
+    {
+        return impl->ring ? Backend::IoUring : Backend::ThreadPool;
+    }
+
+    void Queue::Submit(Request request) const
+    {
+        Submit(std::span(&request, 1));
+    }
+
+    void Queue::Submit(std::span<Request> requests) const
+    {
+        if (requests.empty()) {
+            return;
+        }
+
+        stats::Requests.Add(requests.size());
+        impl->pending.fetch_add(u32(requests.size()), std::memory_order_relaxed);
+
+        NOVA_STACK_POINT();
+        auto ops = NOVA_STACK_ALLOC(detail::Operation*, requests.size());
+        for (usz i = 0; i < requests.size(); ++i) {
+            ops[i] = new detail::Operation{ std::move(requests[i]) };
+        }
+
+        if (impl->ring) {
+            detail::SubmitRing(impl->ring, { ops, requests.size() });
+            return;
+        }
+
+        std::scoped_lock lock{ impl->mutex };
+        impl->queue.insert(impl->queue.end(), ops, ops + requests.size());
+        if (requests.size() == 1) {
+            impl->cv.notify_one();
+        } else {
+            impl->cv.notify_all();
+        }
+    }
+
+    void Queue::Wait() const
+    {
+        std::unique_lock lock{ impl->idle_mutex };
+        impl->idle_cv.wait(lock, [&] { return impl->pending.load(std::memory_order_acquire) == 0; });
+    }
+
+    u32 Queue::GetPending() const
+    {
+        return impl->pending.load(std::memory_order_relaxed);
+    }
+
+// -----------------------------------------------------------------------------
+
+    namespace
+    {
+        // Bounds open descriptors and buffered contents, independent of the batch size
+        constexpr u32 MaxFilesInFlight = 256;
+
+        struct FileBatch
+        {
+            Queue                      queue;
+            ReadFileFn                    fn;
+            std::vector<std::string>   paths;
+            std::atomic<u32>            next = 0;
+        };
+
+        struct FileRead
+        {
+            std::shared_ptr<FileBatch> batch;
+            u32                        index;
+            FileStat                    stat;
+            std::vector<char>       contents;
+            NativeFile                  file = InvalidFile;
+            u64                       offset = 0;
+
+            void Finish(std::vector<char> data, const Completion& result);
+            void Fail(const Completion& result);
+            static void ReadNext(std::shared_ptr<FileRead> self);
+        };
+
+        Request StartRead(std::shared_ptr<FileBatch> batch, u32 index)
+        {
+            auto read = std::make_shared<FileRead>(std::move(batch), index);
+            auto* stat = &read->stat;
+            return Request::Stat(read->batch->paths[index], stat, [read](const Completion& result) {
+                if (!result.Ok()) {
+                    read->Fail(result);
+                    return;
+                }
+
+                read->contents.resize(read->stat.size);
+                read->batch->queue.Submit(Request::Open(read->batch->paths[read->index], OpenFlags::Read, [read](const Completion& result) {
+                    if (!result.Ok()) {
+                        read->Fail(result);
+                        return;
+                    }
+                    read->file = result.result;
+                    FileRead::ReadNext(read);
+                }));
+            });
+        }
+
+        void FileRead::Finish(std::vector<char> data, const Completion& result)
+        {
+            batch->fn(index, std::move(data), result);
+
+            // Each finished file makes room for the next
+            u32 next = batch->next.fetch_add(1, std::memory_order_relaxed);
+            if (next < batch->paths.size()) {
+                batch->queue.Submit(StartRead(batch, next));
+            }
+        }
+
+        void FileRead::Fail(const Completion& result)
+        {
+            if (file != InvalidFile) {
+                batch->queue.Submit(Request::Close(std::exchange(file, InvalidFile)));
+            }
+            Finish({}, result);
+        }
+
+        // Reads may return short for very large files, so continue from the last offset
+        void FileRead::ReadNext(std::shared_ptr<FileRead> self)
+        {
+            auto* read = self.get();
+            read->batch->queue.Submit(Request::Read(read->file, read->contents.data() + read->offset,
+                    read->contents.size() - read->offset, read->offset, [self = std::move(self)](const Completion& result) {
+                if (!result.Ok()) {
+                    self->Fail(result);
+                    return;
+                }
+
+                self->offset += u64(result.result);
+                if (result.result > 0 && self->offset < self->contents.size()) {
+                    ReadNext(self);
+                    return;
+                }
+
+                // The file may have been truncated since the stat
+                self->contents.resize(self->offset);
+                self->batch->queue.Submit(Request::Close(std::exchange(self->file, InvalidFile)));
+                self->Finish(std::move(self->contents), result);
+            }));
+        }
+    }
+
+    void ReadFiles(Queue queue, Span<std::string> paths, ReadFileFn fn)
+    {
+        auto batch = std::make_shared<FileBatch>(queue, std::move(fn), std::vector<std::string>(paths.begin(), paths.end()));
+
+        u32 initial = std::min(u32(paths.size()), MaxFilesInFlight);
+        batch->next = initial;
+
+        std::vector<Request> stats;
+        stats.reserve(initial);
+        for (u32 i = 0; i < initial; ++i) {
+            stats.emplace_back(StartRead(batch, i));
+        }
+
+        queue.Submit(stats);
+    }
+}
\ No newline at end of file
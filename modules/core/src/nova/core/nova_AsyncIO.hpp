@@ -0,0 +1,183 @@
+#pragma once
+
+#include "nova_Core.hpp"
+#include "nova_JobSystem.hpp"
+
+// -----------------------------------------------------------------------------
+//                              Asynchronous I/O
+// -----------------------------------------------------------------------------
+
+// Batched file operations that complete out of order. On Linux requests go through
+// io_uring, with a whole batch submitted in one syscall. Elsewhere, or where io_uring
+// is unavailable, a pool of I/O threads runs them with blocking calls.
+//
+//   auto queue = io::Queue::Create({ .jobs = &job_system });
+//   io::ReadFiles(queue, paths, [&](u32 index, std::vector<char> data, const io::Completion& result) {
+//       if (result.Ok()) Compile(paths[index], data);
+//   });
+//   queue.Wait();
+//
+// Callbacks run as jobs on the configured JobSystem, or on an I/O thread otherwise.
+// Callbacks may submit follow up requests to the same queue.
+
+namespace nova::io
+{
+    namespace stats
+    {
+        inline metrics::Counter BytesRead   { "io.bytes_read",    "Bytes read by completed async requests" };
+        inline metrics::Counter BytesWritten{ "io.bytes_written", "Bytes written by completed async requests" };
+        inline metrics::Counter Requests    { "io.requests",      "Async file requests submitted" };
+        inline metrics::Counter Failures    { "io.failures",      "Async file requests completed with an error" };
+    }
+
+// -----------------------------------------------------------------------------
+
+    // File descriptor on Linux, HANDLE on Windows
+    using NativeFile = i64;
+    inline constexpr NativeFile InvalidFile = -1;
+
+    enum class OpenFlags : u32
+    {
+        None     = 0,
+        Read     = 1 << 0,
+        Write    = 1 << 1,
+        Create   = 1 << 2,
+        Truncate = 1 << 3,
+    };
+    NOVA_DECORATE_FLAG_ENUM(OpenFlags)
+
+    enum class OpType : u8
+    {
+        Open,
+        Close,
+        Read,
+        Write,
+        Stat,
+    };
+
+    struct FileStat
+    {
+        u64           size = 0;
+        i64  last_write_ns = 0; // Since the Unix epoch
+        bool  is_directory = false;
+    };
+
+    struct Completion
+    {
+        OpType type = {};
+
+        // The opened file for Open, bytes transferred for Read and Write
+        i64  result = 0;
+
+        // errno on Linux, GetLastError on Windows. Zero on success
+        i32   error = 0;
+
+    public:
+        bool Ok() const noexcept
+        {
+            return error == 0;
+        }
+
+        std::string ErrorString() const;
+    };
+
+    using CompletionFn = std::function<void(const Completion&)>;
+
+    struct Request
+    {
+        OpType        type = OpType::Read;
+        NativeFile    file = InvalidFile;
+        std::string   path;
+        OpenFlags    flags = OpenFlags::None;
+        void*       buffer = nullptr;
+        u64           size = 0;
+        u64         offset = 0;
+        FileStat*     stat = nullptr;
+        CompletionFn callback;
+
+    public:
+        static Request Open(std::string path, OpenFlags flags, CompletionFn callback);
+        static Request Close(NativeFile file, CompletionFn callback = {});
+        static Request Read(NativeFile file, void* buffer, u64 size, u64 offset, CompletionFn callback);
+        static Request Write(NativeFile file, const void* data, u64 size, u64 offset, CompletionFn callback);
+
+        // stat must remain valid until the callback runs
+        static Request Stat(std::string path, FileStat* stat, CompletionFn callback);
+    };
+
+// -----------------------------------------------------------------------------
+
+    enum class Backend : u32
+    {
+        ThreadPool,
+        IoUring,
+    };
+
+    const char* BackendToString(Backend backend);
+
+    struct QueueConfig
+    {
+        // Maximum requests in flight in the kernel, further requests wait in user space
+        u32 depth = 256;
+
+        // Workers for the thread pool backend
+        u32 threads = 4;
+
+        // Runs callbacks as jobs. Must outlive the queue
+        JobSystem* jobs = nullptr;
+
+        bool allow_io_uring = true;
+    };
+
+    struct Queue : Handle<Queue>
+    {
+        static Queue Create(const QueueConfig& config = {});
+
+        // Waits for outstanding requests before releasing resources
+        void Destroy();
+
+        Backend GetBackend() const;
+
+        // Requests are moved from. A batch is submitted with a single lock and syscall
+        void Submit(Request request) const;
+        void Submit(std::span<Request> requests) const;
+
+        // Blocks until every submitted request has completed and its callback returned
+        void Wait() const;
+
+        u32 GetPending() const;
+    };
+
+// -----------------------------------------------------------------------------
+
+    using ReadFileFn = std::function<void(u32 index, std::vector<char> contents, const Completion& result)>;
+
+    // Reads whole files, overlapping the stat, open, read and close of every file in the
+    // batch. fn receives the index of each path as it completes, possibly concurrently.
+    // On failure contents is empty and result holds the failed operation.
+    void ReadFiles(Queue queue, Span<std::string> paths, ReadFileFn fn);
+
+// -----------------------------------------------------------------------------
+
+    namespace detail
+    {
+        struct Operation
+        {
+            Request  request;
+            Completion result;
+        };
+
+        // Blocking implementation of a single operation, used by the thread pool
+        void Execute(Operation& op);
+
+        struct RingBackend;
+
+        // Returns nullptr if io_uring is not available
+        RingBackend* CreateRing(Queue::Impl* queue, u32 depth);
+        void DestroyRing(RingBackend* ring);
+        void SubmitRing(RingBackend* ring, std::span<Operation*> ops);
+
+        // Called by backends once an operation has finished
+        void Complete(Queue::Impl* queue, Operation* op);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,675 @@
+#include "nova_Base64.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#  define NOVA_BASE64_X86
+#  include <immintrin.h>
+#  ifdef _MSC_VER
+#    include <intrin.h>
+#  endif
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#  define NOVA_BASE64_NEON
+#  include <arm_neon.h>
+#endif
+
+namespace nova::base64
+{
+    namespace
+    {
+        // Kernels consume a prefix of whole triples/quads and return how many they handled,
+        // the scalar path finishes the rest. Decode kernels stop before any block that
+        // contains a non-alphabet character so that the scalar path can report it.
+        using EncodeKernel = usz(*)(char* out, const u8* in, usz triples, const Table& table);
+        using DecodeKernel = usz(*)(u8* out, const char* in, usz quads, const Table& table);
+
+        [[noreturn]] NOVA_NO_INLINE
+        void ThrowInvalid(const char* in, usz count, const Table& table, u64 offset)
+        {
+            for (usz i = 0; i < count; ++i) {
+                switch (table.decode[u8(in[i])]) {
+                    break;case Padding:
+                        NOVA_THROW_STACKLESS("Unexpected base64 padding at offset {}", offset + i);
+                    break;case Invalid:
+                        NOVA_THROW_STACKLESS("Invalid base64 character 0x{:02x} at offset {}", u32(u8(in[i])), offset + i);
+                }
+            }
+            NOVA_THROW_STACKLESS("Invalid base64 data at offset {}", offset);
+        }
+
+// -----------------------------------------------------------------------------
+//                                  Scalar
+// -----------------------------------------------------------------------------
+
+        void EncodeTriplesScalar(char* out, const u8* in, usz triples, const Table& table)
+        {
+            for (usz i = 0; i < triples; ++i, in += 3, out += 4) {
+                out[0] = table.encode[                        in[0] >> 2 ];
+                out[1] = table.encode[((in[0] & 0x03) << 4) | (in[1] >> 4)];
+                out[2] = table.encode[((in[1] & 0x0f) << 2) | (in[2] >> 6)];
+                out[3] = table.encode[  in[2] & 0x3f                     ];
+            }
+        }
+
+        void DecodeQuadsScalar(u8* out, const char* in, usz quads, const Table& table, u64 offset)
+        {
+            for (usz i = 0; i < quads; ++i, in += 4, out += 3) {
+                i32 e0 = table.decode[u8(in[0])];
+                i32 e1 = table.decode[u8(in[1])];
+                i32 e2 = table.decode[u8(in[2])];
+                i32 e3 = table.decode[u8(in[3])];
+                if ((e0 | e1 | e2 | e3) < 0) [[unlikely]] {
+                    ThrowInvalid(in, 4, table, offset + i * 4);
+                }
+                out[0] = u8((e0 << 2) | (e1 >> 4));
+                out[1] = u8((e1 << 4) | (e2 >> 2));
+                out[2] = u8((e2 << 6) |  e3);
+            }
+        }
+
+// -----------------------------------------------------------------------------
+//                                   x86
+// -----------------------------------------------------------------------------
+
+#ifdef NOVA_BASE64_X86
+        // Encode: 3 byte groups are spread to 4 x 6 bit indices per 32 bit lane with two
+        // multiplies, indices are then mapped to ASCII by adding a per-range offset.
+        //
+        // Decode: characters are validated against the table's ASCII bitmap using their low
+        // and high nibbles as shuffle indices, offset to their 6 bit values by high nibble
+        // (with the two table specific characters patched in), then packed back together
+        // with two multiply-adds and a shuffle.
+
+        NOVA_TARGET("ssse3")
+        usz EncodeSSSE3(char* out, const u8* in, usz triples, const Table& table)
+        {
+            const __m128i spread   = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+            const __m128i offsets  = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                '0' - 52, '0' - 52, '0' - 52, '0' - 52, char(table.encode[62] - 62), char(table.encode[63] - 63), 'A', 0, 0);
+
+            // 16 byte loads consume 12 bytes, leave 4 bytes of slack at the end
+            usz size = triples * 3;
+            usz i = 0;
+            for (; i + 16 <= size; i += 12, out += 16) {
+                __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), spread);
+
+                __m128i hi  = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+                __m128i lo  = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+                __m128i idx = _mm_or_si128(hi, lo);
+
+                __m128i range = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+                range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_add_epi8(_mm_shuffle_epi8(offsets, range), idx));
+            }
+
+            return i / 3;
+        }
+
+        NOVA_TARGET("avx2")
+        usz EncodeAVX2(char* out, const u8* in, usz triples, const Table& table)
+        {
+            const __m256i spread   = _mm256_setr_epi8(
+                1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+            const __m256i offsets  = _mm256_broadcastsi128_si256(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, char(table.encode[62] - 62), char(table.encode[63] - 63), 'A', 0, 0));
+
+            // Each lane loads 16 bytes and consumes 12, the upper lane reads 4 bytes past the block
+            usz size = triples * 3;
+            usz i = 0;
+            for (; i + 28 <= size; i += 24, out += 32) {
+                __m256i v = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))),
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12)), 1);
+                v = _mm256_shuffle_epi8(v, spread);
+
+                __m256i hi  = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+                __m256i lo  = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+                __m256i idx = _mm256_or_si256(hi, lo);
+
+                __m256i range = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+                range = _mm256_or_si256(range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx), _mm256_set1_epi8(13)));
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_add_epi8(_mm256_shuffle_epi8(offsets, range), idx));
+            }
+
+            return i / 3;
+        }
+
+        NOVA_TARGET("ssse3")
+        usz DecodeSSSE3(u8* out, const char* in, usz quads, const Table& table)
+        {
+            const __m128i bitmap  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.ascii_bitmap));
+            const __m128i hi_bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+            const __m128i offsets = _mm_setr_epi8(0, 0, 0, 52 - '0', -'A', -'A', 26 - 'a', 26 - 'a', 0, 0, 0, 0, 0, 0, 0, 0);
+            const __m128i c62 = _mm_set1_epi8(table.encode[62]);
+            const __m128i c63 = _mm_set1_epi8(table.encode[63]);
+            const __m128i o62 = _mm_set1_epi8(char(62 - table.encode[62]));
+            const __m128i o63 = _mm_set1_epi8(char(63 - table.encode[63]));
+            const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+            // Stores write 16 bytes for 12 bytes of output, stop while 4 bytes of slack remain
+            usz q = 0;
+            for (; q + 6 <= quads; q += 4) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + q * 4));
+
+                // Bytes >= 0x80 have a high nibble with no bit in hi_bits
+                __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f));
+                __m128i lo = _mm_and_si128(v, _mm_set1_epi8(0x0f));
+                __m128i valid = _mm_and_si128(_mm_shuffle_epi8(bitmap, lo), _mm_shuffle_epi8(hi_bits, hi));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(valid, _mm_setzero_si128()))) {
+                    break;
+                }
+
+                __m128i is62 = _mm_cmpeq_epi8(v, c62);
+                __m128i is63 = _mm_cmpeq_epi8(v, c63);
+                __m128i offset = _mm_andnot_si128(_mm_or_si128(is62, is63), _mm_shuffle_epi8(offsets, hi));
+                offset = _mm_or_si128(offset, _mm_or_si128(_mm_and_si128(is62, o62), _mm_and_si128(is63, o63)));
+                v = _mm_add_epi8(v, offset);
+
+                // [00aaaaaa 00bbbbbb 00cccccc 00dddddd] -> [aaaaaabb bbbbcccc ccdddddd]
+                v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+                v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+                v = _mm_shuffle_epi8(v, pack);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + q * 3), v);
+            }
+
+            return q;
+        }
+
+        NOVA_TARGET("avx2")
+        usz DecodeAVX2(u8* out, const char* in, usz quads, const Table& table)
+        {
+            const __m256i bitmap  = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table.ascii_bitmap)));
+            const __m256i hi_bits = _mm256_broadcastsi128_si256(_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0));
+            const __m256i offsets = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 0, 0, 52 - '0', -'A', -'A', 26 - 'a', 26 - 'a', 0, 0, 0, 0, 0, 0, 0, 0));
+            const __m256i c62 = _mm256_set1_epi8(table.encode[62]);
+            const __m256i c63 = _mm256_set1_epi8(table.encode[63]);
+            const __m256i o62 = _mm256_set1_epi8(char(62 - table.encode[62]));
+            const __m256i o63 = _mm256_set1_epi8(char(63 - table.encode[63]));
+            const __m256i pack = _mm256_setr_epi8(
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+            const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+
+            // Stores write 32 bytes for 24 bytes of output, stop while 8 bytes of slack remain
+            usz q = 0;
+            for (; q + 11 <= quads; q += 8) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + q * 4));
+
+                __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f));
+                __m256i lo = _mm256_and_si256(v, _mm256_set1_epi8(0x0f));
+                __m256i valid = _mm256_and_si256(_mm256_shuffle_epi8(bitmap, lo), _mm256_shuffle_epi8(hi_bits, hi));
+                if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(valid, _mm256_setzero_si256()))) {
+                    break;
+                }
+
+                __m256i is62 = _mm256_cmpeq_epi8(v, c62);
+                __m256i is63 = _mm256_cmpeq_epi8(v, c63);
+                __m256i offset = _mm256_andnot_si256(_mm256_or_si256(is62, is63), _mm256_shuffle_epi8(offsets, hi));
+                offset = _mm256_or_si256(offset, _mm256_or_si256(_mm256_and_si256(is62, o62), _mm256_and_si256(is63, o63)));
+                v = _mm256_add_epi8(v, offset);
+
+                v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+                v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+                v = _mm256_shuffle_epi8(v, pack);
+                v = _mm256_permutevar8x32_epi32(v, compact);
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + q * 3), v);
+            }
+
+            return q;
+        }
+
+        bool CpuSupports(Backend backend)
+        {
+#ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 0);
+            int max_leaf = info[0];
+
+            __cpuid(info, 1);
+            bool ssse3 = info[2] & (1 << 9);
+            bool os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 0x6) == 0x6;
+
+            bool avx2 = false;
+            if (max_leaf >= 7) {
+                __cpuidex(info, 7, 0);
+                avx2 = os_avx && (info[1] & (1 << 5));
+            }
+#else
+            __builtin_cpu_init();
+            bool ssse3 = __builtin_cpu_supports("ssse3");
+            bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+            switch (backend) {
+                break;case Backend::SSSE3: return ssse3;
+                break;case Backend::AVX2:  return avx2;
+                break;default:             return false;
+            }
+        }
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   NEON
+// -----------------------------------------------------------------------------
+
+#ifdef NOVA_BASE64_NEON
+        // Table lookups cover the full alphabet, so NEON paths work with any table
+
+        usz EncodeNeon(char* out, const u8* in, usz triples, const Table& table)
+        {
+            const uint8x16x4_t lut = vld1q_u8_x4(reinterpret_cast<const u8*>(table.encode));
+            const uint8x16_t mask = vdupq_n_u8(0x3f);
+
+            usz t = 0;
+            for (; t + 16 <= triples; t += 16) {
+                uint8x16x3_t v = vld3q_u8(in + t * 3);
+
+                uint8x16x4_t idx;
+                idx.val[0] = vshrq_n_u8(v.val[0], 2);
+                idx.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(v.val[0], 4), vshrq_n_u8(v.val[1], 4)), mask);
+                idx.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(v.val[1], 2), vshrq_n_u8(v.val[2], 6)), mask);
+                idx.val[3] = vandq_u8(v.val[2], mask);
+
+                uint8x16x4_t chars;
+                for (u32 i = 0; i < 4; ++i) {
+                    chars.val[i] = vqtbl4q_u8(lut, idx.val[i]);
+                }
+                vst4q_u8(reinterpret_cast<u8*>(out + t * 4), chars);
+            }
+
+            return t;
+        }
+
+        usz DecodeNeon(u8* out, const char* in, usz quads, const Table& table)
+        {
+            // Invalid (-1) and Padding (-2) entries read as >= 64
+            const uint8x16x4_t lut_lo = vld1q_u8_x4(reinterpret_cast<const u8*>(table.decode));
+            const uint8x16x4_t lut_hi = vld1q_u8_x4(reinterpret_cast<const u8*>(table.decode + 64));
+
+            usz q = 0;
+            for (; q + 16 <= quads; q += 16) {
+                uint8x16x4_t v = vld4q_u8(reinterpret_cast<const u8*>(in + q * 4));
+
+                uint8x16_t error = vdupq_n_u8(0);
+                for (u32 i = 0; i < 4; ++i) {
+                    uint8x16_t c = v.val[i];
+                    uint8x16_t d = vqtbx4q_u8(vqtbl4q_u8(lut_lo, c), lut_hi, vsubq_u8(c, vdupq_n_u8(64)));
+
+                    // Bytes >= 0x80 miss both lookups, force them invalid
+                    d = vorrq_u8(d, vreinterpretq_u8_s8(vshrq_n_s8(vreinterpretq_s8_u8(c), 7)));
+                    error = vorrq_u8(error, d);
+                    v.val[i] = d;
+                }
+
+                if (vmaxvq_u8(error) >= 64) {
+                    break;
+                }
+
+                uint8x16x3_t bytes;
+                bytes.val[0] = vorrq_u8(vshlq_n_u8(v.val[0], 2), vshrq_n_u8(v.val[1], 4));
+                bytes.val[1] = vorrq_u8(vshlq_n_u8(v.val[1], 4), vshrq_n_u8(v.val[2], 2));
+                bytes.val[2] = vorrq_u8(vshlq_n_u8(v.val[2], 6), v.val[3]);
+                vst3q_u8(out + q * 3, bytes);
+            }
+
+            return q;
+        }
+#endif
+
+// -----------------------------------------------------------------------------
+//                                 Dispatch
+// -----------------------------------------------------------------------------
+
+        struct Kernels
+        {
+            EncodeKernel encode = nullptr;
+            DecodeKernel decode = nullptr;
+            bool      any_table = false;
+        };
+
+        Kernels GetKernels(Backend backend)
+        {
+            switch (backend) {
+#ifdef NOVA_BASE64_X86
+                break;case Backend::SSSE3: return { EncodeSSSE3, DecodeSSSE3, false };
+                break;case Backend::AVX2:  return { EncodeAVX2,  DecodeAVX2,  false };
+#endif
+#ifdef NOVA_BASE64_NEON
+                break;case Backend::Neon:  return { EncodeNeon,  DecodeNeon,  true  };
+#endif
+                break;default:             return {};
+            }
+        }
+
+        Backend DetectBackend()
+        {
+            for (auto backend : { Backend::AVX2, Backend::Neon, Backend::SSSE3 }) {
+                if (IsSupported(backend)) {
+                    return backend;
+                }
+            }
+            return Backend::Scalar;
+        }
+
+        std::atomic<Backend>& GetActiveBackend()
+        {
+            static std::atomic<Backend> backend = DetectBackend();
+            return backend;
+        }
+
+        Kernels& GetActiveKernels()
+        {
+            thread_local Backend backend = Backend::Scalar;
+            thread_local Kernels kernels;
+            Backend active = GetActiveBackend().load(std::memory_order_relaxed);
+            if (active != backend) {
+                backend = active;
+                kernels = GetKernels(active);
+            }
+            return kernels;
+        }
+
+// -----------------------------------------------------------------------------
+
+        void EncodeTriples(char* out, const u8* in, usz triples, const Table& table)
+        {
+            auto& kernels = GetActiveKernels();
+            if (kernels.encode && (kernels.any_table || table.standard_prefix)) {
+                usz done = kernels.encode(out, in, triples, table);
+                out += done * 4;
+                in += done * 3;
+                triples -= done;
+            }
+            EncodeTriplesScalar(out, in, triples, table);
+        }
+
+        void DecodeQuads(u8* out, const char* in, usz quads, const Table& table, u64 offset)
+        {
+            auto& kernels = GetActiveKernels();
+            if (kernels.decode && (kernels.any_table || table.standard_prefix)) {
+                usz done = kernels.decode(out, in, quads, table);
+                out += done * 3;
+                in += done * 4;
+                quads -= done;
+                offset += done * 4;
+            }
+            DecodeQuadsScalar(out, in, quads, table, offset);
+        }
+
+        // Decodes the final 2 or 3 characters of an unpadded or padding-stripped stream
+        usz DecodeTail(u8* out, const char* in, usz count, const Table& table, u64 offset)
+        {
+            i32 e0 = table.decode[u8(in[0])];
+            i32 e1 = table.decode[u8(in[1])];
+            i32 e2 = count > 2 ? table.decode[u8(in[2])] : 0;
+            if ((e0 | e1 | e2) < 0) {
+                ThrowInvalid(in, count, table, offset);
+            }
+
+            // Canonical encodings leave unused trailing bits zero
+            if (count == 2 ? (e1 & 0x0f) : (e2 & 0x03)) {
+                NOVA_THROW_STACKLESS("Non-zero trailing bits in base64 data at offset {}", offset + count - 1);
+            }
+
+                            out[0] = u8((e0 << 2) | (e1 >> 4));
+            if (count == 3) out[1] = u8((e1 << 4) | (e2 >> 2));
+
+            return count - 1;
+        }
+
+        // Returns the number of characters before any trailing padding
+        usz StripPadding(const char* in, usz size, const Table& table)
+        {
+            if (size == 0 || size % 4 != 0) {
+                return size;
+            }
+
+            if (table.decode[u8(in[size - 1])] == Padding) {
+                size--;
+                if (table.decode[u8(in[size - 1])] == Padding) {
+                    size--;
+                }
+            }
+            return size;
+        }
+    }
+
+// -----------------------------------------------------------------------------
+//                              Backend control
+// -----------------------------------------------------------------------------
+
+    bool IsSupported(Backend backend)
+    {
+        switch (backend) {
+            break;case Backend::Scalar:
+                return true;
+#ifdef NOVA_BASE64_X86
+            break;case Backend::SSSE3:
+                  case Backend::AVX2:
+                return CpuSupports(backend);
+#endif
+#ifdef NOVA_BASE64_NEON
+            break;case Backend::Neon:
+                return true;
+#endif
+            break;default:
+                return false;
+        }
+    }
+
+    Backend GetBackend()
+    {
+        return GetActiveBackend().load(std::memory_order_relaxed);
+    }
+
+    void SetBackend(Backend backend)
+    {
+        if (!IsSupported(backend)) {
+            NOVA_THROW("Base64 backend {} is not supported", BackendToString(backend));
+        }
+        GetActiveBackend().store(backend, std::memory_order_relaxed);
+    }
+
+    const char* BackendToString(Backend backend)
+    {
+        switch (backend) {
+            break;case Backend::Scalar: return "Scalar";
+            break;case Backend::SSSE3:  return "SSSE3";
+            break;case Backend::AVX2:   return "AVX2";
+            break;case Backend::Neon:   return "Neon";
+        }
+        return "Unknown";
+    }
+
+// -----------------------------------------------------------------------------
+//                                 One shot
+// -----------------------------------------------------------------------------
+
+    usz Encode(void* output, usz output_size, const void* input, usz size, bool pad, const Table& table)
+    {
+        usz expected_size = EncodedSize(size, pad);
+        if (expected_size > output_size) return expected_size;
+
+        const u8* data = reinterpret_cast<const u8*>(input);
+        char* encoded = reinterpret_cast<char*>(output);
+
+        usz triples = size / 3;
+        EncodeTriples(encoded, data, triples, table);
+
+        data += triples * 3;
+        encoded += triples * 4;
+        switch (size % 3) {
+            break;case 1:
+                encoded[0] = table.encode[                         data[0] >> 2 ];
+                encoded[1] = table.encode[ (data[0] & 0x03) << 4                ];
+                if (pad) {
+                    encoded[2] = table.padding;
+                    encoded[3] = table.padding;
+                }
+            break;case 2:
+                encoded[0] = table.encode[                         data[0] >> 2 ];
+                encoded[1] = table.encode[((data[0] & 0x03) << 4) | (data[1] >> 4)];
+                encoded[2] = table.encode[ (data[1] & 0x0f) << 2                ];
+                if (pad) {
+                    encoded[3] = table.padding;
+                }
+        }
+
+        return expected_size;
+    }
+
+    usz Decode(void* output, usz output_size, const void* input, usz size, const Table& table)
+    {
+        const char* encoded = reinterpret_cast<const char*>(input);
+
+        usz body = StripPadding(encoded, size, table);
+        usz quads = body / 4;
+        usz remainder = body % 4;
+        if (remainder == 1) {
+            NOVA_THROW_STACKLESS("Invalid base64 length: {}", size);
+        }
+
+        usz expected_size = quads * 3 + (remainder ? remainder - 1 : 0);
+        if (expected_size > output_size) return expected_size;
+
+        u8* data = reinterpret_cast<u8*>(output);
+        DecodeQuads(data, encoded, quads, table, 0);
+        if (remainder) {
+            DecodeTail(data + quads * 3, encoded + quads * 4, remainder, table, quads * 4);
+        }
+
+        return expected_size;
+    }
+
+// -----------------------------------------------------------------------------
+//                                 Streaming
+// -----------------------------------------------------------------------------
+
+    usz Encoder::Update(char* output, const void* input, usz size)
+    {
+        const u8* data = reinterpret_cast<const u8*>(input);
+        usz written = 0;
+
+        if (carry_count) {
+            u8 triple[3] = { carry[0], carry[1] };
+            usz take = std::min(usz(3 - carry_count), size);
+            std::memcpy(triple + carry_count, data, take);
+            data += take;
+            size -= take;
+
+            if (carry_count + take < 3) {
+                std::memcpy(carry, triple, 2);
+                carry_count += u32(take);
+                return 0;
+            }
+
+            EncodeTriplesScalar(output, triple, 1, *table);
+            written += 4;
+            carry_count = 0;
+        }
+
+        usz triples = size / 3;
+        EncodeTriples(output + written, data, triples, *table);
+        written += triples * 4;
+
+        carry_count = u32(size - triples * 3);
+        std::memcpy(carry, data + triples * 3, carry_count);
+
+        return written;
+    }
+
+    usz Encoder::Finish(char* output)
+    {
+        usz written = Encode(output, 4, carry, carry_count, pad, *table);
+        carry_count = 0;
+        return written;
+    }
+
+    usz Decoder::Update(b8* output, const void* input, usz size)
+    {
+        const char* encoded = reinterpret_cast<const char*>(input);
+        u8* data = reinterpret_cast<u8*>(output);
+        usz written = 0;
+
+        if (size == 0) {
+            return 0;
+        }
+
+        if (finished) {
+            NOVA_THROW_STACKLESS("Unexpected base64 data after padding at offset {}", consumed);
+        }
+
+        // Padding may only appear in the final quad of the stream
+        auto decode_quad = [&](const char* quad, u64 offset) {
+            usz body = StripPadding(quad, 4, *table);
+            if (body < 4) {
+                finished = true;
+                if (body < 2) {
+                    ThrowInvalid(quad, 4, *table, offset);
+                }
+                written += DecodeTail(data + written, quad, body, *table, offset);
+            } else {
+                DecodeQuadsScalar(data + written, quad, 1, *table, offset);
+                written += 3;
+            }
+        };
+
+        if (carry_count) {
+            usz take = std::min(usz(4 - carry_count), size);
+            std::memcpy(carry + carry_count, encoded, take);
+            carry_count += u32(take);
+            encoded += take;
+            size -= take;
+
+            if (carry_count < 4) {
+                return 0;
+            }
+
+            decode_quad(carry, consumed);
+            consumed += 4;
+            carry_count = 0;
+        }
+
+        usz quads = size / 4;
+        if (quads > 0) {
+            if (finished) {
+                NOVA_THROW_STACKLESS("Unexpected base64 data after padding at offset {}", consumed);
+            }
+
+            DecodeQuads(data + written, encoded, quads - 1, *table, consumed);
+            written += (quads - 1) * 3;
+            consumed += (quads - 1) * 4;
+
+            decode_quad(encoded + (quads - 1) * 4, consumed);
+            consumed += 4;
+        }
+
+        carry_count = u32(size - quads * 4);
+        if (carry_count && finished) {
+            NOVA_THROW_STACKLESS("Unexpected base64 data after padding at offset {}", consumed);
+        }
+        std::memcpy(carry, encoded + quads * 4, carry_count);
+
+        return written;
+    }
+
+    usz Decoder::Finish(b8* output)
+    {
+        NOVA_DEFER(&) {
+            carry_count = 0;
+            consumed = 0;
+            finished = false;
+        };
+
+        switch (carry_count) {
+            break;case 0:
+                return 0;
+            break;case 1:
+                NOVA_THROW_STACKLESS("Truncated base64 data at offset {}", consumed);
+            break;default:
+                return DecodeTail(reinterpret_cast<u8*>(output), carry, carry_count, *table, consumed);
+        }
+    }
+}
\ No newline at end of file
@@ -15,16 +15,28 @@ namespace nova
             char encode[64]  = {};
             i8   decode[256] = {};
 
+            // Vector paths compute A-Z, a-z, 0-9 arithmetically and only look up the last
+            // two characters, so they are limited to tables that share the standard prefix.
+            bool standard_prefix = false;
+
+            // Bit N of ascii_bitmap[C & 15] is set if character C with high nibble N is in the alphabet
+            u8 ascii_bitmap[16] = {};
+
             constexpr Table(char _padding, const char (&_encode)[65])
                 : padding(_padding)
             {
                 for (u32 i = 0; i < 256; ++i) {
                     decode[i] = Invalid;
                 }
-                decode[_padding] = Padding;
+                decode[u8(_padding)] = Padding;
+                standard_prefix = true;
                 for (u32 i = 0; i < 64; ++i) {
                     encode[i] = _encode[i];
-                    decode[_encode[i]] = i8(i);
+                    decode[u8(_encode[i])] = i8(i);
+                    ascii_bitmap[u8(_encode[i]) & 15] |= u8(1 << (u8(_encode[i]) >> 4));
+                    if (i < 62 && _encode[i] != "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"[i]) {
+                        standard_prefix = false;
+                    }
                 }
             }
         };
@@ -36,113 +48,53 @@ namespace nova
             constexpr static Table URL     = Table('.', "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
         };
 
-        inline
-        usz Encode(void* output, usz output_size, const void* input, usz size, bool pad = true, const Table& table = tables::Default)
-        {
-            usz full_triple_count    =  size      / 3;
-            usz rounded_triple_count = (size + 2) / 3;
-            usz remainder = size - (full_triple_count * 3);
-
-            usz expected_size = rounded_triple_count * 4;
-            if (!pad) {
-                switch (remainder) {
-                    break;case 1: expected_size -= 2; // xx==
-                    break;case 2: expected_size -= 1; // xxx=
-                }
-            }
-
-            if (expected_size > output_size) return expected_size;
-
-            const u8* data = reinterpret_cast<const u8*>(input);
-            char* encoded = reinterpret_cast<char*>(output);
-
-            for (usz i = 0; i < full_triple_count; ++i) {
-                usz oi = i * 4;
-                usz ii = i * 3;
-                encoded[oi + 0] = table.encode[                                data[ii + 0] >> 2 ];
-                encoded[oi + 1] = table.encode[((data[ii + 0] & 0x03) << 4) + (data[ii + 1] >> 4)];
-                encoded[oi + 2] = table.encode[((data[ii + 1] & 0x0f) << 2) + (data[ii + 2] >> 6)];
-                encoded[oi + 3] = table.encode[  data[ii + 2] & 0x3f                             ];
-            }
+// -----------------------------------------------------------------------------
+//                              Implementations
+// -----------------------------------------------------------------------------
 
-            if (remainder) {
-                usz oi = full_triple_count * 4;
-                usz ii = full_triple_count * 3;
-                switch (remainder) {
-                    break;case 1:
-                        encoded[oi + 0] = table.encode[                                data[ii + 0] >> 2 ];
-                        encoded[oi + 1] = table.encode[(data[ii + 0] & 0x03) << 4                        ];
-                        if (pad) {
-                            encoded[oi + 2] = table.padding;
-                            encoded[oi + 3] = table.padding;
-                        }
-                    break;case 2:
-                        encoded[oi + 0] = table.encode[                                data[ii + 0] >> 2 ];
-                        encoded[oi + 1] = table.encode[((data[ii + 0] & 0x03) << 4) | (data[ii + 1] >> 4)];
-                        encoded[oi + 2] = table.encode[( data[ii + 1] & 0x0f) << 2];
-                        if (pad) {
-                            encoded[oi + 3] = table.padding;
-                        }
-                }
-            }
-
-            return expected_size;
-        }
-
-        inline
-        usz Decode(void* output, usz output_size, const void* input, usz size, const Table& table = tables::Default)
+        enum class Backend : u32
         {
-            usz full_quad_count    =  size      / 4;
-            usz remainder = size - (full_quad_count * 4);
+            Scalar,
+            SSSE3,
+            AVX2,
+            Neon,
+        };
 
-            u8* data = reinterpret_cast<u8*>(output);
-            const char* encoded = reinterpret_cast<const char*>(input);
+        // The best supported backend is selected on first use. Override for testing
+        // and benchmarking. Throws if the backend is not supported by this CPU/build.
+        bool    IsSupported(Backend backend);
+        Backend GetBackend();
+        void    SetBackend(Backend backend);
+        const char* BackendToString(Backend backend);
 
-            // Check for padding in last quad
-            if (full_quad_count > 0) {
-                const char* last_quad = encoded + (full_quad_count - 1) * 4;
-                if      (table.decode[last_quad[2]] == Padding) { full_quad_count--; remainder = 2; }
-                else if (table.decode[last_quad[3]] == Padding) { full_quad_count--; remainder = 3; }
-            }
+// -----------------------------------------------------------------------------
+//                                 One shot
+// -----------------------------------------------------------------------------
 
-            // Compute size
-            usz expected_size = full_quad_count * 3;
-            switch (remainder) {
-                break;case 2: expected_size += 1;
-                break;case 3: expected_size += 2;
+        constexpr
+        usz EncodedSize(usz size, bool pad = true) noexcept
+        {
+            usz encoded = (size / 3) * 4;
+            switch (size % 3) {
+                break;case 1: encoded += pad ? 4 : 2; // xx==
+                break;case 2: encoded += pad ? 4 : 3; // xxx=
             }
+            return encoded;
+        }
 
-            if (expected_size > output_size) return expected_size;
-
-            for (usz i = 0; i < full_quad_count; ++i) {
-                usz di = i * 3;
-                usz ei = i * 4;
-                u8 e0 = table.decode[encoded[ei + 0]];
-                u8 e1 = table.decode[encoded[ei + 1]];
-                u8 e2 = table.decode[encoded[ei + 2]];
-                u8 e3 = table.decode[encoded[ei + 3]];
-                data[di + 0] = (e0 << 2) | (e1 >> 4);
-                data[di + 1] = (e1 << 4) | (e2 >> 2);
-                data[di + 2] = (e2 << 6) |  e3;
-            }
+        // Returns the encoded size. Output is only written if output_size is large enough
+        usz Encode(void* output, usz output_size, const void* input, usz size, bool pad = true, const Table& table = tables::Default);
 
-            if (remainder) {
-                usz di = full_quad_count * 3;
-                usz ei = full_quad_count * 4;
-                u8 e0 = table.decode[encoded[ei + 0]];
-                u8 e1 = table.decode[encoded[ei + 1]];
-                u8 e2 = table.decode[encoded[ei + 2]];
-                                    data[di + 0] = (e0 << 2) | (e1 >> 4);
-                if (remainder == 3) data[di + 1] = (e1 << 4) | (e2 >> 2);
-            }
-
-            return expected_size;
-        }
+        // Returns the decoded size. Output is only written if output_size is large enough,
+        // in which case the input is strictly validated: only table characters, padding
+        // only at the end, and zero trailing bits. Unpadded input is accepted.
+        // Throws on malformed input.
+        usz Decode(void* output, usz output_size, const void* input, usz size, const Table& table = tables::Default);
 
         inline
         std::string EncodeToString(Span<b8> bytes, bool pad = true, const Table& table = tables::Default)
         {
-            std::string str(Encode(nullptr, 0, bytes.data(), bytes.size(), pad, table), '\0');
+            std::string str(EncodedSize(bytes.size(), pad), '\0');
             Encode(str.data(), str.size(), bytes.data(), bytes.size(), pad, table);
             return str;
         }
@@ -162,5 +114,68 @@ namespace nova
             Decode(dec.data(), dec.size(), encoded.data(), encoded.size(), table);
             return dec;
         }
+
+// -----------------------------------------------------------------------------
+//                                 Streaming
+// -----------------------------------------------------------------------------
+
+        // Encodes input in arbitrary sized chunks, carrying partial triples between calls
+        struct Encoder
+        {
+            const Table* table = &tables::Default;
+            bool           pad = true;
+            u8        carry[2] = {};
+            u32    carry_count = 0;
+
+        public:
+            Encoder() = default;
+
+            Encoder(const Table& _table, bool _pad = true)
+                : table(&_table)
+                , pad(_pad)
+            {}
+
+            // Upper bound on output written by Update for a chunk of the given size
+            usz MaxUpdateSize(usz size) const noexcept
+            {
+                return ((carry_count + size) / 3) * 4;
+            }
+
+            // Returns the number of characters written
+            usz Update(char* output, const void* input, usz size);
+
+            // Writes up to 4 characters and resets the encoder
+            usz Finish(char* output);
+        };
+
+        // Decodes input in arbitrary sized chunks, carrying partial quads between calls.
+        // Validation matches Decode, and errors report offsets in the overall stream.
+        struct Decoder
+        {
+            const Table* table = &tables::Default;
+            char      carry[4] = {};
+            u32    carry_count = 0;
+            u64       consumed = 0;
+            bool      finished = false;
+
+        public:
+            Decoder() = default;
+
+            Decoder(const Table& _table)
+                : table(&_table)
+            {}
+
+            // Upper bound on output written by Update for a chunk of the given size
+            usz MaxUpdateSize(usz size) const noexcept
+            {
+                return ((carry_count + size) / 4) * 3;
+            }
+
+            // Returns the number of bytes written
+            usz Update(b8* output, const void* input, usz size);
+
+            // Writes up to 2 bytes from an unpadded tail and resets the decoder
+            usz Finish(b8* output);
+        };
     }
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <chrono>
 #include <climits>
 #include <concepts>
@@ -47,6 +48,7 @@
 #include <ranges>
 #include <source_location>
 #include <span>
+#include <memory_resource>
 
 // -----------------------------------------------------------------------------
 //                            Standard Namespaces
@@ -598,13 +600,13 @@ namespace nova
 // -----------------------------------------------------------------------------
 
 inline
-void* __cdecl operator new[](size_t size, const char* /* name */, int /* flags */, unsigned /* debug_flags */, const char* /* file */, int /* line */)
+void* operator new[](size_t size, const char* /* name */, int /* flags */, unsigned /* debug_flags */, const char* /* file */, int /* line */)
 {
 	return ::operator new(size);
 }
 
 inline
-void* __cdecl operator new[](size_t size, size_t align, size_t /* ??? */, const char* /* name */, int /* flags */, unsigned /* debug_flags */, const char* /* file */, int /* line */)
+void* operator new[](size_t size, size_t align, size_t /* ??? */, const char* /* name */, int /* flags */, unsigned /* debug_flags */, const char* /* file */, int /* line */)
 {
     return ::operator new(size, std::align_val_t(align));
 }
@@ -618,6 +620,17 @@ void* __cdecl operator new[](size_t size, size_t align, size_t /* ??? */, const
 #define NOVA_NO_INLINE __declspec(noinline)
 #define NOVA_FORCE_INLINE __forceinline
 
+// MSVC allows any intrinsic without per-function opt-in
+#define NOVA_TARGET(isa)
+
+#else
+
+#define NOVA_NO_INLINE __attribute__((noinline))
+#define NOVA_FORCE_INLINE inline __attribute__((always_inline))
+
+// Enables an instruction set for a single function, for use behind runtime dispatch
+#define NOVA_TARGET(isa) __attribute__((target(isa)))
+
 #endif
 
 // -----------------------------------------------------------------------------
@@ -754,7 +767,7 @@ namespace nova
     };
     NOVA_DECORATE_FLAG_ENUM(FreeType)
 
-    void* AllocVirtual(AllocationType type, usz size);
+    void* AllocVirtual(AllocationType type, usz size, void* address = nullptr);
     void FreeVirtual(FreeType type, void* ptr, usz size = 0);
 
     inline
@@ -1012,18 +1025,29 @@ namespace nova
     template<typename CharT>
     class CString
     {
+    public:
+        // Short conversions are terminated in place instead of on the heap
+        static constexpr usz InlineCapacity = 64;
+
+        static constexpr const CharT EmptyCStr[] { 0 };
+
+    private:
         const CharT* data = EmptyCStr;
         bool        owned = false;
+        CharT inline_buffer[InlineCapacity];
 
     public:
-        static constexpr const CharT EmptyCStr[] { 0 };
-
         constexpr CString() = default;
 
         constexpr CString(const CharT* _data, usz length, bool null_terminated)
         {
             if (null_terminated) {
                 data = _data;
+            } else if (length < InlineCapacity) {
+                std::copy_n(_data, length, inline_buffer);
+                inline_buffer[length] = '\0';
+
+                data = inline_buffer;
             } else {
                 auto* cstr = new CharT[length + 1];
                 std::memcpy(cstr, _data, length);
@@ -1254,19 +1278,182 @@ namespace nova
 //                                 Logging
 // -----------------------------------------------------------------------------
 
+// Levels below NOVA_LOG_COMPILE_LEVEL are compiled out of LogTrace/LogDebug/...
+#ifndef NOVA_LOG_COMPILE_LEVEL
+#  define NOVA_LOG_COMPILE_LEVEL Trace
+#endif
+
 namespace nova
 {
+    enum class LogLevel : u8
+    {
+        Trace,
+        Debug,
+        Info,
+        Warn,
+        Error,
+        Fatal,
+        Off,
+    };
+
+    inline constexpr LogLevel CompileLogLevel = LogLevel::NOVA_LOG_COMPILE_LEVEL;
+
+    struct LogEntry
+    {
+        LogLevel                              level;
+        u32                                  thread;
+        std::chrono::system_clock::time_point  time;
+        std::string_view                    message;
+    };
+
+    // Sinks are only ever called from the logging thread
+    struct LogSink
+    {
+        virtual ~LogSink() = default;
+
+        virtual void Write(const LogEntry& entry) = 0;
+        virtual void Flush() {}
+    };
+
+    // Info records are printed bare, other levels get a colored level tag
+    struct ConsoleLogSink : LogSink
+    {
+        std::string buffer;
+
+        void Write(const LogEntry& entry) override;
+        void Flush() override;
+    };
+
+    // One "<time> [LEVEL] [thread] message" line per record
+    struct FileLogSink : LogSink
+    {
+        std::ofstream out;
+
+        FileLogSink(const fs::path& path);
+
+        void Write(const LogEntry& entry) override;
+        void Flush() override;
+    };
+
+    // Records as { i64 time_ns, u32 thread, u8 level, u32 length, char message[length] }
+    struct BinaryLogSink : LogSink
+    {
+        std::ofstream out;
+
+        BinaryLogSink(const fs::path& path);
+
+        void Write(const LogEntry& entry) override;
+        void Flush() override;
+    };
+
+    // Minimum level for records to be recorded at all
+    void     SetLogLevel(LogLevel level);
+    LogLevel GetLogLevel();
+
+    // Records at or above this level block until they have been written by all sinks
+    void SetLogFlushLevel(LogLevel level);
+
+    void AddLogSink(std::shared_ptr<LogSink> sink);
+    void ClearLogSinks();
+
+    // Blocks until all records logged before the call have been written and flushed
+    void FlushLog();
+
+    std::string_view LogLevelToString(LogLevel level);
+
+    namespace detail
+    {
+        // Records are formatted on the logging thread. Arithmetic and enum arguments are
+        // copied in to the record and formatted there, anything else (which may reference
+        // memory owned by the caller) is formatted eagerly on the calling thread.
+        struct LogRecord
+        {
+            static constexpr usz PayloadSize = 96;
+
+            using FormatFn = void(*)(LogRecord& record, std::string& out);
+
+            FormatFn          format;
+            fmt::string_view fmt_str;
+            i64                 time;
+            u32               thread;
+            LogLevel           level;
+
+            alignas(16) b8 payload[PayloadSize];
+        };
+
+        template<typename T>
+        concept DeferredLogArg = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+        template<typename... Args>
+        void FormatDeferredLogRecord(LogRecord& record, std::string& out)
+        {
+            auto& args = *std::launder(reinterpret_cast<std::tuple<Args...>*>(record.payload));
+            std::apply([&](auto&... arg) {
+                fmt::vformat_to(std::back_inserter(out), record.fmt_str, fmt::make_format_args(arg...));
+            }, args);
+        }
+
+        void SetLogRecordText(LogRecord& record, fmt::string_view fmt_str, fmt::format_args args);
+        void PushLogRecord(LogRecord& record);
+
+        inline std::atomic<LogLevel> RuntimeLogLevel = LogLevel::Info;
+    }
+
+    template<typename ...Args>
+    void LogAt(LogLevel level, const fmt::format_string<Args...> fmt, Args&&... args)
+    {
+        if (level < detail::RuntimeLogLevel.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        using ArgsTuple = std::tuple<std::remove_cvref_t<Args>...>;
+
+        detail::LogRecord record;
+        record.level = level;
+        record.time = std::chrono::system_clock::now().time_since_epoch().count();
+
+        if constexpr ((detail::DeferredLogArg<std::remove_cvref_t<Args>> && ...)
+                && sizeof(ArgsTuple) <= detail::LogRecord::PayloadSize
+                && alignof(ArgsTuple) <= 16) {
+            record.fmt_str = fmt.get();
+            record.format = &detail::FormatDeferredLogRecord<std::remove_cvref_t<Args>...>;
+            new (record.payload) ArgsTuple(args...);
+        } else {
+            detail::SetLogRecordText(record, fmt.get(), fmt::make_format_args(args...));
+        }
+
+        detail::PushLogRecord(record);
+    }
+
     inline
     void Log(StringView str)
     {
-        std::cout << str << '\n';
+        LogAt(LogLevel::Info, "{}", std::string_view(str));
     }
 
     template<typename ...Args>
     void Log(const fmt::format_string<Args...> fmt, Args&&... args)
     {
-        std::cout << Fmt(fmt, std::forward<Args>(args)...) << '\n';
+        LogAt(LogLevel::Info, fmt, std::forward<Args>(args)...);
+    }
+
+#define NOVA_DECLARE_LOG_LEVEL_FN(Level)                                          \
+    template<typename ...Args>                                                    \
+    void Log##Level(const fmt::format_string<Args...> fmt, Args&&... args)        \
+    {                                                                             \
+        if constexpr (LogLevel::Level >= CompileLogLevel) {                       \
+            LogAt(LogLevel::Level, fmt, std::forward<Args>(args)...);             \
+        }                                                                         \
     }
+
+    NOVA_DECLARE_LOG_LEVEL_FN(Trace)
+    NOVA_DECLARE_LOG_LEVEL_FN(Debug)
+    NOVA_DECLARE_LOG_LEVEL_FN(Info)
+    NOVA_DECLARE_LOG_LEVEL_FN(Warn)
+    NOVA_DECLARE_LOG_LEVEL_FN(Error)
+    NOVA_DECLARE_LOG_LEVEL_FN(Fatal)
+
+#undef NOVA_DECLARE_LOG_LEVEL_FN
 }
 
 // -----------------------------------------------------------------------------
@@ -1286,9 +1473,9 @@ namespace nova
         void LogContents()
         {
             if (HasStack()) {
-                Log("────────────────────────────────────────────────────────────────────────────────\n{}", Stack());
+                LogError("────────────────────────────────────────────────────────────────────────────────\n{}", Stack());
             }
-            Log("────────────────────────────────────────────────────────────────────────────────\n"
+            LogError("────────────────────────────────────────────────────────────────────────────────\n"
                 "Error: {}\n"
                 "────────────────────────────────────────────────────────────────────────────────",
                 What());
@@ -1609,36 +1796,299 @@ namespace nova::env
 }
 
 // -----------------------------------------------------------------------------
-//                          Nova Supplementary Stack
+//                          Process Resource Usage
 // -----------------------------------------------------------------------------
 
-namespace nova::detail
+namespace nova::env
 {
-    struct ThreadStack
+    struct MemoryUsage
     {
-        std::byte* ptr;
+        usz      resident = 0;
+        usz peak_resident = 0;
+    };
 
-        std::byte* beg;
-        std::byte* end;
+    // User + kernel time consumed by the calling thread
+    std::chrono::nanoseconds GetThreadCpuTime();
 
-        static constexpr usz StackSize = 128ull * 1024 * 1024;
+    MemoryUsage GetProcessMemoryUsage();
+}
+
+// -----------------------------------------------------------------------------
+//                          Virtual Memory Arenas
+// -----------------------------------------------------------------------------
+
+namespace nova
+{
+    // Linear allocator over a single reserved range of virtual memory.
+    // Pages are committed lazily in CommitGranularity blocks as the head advances,
+    // so large reservations only cost address space until they are used.
+    class Arena
+    {
+        b8*      base = nullptr;
+        b8*      head = nullptr;
+        b8* committed = nullptr;
+        b8*      end  = nullptr;
+
+        usz commit_granularity = 0;
 
     public:
-        ThreadStack()
-            : ptr(static_cast<std::byte *>(AllocVirtual(AllocationType::Commit | AllocationType::Reserve, StackSize)))
-            , beg(ptr)
-            , end(ptr + StackSize)
+        static constexpr usz DefaultReserve     = 1ull << 30;
+        static constexpr usz DefaultGranularity = 64ull * 1024;
+
+        using Marker = b8*;
+
+    public:
+        Arena() = default;
+
+        explicit Arena(usz reserve_size, usz granularity = DefaultGranularity)
+            : commit_granularity(granularity)
+        {
+            reserve_size = AlignUpPower2(reserve_size, granularity);
+            base = static_cast<b8*>(AllocVirtual(AllocationType::Reserve, reserve_size));
+            if (!base) {
+                NOVA_THROW("Arena - Failed to reserve {} of virtual memory", ByteSizeToString(reserve_size));
+            }
+            head = base;
+            committed = base;
+            end = base + reserve_size;
+        }
+
+        ~Arena()
+        {
+            if (base) {
+                FreeVirtual(FreeType::Release, base, Reserved());
+            }
+        }
+
+        Arena(Arena&& other) noexcept
+            : base(std::exchange(other.base, nullptr))
+            , head(std::exchange(other.head, nullptr))
+            , committed(std::exchange(other.committed, nullptr))
+            , end(std::exchange(other.end, nullptr))
+            , commit_granularity(other.commit_granularity)
         {}
 
-        ~ThreadStack()
+        Arena& operator=(Arena&& other) noexcept
         {
-            FreeVirtual(FreeType::Decommit, ptr);
+            if (this != &other) {
+                this->~Arena();
+                new (this) Arena(std::move(other));
+            }
+            return *this;
         }
 
-        size_t RemainingBytes()
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+// -----------------------------------------------------------------------------
+
+        void* Alloc(usz size, usz align = 16)
         {
-            return size_t(end - ptr);
+            b8* ptr = AlignUpPower2(head, align);
+            b8* new_head = ptr + size;
+            if (new_head > committed) [[unlikely]] {
+                Commit(new_head);
+            }
+            head = new_head;
+            return ptr;
         }
+
+        template<typename T>
+        T* Alloc(usz count = 1)
+        {
+            return static_cast<T*>(Alloc(sizeof(T) * count, std::max(alignof(T), usz(16))));
+        }
+
+        template<typename T, typename... Args>
+        T* New(Args&&... args)
+        {
+            return new (Alloc(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        // Attempts to extend the most recent allocation in place
+        bool TryGrow(void* ptr, usz old_size, usz new_size)
+        {
+            if (static_cast<b8*>(ptr) + old_size != head) {
+                return false;
+            }
+            b8* new_head = static_cast<b8*>(ptr) + new_size;
+            if (new_head > committed) {
+                Commit(new_head);
+            }
+            head = new_head;
+            return true;
+        }
+
+// -----------------------------------------------------------------------------
+
+        Marker GetMarker() const noexcept
+        {
+            return head;
+        }
+
+        void Rewind(Marker marker) noexcept
+        {
+            head = marker;
+        }
+
+        void Reset() noexcept
+        {
+            head = base;
+        }
+
+        // Returns committed pages beyond the current head (rounded to granularity) to the OS
+        void Trim()
+        {
+            b8* keep = AlignUpPower2(head, commit_granularity);
+            if (keep < committed) {
+                FreeVirtual(FreeType::Decommit, keep, usz(committed - keep));
+                committed = keep;
+            }
+        }
+
+// -----------------------------------------------------------------------------
+
+        bool Owns(const void* ptr) const noexcept
+        {
+            return ptr >= base && ptr < end;
+        }
+
+        usz Used()      const noexcept { return usz(head - base);      }
+        usz Committed() const noexcept { return usz(committed - base); }
+        usz Reserved()  const noexcept { return usz(end - base);       }
+        usz Remaining() const noexcept { return usz(end - head);       }
+
+    private:
+        void Commit(b8* new_head)
+        {
+            if (new_head > end) {
+                NOVA_THROW("Arena - Overflow, requested {} with {} reserved",
+                    ByteSizeToString(usz(new_head - base)), ByteSizeToString(Reserved()));
+            }
+            b8* new_committed = std::min(AlignUpPower2(new_head, commit_granularity), end);
+            if (!AllocVirtual(AllocationType::Commit, usz(new_committed - committed), committed)) {
+                NOVA_THROW("Arena - Failed to commit {}", ByteSizeToString(usz(new_committed - committed)));
+            }
+            committed = new_committed;
+        }
+    };
+
+// -----------------------------------------------------------------------------
+
+    // Restores an arena to the marker taken at construction when leaving scope
+    class ArenaScope
+    {
+        Arena&               arena;
+        Arena::Marker       marker;
+
+    public:
+        explicit ArenaScope(Arena& _arena) noexcept
+            : arena(_arena)
+            , marker(_arena.GetMarker())
+        {}
+
+        ~ArenaScope() noexcept
+        {
+            arena.Rewind(marker);
+        }
+
+        ArenaScope(const ArenaScope&) = delete;
+        auto operator=(const ArenaScope&) = delete;
+        ArenaScope(ArenaScope&&) = delete;
+        auto operator=(ArenaScope&&) = delete;
+    };
+
+// -----------------------------------------------------------------------------
+
+    // Ring of arenas for per-frame transient data. Memory allocated in a frame
+    // stays valid until the same frame slot is begun again (frames in flight later).
+    class FrameArena
+    {
+        std::vector<Arena> frames;
+        u32                 index = 0;
+
+    public:
+        FrameArena(u32 frames_in_flight, usz reserve_size = Arena::DefaultReserve)
+        {
+            frames.reserve(frames_in_flight);
+            for (u32 i = 0; i < frames_in_flight; ++i) {
+                frames.emplace_back(reserve_size);
+            }
+        }
+
+        Arena& BeginFrame()
+        {
+            index = (index + 1) % u32(frames.size());
+            frames[index].Reset();
+            return frames[index];
+        }
+
+        Arena& Current() noexcept
+        {
+            return frames[index];
+        }
+
+        void* Alloc(usz size, usz align = 16)
+        {
+            return frames[index].Alloc(size, align);
+        }
+
+        template<typename T>
+        T* Alloc(usz count = 1)
+        {
+            return frames[index].Alloc<T>(count);
+        }
+    };
+
+// -----------------------------------------------------------------------------
+
+    // Adapter for std::pmr containers. Deallocation only reclaims memory when
+    // freeing the most recent allocation, all else is reclaimed on arena rewind.
+    class ArenaResource : public std::pmr::memory_resource
+    {
+        Arena* arena;
+
+    public:
+        explicit ArenaResource(Arena& _arena) noexcept
+            : arena(&_arena)
+        {}
+
+    private:
+        void* do_allocate(usz bytes, usz align) override
+        {
+            return arena->Alloc(bytes, align);
+        }
+
+        void do_deallocate(void* ptr, usz bytes, usz) override
+        {
+            if (static_cast<b8*>(ptr) + bytes == arena->GetMarker()) {
+                arena->Rewind(static_cast<b8*>(ptr));
+            }
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            auto* other_arena = dynamic_cast<const ArenaResource*>(&other);
+            return other_arena && other_arena->arena == arena;
+        }
+    };
+}
+
+// -----------------------------------------------------------------------------
+//                          Nova Supplementary Stack
+// -----------------------------------------------------------------------------
+
+namespace nova::detail
+{
+    // Per-thread scratch arena. Reserves address space only, pages are committed on first use
+    struct ThreadStack : Arena
+    {
+        static constexpr usz StackSize = 4ull * 1024 * 1024 * 1024;
+
+    public:
+        ThreadStack()
+            : Arena(StackSize)
+        {}
     };
 
     NOVA_FORCE_INLINE
@@ -1650,16 +2100,16 @@ namespace nova::detail
 
     class ThreadStackPoint
     {
-        std::byte* ptr;
+        Arena::Marker marker;
 
     public:
-        ThreadStackPoint() noexcept
-            : ptr(GetThreadStack().ptr)
+        ThreadStackPoint()
+            : marker(GetThreadStack().GetMarker())
         {}
 
         ~ThreadStackPoint() noexcept
         {
-            GetThreadStack().ptr = ptr;
+            GetThreadStack().Rewind(marker);
         }
 
         ThreadStackPoint(const ThreadStackPoint&) = delete;
@@ -1671,10 +2121,7 @@ namespace nova::detail
     template<typename T>
     T* StackAlloc(usz count)
     {
-        auto& stack = GetThreadStack();
-        T* ptr = reinterpret_cast<T*>(stack.ptr);
-        stack.ptr = AlignUpPower2(stack.ptr + sizeof(T) * count, 16);
-        return ptr;
+        return GetThreadStack().Alloc<T>(count);
     }
 }
 
@@ -54,12 +54,16 @@ namespace nova
 
         void Read(void* out, size_t bytes)
         {
-            fread(out, 1, bytes, file);
+            if (fread(out, 1, bytes, file) != bytes) {
+                NOVA_THROW("Failed to read {} bytes from file", bytes);
+            }
         }
 
         void Write(const void* in, size_t bytes)
         {
-            fwrite(in, 1, bytes, file);
+            if (fwrite(in, 1, bytes, file) != bytes) {
+                NOVA_THROW("Failed to write {} bytes to file", bytes);
+            }
         }
 
         void Seek(int64_t offset, Position location = Start)
@@ -88,7 +92,9 @@ namespace nova
             std::vector<char> buffer(file_size);
 
             file.seekg(0);
-            file.read(buffer.data(), file_size);
+            if (!file.read(buffer.data(), file_size)) {
+                NOVA_THROW("Failed to read file: [{}]", filename);
+            }
 
             file.close();
             return buffer;
@@ -0,0 +1,880 @@
+#include "nova_Hash.hpp"
+#include "nova_Files.hpp"
+#include "nova_JobSystem.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#  define NOVA_HASH_X86
+#  include <immintrin.h>
+#  ifdef _MSC_VER
+#    include <intrin.h>
+#  endif
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#  define NOVA_HASH_NEON
+#  include <arm_neon.h>
+#endif
+
+// XXH3 (https://github.com/Cyan4973/xxHash), limited to the default secret and seeds
+
+namespace nova::hash
+{
+    namespace
+    {
+        constexpr u64 Prime32_1 = 0x9E3779B1;
+        constexpr u64 Prime32_2 = 0x85EBCA77;
+        constexpr u64 Prime32_3 = 0xC2B2AE3D;
+        constexpr u64 Prime64_1 = 0x9E3779B185EBCA87;
+        constexpr u64 Prime64_2 = 0xC2B2AE3D27D4EB4F;
+        constexpr u64 Prime64_3 = 0x165667B19E3779F9;
+        constexpr u64 Prime64_4 = 0x85EBCA77C2B2AE63;
+        constexpr u64 Prime64_5 = 0x27D4EB2F165667C5;
+        constexpr u64 PrimeMx1  = 0x165667919E3779F9;
+        constexpr u64 PrimeMx2  = 0x9FB21C651E98DF25;
+
+        constexpr usz SecretSize      = 192;
+        constexpr usz StripeSize      = 64;
+        constexpr usz StripesPerBlock = (SecretSize - StripeSize) / 8;
+        constexpr usz MidSizeMax      = 240;
+
+        // Secret offsets for the final stripe and for merging accumulators
+        constexpr usz LastStripeSecret = SecretSize - StripeSize - 7;
+        constexpr usz MergeSecret      = 11;
+
+        alignas(64) constexpr u8 DefaultSecret[SecretSize] = {
+            0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+            0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+            0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+            0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+            0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+            0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+            0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+            0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+            0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+            0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+            0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+            0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+        };
+
+        constexpr u64 InitialAcc[8] = {
+            Prime32_3, Prime64_1, Prime64_2, Prime64_3, Prime64_4, Prime32_2, Prime64_5, Prime32_1,
+        };
+
+        // All supported targets are little endian
+        u32 Read32(const u8* p)
+        {
+            u32 v;
+            std::memcpy(&v, p, 4);
+            return v;
+        }
+
+        u64 Read64(const u8* p)
+        {
+            u64 v;
+            std::memcpy(&v, p, 8);
+            return v;
+        }
+
+        void Write64(u8* p, u64 v)
+        {
+            std::memcpy(p, &v, 8);
+        }
+
+        Digest Multiply128(u64 a, u64 b)
+        {
+#if defined(_MSC_VER) && defined(_M_X64)
+            Digest r;
+            r.low = _umul128(a, b, &r.high);
+            return r;
+#elif defined(_MSC_VER)
+            return { a * b, __umulh(a, b) };
+#else
+            using u128 = unsigned __int128;
+            auto product = u128(a) * b;
+            return { u64(product), u64(product >> 64) };
+#endif
+        }
+
+        u64 MultiplyFold64(u64 a, u64 b)
+        {
+            auto product = Multiply128(a, b);
+            return product.low ^ product.high;
+        }
+
+        u64 XorShift(u64 v, i32 shift)
+        {
+            return v ^ (v >> shift);
+        }
+
+        u64 AvalancheXXH64(u64 h)
+        {
+            h = XorShift(h, 33) * Prime64_2;
+            h = XorShift(h, 29) * Prime64_3;
+            return XorShift(h, 32);
+        }
+
+        u64 Avalanche(u64 h)
+        {
+            h = XorShift(h, 37) * PrimeMx1;
+            return XorShift(h, 32);
+        }
+
+        u64 Rrmxmx(u64 h, u64 size)
+        {
+            h ^= std::rotl(h, 49) ^ std::rotl(h, 24);
+            h *= PrimeMx2;
+            h ^= (h >> 35) + size;
+            h *= PrimeMx2;
+            return XorShift(h, 28);
+        }
+
+        u64 Mix16(const u8* in, const u8* secret, u64 seed)
+        {
+            return MultiplyFold64(Read64(in) ^ (Read64(secret) + seed), Read64(in + 8) ^ (Read64(secret + 8) - seed));
+        }
+
+        Digest Mix32(Digest acc, const u8* in1, const u8* in2, const u8* secret, u64 seed)
+        {
+            acc.low  += Mix16(in1, secret, seed);
+            acc.low  ^= Read64(in2) + Read64(in2 + 8);
+            acc.high += Mix16(in2, secret + 16, seed);
+            acc.high ^= Read64(in1) + Read64(in1 + 8);
+            return acc;
+        }
+
+        void DeriveSecret(u8* secret, u64 seed)
+        {
+            for (usz i = 0; i < SecretSize; i += 16) {
+                Write64(secret + i,     Read64(DefaultSecret + i)     + seed);
+                Write64(secret + i + 8, Read64(DefaultSecret + i + 8) - seed);
+            }
+        }
+
+// -----------------------------------------------------------------------------
+//                          64-bit short and mid size
+// -----------------------------------------------------------------------------
+
+        u64 Hash64Short(const u8* in, usz size, u64 seed)
+        {
+            const u8* secret = DefaultSecret;
+
+            if (size > 8) {
+                u64 lo = Read64(in)            ^ ((Read64(secret + 24) ^ Read64(secret + 32)) + seed);
+                u64 hi = Read64(in + size - 8) ^ ((Read64(secret + 40) ^ Read64(secret + 48)) - seed);
+                return Avalanche(size + std::byteswap(lo) + hi + MultiplyFold64(lo, hi));
+            }
+
+            if (size >= 4) {
+                seed ^= u64(std::byteswap(u32(seed))) << 32;
+                u64 input = Read32(in + size - 4) + (u64(Read32(in)) << 32);
+                return Rrmxmx(input ^ ((Read64(secret + 8) ^ Read64(secret + 16)) - seed), size);
+            }
+
+            if (size > 0) {
+                u32 combined = (u32(in[0]) << 16) | (u32(in[size >> 1]) << 24) | u32(in[size - 1]) | (u32(size) << 8);
+                return AvalancheXXH64(combined ^ ((Read32(secret) ^ Read32(secret + 4)) + seed));
+            }
+
+            return AvalancheXXH64(seed ^ Read64(secret + 56) ^ Read64(secret + 64));
+        }
+
+        u64 Hash64Mid(const u8* in, usz size, u64 seed)
+        {
+            const u8* secret = DefaultSecret;
+            u64 acc = size * Prime64_1;
+
+            if (size <= 128) {
+                if (size > 32) {
+                    if (size > 64) {
+                        if (size > 96) {
+                            acc += Mix16(in + 48,        secret + 96,  seed);
+                            acc += Mix16(in + size - 64, secret + 112, seed);
+                        }
+                        acc += Mix16(in + 32,        secret + 64, seed);
+                        acc += Mix16(in + size - 48, secret + 80, seed);
+                    }
+                    acc += Mix16(in + 16,        secret + 32, seed);
+                    acc += Mix16(in + size - 32, secret + 48, seed);
+                }
+                acc += Mix16(in,             secret,      seed);
+                acc += Mix16(in + size - 16, secret + 16, seed);
+                return Avalanche(acc);
+            }
+
+            for (usz i = 0; i < 8; ++i) {
+                acc += Mix16(in + 16 * i, secret + 16 * i, seed);
+            }
+            acc = Avalanche(acc);
+            for (usz i = 8; i < size / 16; ++i) {
+                acc += Mix16(in + 16 * i, secret + 16 * (i - 8) + 3, seed);
+            }
+            acc += Mix16(in + size - 16, secret + 136 - 17, seed);
+            return Avalanche(acc);
+        }
+
+// -----------------------------------------------------------------------------
+//                          128-bit short and mid size
+// -----------------------------------------------------------------------------
+
+        Digest Hash128Short(const u8* in, usz size, u64 seed)
+        {
+            const u8* secret = DefaultSecret;
+
+            if (size > 8) {
+                u64 lo = Read64(in);
+                u64 hi = Read64(in + size - 8);
+                auto m = Multiply128(lo ^ hi ^ ((Read64(secret + 32) ^ Read64(secret + 40)) - seed), Prime64_1);
+                m.low += u64(size - 1) << 54;
+                hi ^= (Read64(secret + 48) ^ Read64(secret + 56)) + seed;
+                m.high += hi + u64(u32(hi)) * (Prime32_2 - 1);
+                m.low ^= std::byteswap(m.high);
+
+                auto h = Multiply128(m.low, Prime64_2);
+                h.high += m.high * Prime64_2;
+                return { Avalanche(h.low), Avalanche(h.high) };
+            }
+
+            if (size >= 4) {
+                seed ^= u64(std::byteswap(u32(seed))) << 32;
+                u64 input = Read32(in) + (u64(Read32(in + size - 4)) << 32);
+                u64 keyed = input ^ ((Read64(secret + 16) ^ Read64(secret + 24)) + seed);
+
+                auto m = Multiply128(keyed, Prime64_1 + (size << 2));
+                m.high += m.low << 1;
+                m.low ^= m.high >> 3;
+                m.low = XorShift(m.low, 35) * PrimeMx2;
+                m.low = XorShift(m.low, 28);
+                m.high = Avalanche(m.high);
+                return m;
+            }
+
+            if (size > 0) {
+                u32 combined_low = (u32(in[0]) << 16) | (u32(in[size >> 1]) << 24) | u32(in[size - 1]) | (u32(size) << 8);
+                u32 combined_high = std::rotl(std::byteswap(combined_low), 13);
+                return {
+                    AvalancheXXH64(combined_low  ^ ((Read32(secret)     ^ Read32(secret + 4))  + seed)),
+                    AvalancheXXH64(combined_high ^ ((Read32(secret + 8) ^ Read32(secret + 12)) - seed)),
+                };
+            }
+
+            return {
+                AvalancheXXH64(seed ^ Read64(secret + 64) ^ Read64(secret + 72)),
+                AvalancheXXH64(seed ^ Read64(secret + 80) ^ Read64(secret + 88)),
+            };
+        }
+
+        Digest Hash128Mid(const u8* in, usz size, u64 seed)
+        {
+            const u8* secret = DefaultSecret;
+            Digest acc{ size * Prime64_1, 0 };
+
+            if (size <= 128) {
+                if (size > 32) {
+                    if (size > 64) {
+                        if (size > 96) {
+                            acc = Mix32(acc, in + 48, in + size - 64, secret + 96, seed);
+                        }
+                        acc = Mix32(acc, in + 32, in + size - 48, secret + 64, seed);
+                    }
+                    acc = Mix32(acc, in + 16, in + size - 32, secret + 32, seed);
+                }
+                acc = Mix32(acc, in, in + size - 16, secret, seed);
+            } else {
+                for (usz i = 32; i < 160; i += 32) {
+                    acc = Mix32(acc, in + i - 32, in + i - 16, secret + i - 32, seed);
+                }
+                acc = { Avalanche(acc.low), Avalanche(acc.high) };
+                for (usz i = 160; i <= size; i += 32) {
+                    acc = Mix32(acc, in + i - 32, in + i - 16, secret + 3 + i - 160, seed);
+                }
+                acc = Mix32(acc, in + size - 16, in + size - 32, secret + 136 - 17 - 16, 0 - seed);
+            }
+
+            return {
+                Avalanche(acc.low + acc.high),
+                0 - Avalanche(acc.low * Prime64_1 + acc.high * Prime64_4 + (size - seed) * Prime64_2),
+            };
+        }
+
+// -----------------------------------------------------------------------------
+//                                  Scalar
+// -----------------------------------------------------------------------------
+
+        // Accumulate consumes a run of stripes, advancing through the secret 8 bytes per stripe.
+        // Scramble is applied to the accumulators after every StripesPerBlock stripes.
+        using AccumulateKernel = void(*)(u64* acc, const u8* in, const u8* secret, usz stripes);
+        using ScrambleKernel   = void(*)(u64* acc, const u8* secret);
+
+        void AccumulateScalar(u64* acc, const u8* in, const u8* secret, usz stripes)
+        {
+            for (usz s = 0; s < stripes; ++s, in += StripeSize, secret += 8) {
+                for (usz i = 0; i < 8; ++i) {
+                    u64 data = Read64(in + 8 * i);
+                    u64 key = data ^ Read64(secret + 8 * i);
+                    acc[i ^ 1] += data;
+                    acc[i] += (key & 0xFFFF'FFFF) * (key >> 32);
+                }
+            }
+        }
+
+        void ScrambleScalar(u64* acc, const u8* secret)
+        {
+            for (usz i = 0; i < 8; ++i) {
+                acc[i] = (XorShift(acc[i], 47) ^ Read64(secret + 8 * i)) * Prime32_1;
+            }
+        }
+
+// -----------------------------------------------------------------------------
+//                                   x86
+// -----------------------------------------------------------------------------
+
+#ifdef NOVA_HASH_X86
+        // Each 64-bit lane adds the neighbouring input lane, plus the product of the low and
+        // high halves of the keyed input. Scramble multiplies each lane by a 32-bit prime
+        // as two 32x32 multiplies.
+
+        void AccumulateSSE2(u64* acc, const u8* in, const u8* secret, usz stripes)
+        {
+            auto* lanes = reinterpret_cast<__m128i*>(acc);
+            __m128i a0 = _mm_load_si128(lanes + 0);
+            __m128i a1 = _mm_load_si128(lanes + 1);
+            __m128i a2 = _mm_load_si128(lanes + 2);
+            __m128i a3 = _mm_load_si128(lanes + 3);
+
+            auto round = [](__m128i a, const u8* in, const u8* secret) {
+                __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                __m128i key = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret)));
+                __m128i product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+                a = _mm_add_epi64(a, _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2)));
+                return _mm_add_epi64(a, product);
+            };
+
+            for (usz s = 0; s < stripes; ++s, in += StripeSize, secret += 8) {
+                a0 = round(a0, in,      secret);
+                a1 = round(a1, in + 16, secret + 16);
+                a2 = round(a2, in + 32, secret + 32);
+                a3 = round(a3, in + 48, secret + 48);
+            }
+
+            _mm_store_si128(lanes + 0, a0);
+            _mm_store_si128(lanes + 1, a1);
+            _mm_store_si128(lanes + 2, a2);
+            _mm_store_si128(lanes + 3, a3);
+        }
+
+        void ScrambleSSE2(u64* acc, const u8* secret)
+        {
+            auto* lanes = reinterpret_cast<__m128i*>(acc);
+            __m128i prime = _mm_set1_epi32(i32(Prime32_1));
+            for (usz i = 0; i < 4; ++i) {
+                __m128i a = _mm_load_si128(lanes + i);
+                a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+                a = _mm_xor_si128(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret + 16 * i)));
+                __m128i low = _mm_mul_epu32(a, prime);
+                __m128i high = _mm_mul_epu32(_mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+                _mm_store_si128(lanes + i, _mm_add_epi64(low, _mm_slli_epi64(high, 32)));
+            }
+        }
+
+        NOVA_TARGET("avx2")
+        void AccumulateAVX2(u64* acc, const u8* in, const u8* secret, usz stripes)
+        {
+            auto* lanes = reinterpret_cast<__m256i*>(acc);
+            __m256i a0 = _mm256_load_si256(lanes + 0);
+            __m256i a1 = _mm256_load_si256(lanes + 1);
+
+            for (usz s = 0; s < stripes; ++s, in += StripeSize, secret += 8) {
+                __m256i d0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+                __m256i d1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 32));
+                __m256i k0 = _mm256_xor_si256(d0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret)));
+                __m256i k1 = _mm256_xor_si256(d1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret + 32)));
+                __m256i p0 = _mm256_mul_epu32(k0, _mm256_shuffle_epi32(k0, _MM_SHUFFLE(0, 3, 0, 1)));
+                __m256i p1 = _mm256_mul_epu32(k1, _mm256_shuffle_epi32(k1, _MM_SHUFFLE(0, 3, 0, 1)));
+                a0 = _mm256_add_epi64(_mm256_add_epi64(a0, _mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2))), p0);
+                a1 = _mm256_add_epi64(_mm256_add_epi64(a1, _mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2))), p1);
+            }
+
+            _mm256_store_si256(lanes + 0, a0);
+            _mm256_store_si256(lanes + 1, a1);
+        }
+
+        NOVA_TARGET("avx2")
+        void ScrambleAVX2(u64* acc, const u8* secret)
+        {
+            auto* lanes = reinterpret_cast<__m256i*>(acc);
+            __m256i prime = _mm256_set1_epi32(i32(Prime32_1));
+            for (usz i = 0; i < 2; ++i) {
+                __m256i a = _mm256_load_si256(lanes + i);
+                a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+                a = _mm256_xor_si256(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret + 32 * i)));
+                __m256i low = _mm256_mul_epu32(a, prime);
+                __m256i high = _mm256_mul_epu32(_mm256_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+                _mm256_store_si256(lanes + i, _mm256_add_epi64(low, _mm256_slli_epi64(high, 32)));
+            }
+        }
+
+        bool CpuSupports(Backend backend)
+        {
+#ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 0);
+            int max_leaf = info[0];
+
+            __cpuid(info, 1);
+            bool os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 0x6) == 0x6;
+
+            bool avx2 = false;
+            if (max_leaf >= 7) {
+                __cpuidex(info, 7, 0);
+                avx2 = os_avx && (info[1] & (1 << 5));
+            }
+#else
+            __builtin_cpu_init();
+            bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+            switch (backend) {
+                break;case Backend::SSE2: return true;
+                break;case Backend::AVX2: return avx2;
+                break;default:            return false;
+            }
+        }
+#endif
+
+// -----------------------------------------------------------------------------
+//                                   NEON
+// -----------------------------------------------------------------------------
+
+#ifdef NOVA_HASH_NEON
+        void AccumulateNeon(u64* acc, const u8* in, const u8* secret, usz stripes)
+        {
+            uint64x2_t a[4];
+            for (usz i = 0; i < 4; ++i) {
+                a[i] = vld1q_u64(acc + 2 * i);
+            }
+
+            for (usz s = 0; s < stripes; ++s, in += StripeSize, secret += 8) {
+                for (usz i = 0; i < 4; ++i) {
+                    uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(in + 16 * i));
+                    uint64x2_t key = veorq_u64(data, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+                    a[i] = vaddq_u64(a[i], vextq_u64(data, data, 1));
+                    a[i] = vmlal_u32(a[i], vmovn_u64(key), vshrn_n_u64(key, 32));
+                }
+            }
+
+            for (usz i = 0; i < 4; ++i) {
+                vst1q_u64(acc + 2 * i, a[i]);
+            }
+        }
+
+        void ScrambleNeon(u64* acc, const u8* secret)
+        {
+            uint32x2_t prime = vdup_n_u32(u32(Prime32_1));
+            for (usz i = 0; i < 4; ++i) {
+                uint64x2_t a = vld1q_u64(acc + 2 * i);
+                a = veorq_u64(a, vshrq_n_u64(a, 47));
+                a = veorq_u64(a, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+                uint64x2_t high = vshlq_n_u64(vmull_u32(vshrn_n_u64(a, 32), prime), 32);
+                vst1q_u64(acc + 2 * i, vmlal_u32(high, vmovn_u64(a), prime));
+            }
+        }
+#endif
+
+// -----------------------------------------------------------------------------
+//                                 Dispatch
+// -----------------------------------------------------------------------------
+
+        struct Kernels
+        {
+            AccumulateKernel accumulate = AccumulateScalar;
+            ScrambleKernel     scramble = ScrambleScalar;
+        };
+
+        Kernels GetKernels(Backend backend)
+        {
+            switch (backend) {
+#ifdef NOVA_HASH_X86
+                break;case Backend::SSE2: return { AccumulateSSE2, ScrambleSSE2 };
+                break;case Backend::AVX2: return { AccumulateAVX2, ScrambleAVX2 };
+#endif
+#ifdef NOVA_HASH_NEON
+                break;case Backend::Neon: return { AccumulateNeon, ScrambleNeon };
+#endif
+                break;default:            return {};
+            }
+        }
+
+        Backend DetectBackend()
+        {
+            for (auto backend : { Backend::AVX2, Backend::Neon, Backend::SSE2 }) {
+                if (IsSupported(backend)) {
+                    return backend;
+                }
+            }
+            return Backend::Scalar;
+        }
+
+        std::atomic<Backend>& GetActiveBackend()
+        {
+            static std::atomic<Backend> backend = DetectBackend();
+            return backend;
+        }
+
+        Kernels& GetActiveKernels()
+        {
+            thread_local Backend backend = Backend::Scalar;
+            thread_local Kernels kernels;
+            Backend active = GetActiveBackend().load(std::memory_order_relaxed);
+            if (active != backend) {
+                backend = active;
+                kernels = GetKernels(active);
+            }
+            return kernels;
+        }
+
+// -----------------------------------------------------------------------------
+//                                  Long
+// -----------------------------------------------------------------------------
+
+        // Block position is carried in block_stripes so that streamed input scrambles at
+        // the same points as one shot input
+        void ConsumeStripes(u64* acc, u32& block_stripes, const u8* in, usz stripes, const u8* secret, const Kernels& kernels)
+        {
+            while (stripes) {
+                usz count = std::min(stripes, StripesPerBlock - block_stripes);
+                kernels.accumulate(acc, in, secret + block_stripes * 8, count);
+                in += count * StripeSize;
+                stripes -= count;
+                block_stripes += u32(count);
+                if (block_stripes == StripesPerBlock) {
+                    kernels.scramble(acc, secret + SecretSize - StripeSize);
+                    block_stripes = 0;
+                }
+            }
+        }
+
+        // The final stripe always ends at the end of the input, overlapping the stripe before
+        void AccumulateLong(u64* acc, const u8* in, usz size, const u8* secret)
+        {
+            auto& kernels = GetActiveKernels();
+            std::memcpy(acc, InitialAcc, sizeof(InitialAcc));
+            u32 block_stripes = 0;
+            ConsumeStripes(acc, block_stripes, in, (size - 1) / StripeSize, secret, kernels);
+            kernels.accumulate(acc, in + size - StripeSize, secret + LastStripeSecret, 1);
+        }
+
+        u64 MergeAccumulators(const u64* acc, const u8* secret, u64 start)
+        {
+            u64 result = start;
+            for (usz i = 0; i < 4; ++i) {
+                result += MultiplyFold64(acc[2 * i] ^ Read64(secret + 16 * i), acc[2 * i + 1] ^ Read64(secret + 16 * i + 8));
+            }
+            return Avalanche(result);
+        }
+
+        u64 Finish64(const u64* acc, const u8* secret, u64 size)
+        {
+            return MergeAccumulators(acc, secret + MergeSecret, size * Prime64_1);
+        }
+
+        Digest Finish128(const u64* acc, const u8* secret, u64 size)
+        {
+            return {
+                MergeAccumulators(acc, secret + MergeSecret, size * Prime64_1),
+                MergeAccumulators(acc, secret + SecretSize - 64 - MergeSecret, ~(size * Prime64_2)),
+            };
+        }
+    }
+
+// -----------------------------------------------------------------------------
+//                              Backend control
+// -----------------------------------------------------------------------------
+
+    bool IsSupported(Backend backend)
+    {
+        switch (backend) {
+            break;case Backend::Scalar:
+                return true;
+#ifdef NOVA_HASH_X86
+            break;case Backend::SSE2:
+                  case Backend::AVX2:
+                return CpuSupports(backend);
+#endif
+#ifdef NOVA_HASH_NEON
+            break;case Backend::Neon:
+                return true;
+#endif
+            break;default:
+                return false;
+        }
+    }
+
+    Backend GetBackend()
+    {
+        return GetActiveBackend().load(std::memory_order_relaxed);
+    }
+
+    void SetBackend(Backend backend)
+    {
+        if (!IsSupported(backend)) {
+            NOVA_THROW("Hash backend {} is not supported", BackendToString(backend));
+        }
+        GetActiveBackend().store(backend, std::memory_order_relaxed);
+    }
+
+    const char* BackendToString(Backend backend)
+    {
+        switch (backend) {
+            break;case Backend::Scalar: return "Scalar";
+            break;case Backend::SSE2:   return "SSE2";
+            break;case Backend::AVX2:   return "AVX2";
+            break;case Backend::Neon:   return "Neon";
+        }
+        return "Unknown";
+    }
+
+// -----------------------------------------------------------------------------
+//                                  Digest
+// -----------------------------------------------------------------------------
+
+    std::string Digest::ToString() const
+    {
+        static constexpr char Hex[] = "0123456789abcdef";
+
+        std::string str(32, '\0');
+        for (u32 i = 0; i < 16; ++i) {
+            str[i]      = Hex[(high >> (60 - i * 4)) & 0xf];
+            str[i + 16] = Hex[(low  >> (60 - i * 4)) & 0xf];
+        }
+        return str;
+    }
+
+    std::optional<Digest> Digest::FromString(StringView str)
+    {
+        if (str.Size() != 32) {
+            return std::nullopt;
+        }
+
+        Digest digest;
+        auto begin = str.Data();
+        if (std::from_chars(begin,      begin + 16, digest.high, 16).ptr != begin + 16
+                || std::from_chars(begin + 16, begin + 32, digest.low, 16).ptr != begin + 32) {
+            return std::nullopt;
+        }
+        return digest;
+    }
+
+// -----------------------------------------------------------------------------
+//                                 One shot
+// -----------------------------------------------------------------------------
+
+    u64 Hash64(const void* data, usz size, u64 seed)
+    {
+        auto* in = static_cast<const u8*>(data);
+        if (size <= 16) {
+            return Hash64Short(in, size, seed);
+        }
+        if (size <= MidSizeMax) {
+            return Hash64Mid(in, size, seed);
+        }
+
+        alignas(64) u64 acc[8];
+        alignas(64) u8 secret[SecretSize];
+        if (seed) {
+            DeriveSecret(secret, seed);
+        }
+        const u8* active_secret = seed ? secret : DefaultSecret;
+        AccumulateLong(acc, in, size, active_secret);
+        return Finish64(acc, active_secret, size);
+    }
+
+    Digest Hash128(const void* data, usz size, u64 seed)
+    {
+        auto* in = static_cast<const u8*>(data);
+        if (size <= 16) {
+            return Hash128Short(in, size, seed);
+        }
+        if (size <= MidSizeMax) {
+            return Hash128Mid(in, size, seed);
+        }
+
+        alignas(64) u64 acc[8];
+        alignas(64) u8 secret[SecretSize];
+        if (seed) {
+            DeriveSecret(secret, seed);
+        }
+        const u8* active_secret = seed ? secret : DefaultSecret;
+        AccumulateLong(acc, in, size, active_secret);
+        return Finish128(acc, active_secret, size);
+    }
+
+// -----------------------------------------------------------------------------
+//                                 Streaming
+// -----------------------------------------------------------------------------
+
+    Hasher::Hasher(u64 _seed)
+    {
+        Reset(_seed);
+    }
+
+    void Hasher::Reset(u64 _seed)
+    {
+        std::memcpy(acc, InitialAcc, sizeof(InitialAcc));
+        if (_seed) {
+            DeriveSecret(secret, _seed);
+        } else {
+            std::memcpy(secret, DefaultSecret, SecretSize);
+        }
+        seed = _seed;
+        total = 0;
+        buffered = 0;
+        block_stripes = 0;
+    }
+
+    void Hasher::Update(const void* data, usz size)
+    {
+        auto* in = static_cast<const u8*>(data);
+        total += size;
+
+        // Input is only consumed once more follows it, as the final stripe is handled
+        // differently. Anything up to a full buffer is held back.
+        if (buffered + size <= BufferSize) {
+            std::memcpy(buffer + buffered, in, size);
+            buffered += u32(size);
+            return;
+        }
+
+        auto& kernels = GetActiveKernels();
+
+        if (buffered) {
+            usz fill = BufferSize - buffered;
+            std::memcpy(buffer + buffered, in, fill);
+            in += fill;
+            size -= fill;
+            ConsumeStripes(acc, block_stripes, buffer, BufferSize / StripeSize, secret, kernels);
+            buffered = 0;
+        }
+
+        if (size > BufferSize) {
+            usz stripes = (size - 1) / StripeSize;
+            ConsumeStripes(acc, block_stripes, in, stripes, secret, kernels);
+            in += stripes * StripeSize;
+            size -= stripes * StripeSize;
+
+            // Keep the last consumed stripe, as the final stripe may need part of it
+            std::memcpy(buffer + BufferSize - StripeSize, in - StripeSize, StripeSize);
+        }
+
+        std::memcpy(buffer, in, size);
+        buffered = u32(size);
+    }
+
+    void Hasher::FinishLong(u64* out) const
+    {
+        auto& kernels = GetActiveKernels();
+        std::memcpy(out, acc, sizeof(acc));
+        u32 stripes_done = block_stripes;
+
+        const u8* last = nullptr;
+        u8 last_stripe[StripeSize];
+        if (buffered >= StripeSize) {
+            ConsumeStripes(out, stripes_done, buffer, (buffered - 1) / StripeSize, secret, kernels);
+            last = buffer + buffered - StripeSize;
+        } else {
+            // Complete the final stripe from the tail of the previously consumed input
+            usz catchup = StripeSize - buffered;
+            std::memcpy(last_stripe, buffer + BufferSize - catchup, catchup);
+            std::memcpy(last_stripe + catchup, buffer, buffered);
+            last = last_stripe;
+        }
+        kernels.accumulate(out, last, secret + LastStripeSecret, 1);
+    }
+
+    u64 Hasher::Digest64() const
+    {
+        if (total <= MidSizeMax) {
+            return Hash64(buffer, total, seed);
+        }
+
+        alignas(64) u64 out[8];
+        FinishLong(out);
+        return Finish64(out, secret, total);
+    }
+
+    Digest Hasher::Digest128() const
+    {
+        if (total <= MidSizeMax) {
+            return Hash128(buffer, total, seed);
+        }
+
+        alignas(64) u64 out[8];
+        FinishLong(out);
+        return Finish128(out, secret, total);
+    }
+
+// -----------------------------------------------------------------------------
+//                                 Parallel
+// -----------------------------------------------------------------------------
+
+    Digest HashParallel(const void* data, usz size, JobSystem* jobs)
+    {
+        if (size <= TreeChunkSize) {
+            return Hash128(data, size);
+        }
+
+        // Helpers claim chunks until none are left. Jobs may only start once the caller has
+        // hashed every chunk and returned, so they share ownership of the state.
+        struct State
+        {
+            const u8*               in;
+            usz                   size;
+            std::vector<Digest> chunks;
+            std::atomic<usz>      next = 0;
+            std::atomic<usz>      done = 0;
+
+            void Run()
+            {
+                for (usz i; (i = next.fetch_add(1)) < chunks.size();) {
+                    usz offset = i * TreeChunkSize;
+                    chunks[i] = Hash128(in + offset, std::min(TreeChunkSize, size - offset));
+                    if (done.fetch_add(1) + 1 == chunks.size()) {
+                        done.notify_all();
+                    }
+                }
+            }
+        };
+
+        auto state = std::make_shared<State>();
+        state->in = static_cast<const u8*>(data);
+        state->size = size;
+        state->chunks.resize((size + TreeChunkSize - 1) / TreeChunkSize);
+
+        usz helpers = jobs ? jobs->workers.size() : usz(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+        helpers = std::min(helpers, state->chunks.size() - 1);
+
+        std::vector<std::jthread> threads;
+        for (usz i = 0; i < helpers; ++i) {
+            if (jobs) {
+                Job::Create(jobs, [state] { state->Run(); })->Submit();
+            } else {
+                threads.emplace_back([state] { state->Run(); });
+            }
+        }
+
+        state->Run();
+        for (usz done = state->done.load(); done != state->chunks.size(); done = state->done.load()) {
+            state->done.wait(done);
+        }
+
+        return Hash128(state->chunks.data(), state->chunks.size() * sizeof(Digest), size);
+    }
+
+    Digest HashFile(StringView path, JobSystem* jobs)
+    {
+        // Empty files can't be mapped
+        if (fs::file_size(path.CStr()) == 0) {
+            return Hash128(nullptr, 0);
+        }
+
+        auto file = MappedFile::Open(path);
+        NOVA_DEFER(&) { file.Destroy(); };
+        return HashParallel(file.GetAddress(), file.GetSize(), jobs);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "nova_Core.hpp"
+
+// -----------------------------------------------------------------------------
+//                              Content Hashing
+// -----------------------------------------------------------------------------
+
+// 64 and 128-bit XXH3, matching the reference implementation's output, as one shot
+// functions and a streaming Hasher. Inputs over 240 bytes are accumulated with SSE2,
+// AVX2 or NEON kernels.
+//
+// hash::Hash stays the right choice for small in-memory map keys. These are for
+// content, where digests are compared across runs and machines:
+//
+//   auto digest = hash::HashFile("assets/sponza.gltf");
+//   if (digest != cached.digest) Reimport();
+//
+//   hash::Hasher hasher;
+//   hasher.Update(key.shader);     // Field by field, so padding never reaches the hash
+//   hasher.Update(key.view_mask);
+//   u64 pipeline_hash = hasher.Digest64();
+
+namespace nova
+{
+    struct JobSystem;
+}
+
+namespace nova::hash
+{
+    struct Digest
+    {
+        u64  low = 0;
+        u64 high = 0;
+
+    public:
+        bool operator==(const Digest&) const noexcept = default;
+
+        // 32 lowercase hex characters, high half first as in the canonical XXH128 form
+        std::string ToString() const;
+        static std::optional<Digest> FromString(StringView str);
+    };
+
+// -----------------------------------------------------------------------------
+//                              Implementations
+// -----------------------------------------------------------------------------
+
+    enum class Backend : u32
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+        Neon,
+    };
+
+    // The best supported backend is selected on first use. Override for testing
+    // and benchmarking. Throws if the backend is not supported by this CPU/build.
+    bool    IsSupported(Backend backend);
+    Backend GetBackend();
+    void    SetBackend(Backend backend);
+    const char* BackendToString(Backend backend);
+
+// -----------------------------------------------------------------------------
+//                                 One shot
+// -----------------------------------------------------------------------------
+
+    u64    Hash64( const void* data, usz size, u64 seed = 0);
+    Digest Hash128(const void* data, usz size, u64 seed = 0);
+
+    inline
+    Digest Hash128(Span<b8> bytes, u64 seed = 0)
+    {
+        return Hash128(bytes.data(), bytes.size(), seed);
+    }
+
+// -----------------------------------------------------------------------------
+//                                 Streaming
+// -----------------------------------------------------------------------------
+
+    // Produces the same results as the one shot functions over the concatenated input,
+    // however it was split between Update calls. Digests may be taken at any point
+    // without disturbing the state.
+    class Hasher
+    {
+        static constexpr u32 SecretSize = 192;
+        static constexpr u32 BufferSize = 256;
+
+        alignas(64) u64           acc[8];
+        alignas(64) u8 secret[SecretSize];
+        alignas(64) u8 buffer[BufferSize];
+        u64                   total = 0;
+        u64                    seed = 0;
+        u32                buffered = 0;
+        u32           block_stripes = 0;
+
+    public:
+        explicit Hasher(u64 seed = 0);
+
+        void Reset(u64 seed = 0);
+
+        void Update(const void* data, usz size);
+
+        // Restricted to types without padding bits. Floats are accepted and hashed by
+        // representation, so -0.0 and 0.0 differ.
+        template<typename T>
+            requires std::has_unique_object_representations_v<T> || std::is_floating_point_v<T>
+        void Update(const T& value)
+        {
+            Update(&value, sizeof(T));
+        }
+
+        u64    Digest64()  const;
+        Digest Digest128() const;
+
+        u64 GetSize() const noexcept
+        {
+            return total;
+        }
+
+    private:
+        void FinishLong(u64* out) const;
+    };
+
+// -----------------------------------------------------------------------------
+//                                 Parallel
+// -----------------------------------------------------------------------------
+
+    inline constexpr usz TreeChunkSize = 4ull << 20;
+
+    // Hashes TreeChunkSize chunks concurrently, then hashes the chunk digests seeded with
+    // the total size. Equal to Hash128 for inputs of up to one chunk, and independent of
+    // the number of threads used. Not equal to Hash128 for larger inputs.
+    //
+    // Chunks are shared between the calling thread and jobs on the given job system, or
+    // threads started for the call (one per hardware thread) without one.
+    Digest HashParallel(const void* data, usz size, JobSystem* jobs = nullptr);
+
+    // Memory maps the file and hashes it with HashParallel
+    Digest HashFile(StringView path, JobSystem* jobs = nullptr);
+}
+
+template<>
+struct ankerl::unordered_dense::hash<nova::hash::Digest>
+{
+    using is_avalanching = void;
+    uint64_t operator()(const nova::hash::Digest& digest) const noexcept
+    {
+        return digest.low;
+    }
+};
+
+template<>
+struct fmt::formatter<nova::hash::Digest> : fmt::formatter<std::string_view>
+{
+    auto format(const nova::hash::Digest& digest, fmt::format_context& ctx) const
+    {
+        return fmt::formatter<std::string_view>::format(digest.ToString(), ctx);
+    }
+};
\ No newline at end of file
@@ -1,12 +1,25 @@
 #pragma once
 
 #include "nova_Core.hpp"
+#include "nova_Pool.hpp"
+#include "nova_SmallVector.hpp"
+#include "nova_Profiler.hpp"
+#include "nova_Metrics.hpp"
 
 #include <deque>
 #include <shared_mutex>
 
 namespace nova
 {
+    namespace jobs::stats
+    {
+        inline metrics::Counter   JobsSubmitted{ "jobs.submitted", "Jobs pushed onto a job system queue" };
+        inline metrics::Counter   JobsCompleted{ "jobs.completed", "Jobs run to completion by workers" };
+        inline metrics::Histogram JobRunTime   { "jobs.run_ns",    "Job task execution time" };
+    }
+
+// -----------------------------------------------------------------------------
+
     struct Job;
 
     struct Barrier : RefCounted
@@ -15,6 +28,8 @@ namespace nova
         u32                  acquired = 0;
         std::vector<Ref<Job>> pending;
 
+        NOVA_POOLED(Barrier)
+
         // void Signal()
         // {
         //     if (--counter == 0)
@@ -59,9 +74,11 @@ namespace nova
 
     struct Job : RefCounted
     {
-        JobSystem*                 system = {};
-        std::function<void()>        task;
-        std::vector<Ref<Barrier>> signals;
+        JobSystem*                    system = {};
+        std::function<void()>           task;
+        SmallVector<Ref<Barrier>, 2> signals;
+
+        NOVA_POOLED(Job)
 
         static Ref<Job> Create(JobSystem* system, std::function<void()> task)
         {
@@ -133,6 +150,8 @@ namespace nova
             JobWorkerState.worker_id = index;
             NOVA_DEFER() { JobWorkerState.worker_id = ~0u; };
 
+            NOVA_PROFILE_THREAD(Fmt("Job Worker {}", index));
+
             for (;;) {
                 // Acquire a lock
                 std::unique_lock lock{mutex};
@@ -153,7 +172,12 @@ namespace nova
                 lock.unlock();
 
                 // run job
-                job->task();
+                {
+                    NOVA_PROFILE_SCOPE("Job");
+                    metrics::ScopedTimer timer{ jobs::stats::JobRunTime };
+                    job->task();
+                }
+                jobs::stats::JobsCompleted.Add();
 
                 for (auto& signal : job->signals) {
                     // signal->Signal();
@@ -171,6 +195,7 @@ namespace nova
 
         void Submit(Ref<Job> job, bool front = false)
         {
+            jobs::stats::JobsSubmitted.Add();
             std::scoped_lock lock { mutex };
             if (front) {
                 queue.push_front(std::move(job));
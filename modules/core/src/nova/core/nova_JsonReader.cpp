@@ -0,0 +1,725 @@
+#include "nova_JsonReader.hpp"
+#include "nova_JsonWriter.hpp"
+#include "nova_Files.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#  include <emmintrin.h>
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#  include <arm_neon.h>
+#endif
+
+namespace nova
+{
+    namespace
+    {
+        constexpr u64 EvenBits = 0x5555'5555'5555'5555;
+
+        // Per byte bitmasks for one 64 byte block
+        struct BlockMasks
+        {
+            u64      quote = 0;
+            u64  backslash = 0;
+            u64         op = 0; // { } [ ] : ,
+            u64 whitespace = 0;
+        };
+
+#if defined(_M_X64) || defined(__x86_64__)
+        BlockMasks ClassifyBlock(const char* block)
+        {
+            const __m128i quote     = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i case_bit  = _mm_set1_epi8(0x20);
+            const __m128i open      = _mm_set1_epi8('{');
+            const __m128i close     = _mm_set1_epi8('}');
+            const __m128i colon     = _mm_set1_epi8(':');
+            const __m128i comma     = _mm_set1_epi8(',');
+            const __m128i space     = _mm_set1_epi8(' ');
+            const __m128i tab       = _mm_set1_epi8('\t');
+            const __m128i newline   = _mm_set1_epi8('\n');
+            const __m128i carriage  = _mm_set1_epi8('\r');
+
+            BlockMasks masks;
+            for (u32 i = 0; i < 64; i += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+
+                // '[' and ']' differ from '{' and '}' only in bit 5
+                __m128i folded = _mm_or_si128(v, case_bit);
+                __m128i op = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)),
+                    _mm_or_si128(_mm_cmpeq_epi8(v, colon), _mm_cmpeq_epi8(v, comma)));
+                __m128i ws = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+                    _mm_or_si128(_mm_cmpeq_epi8(v, newline), _mm_cmpeq_epi8(v, carriage)));
+
+                masks.quote      |= u64(u32(_mm_movemask_epi8(_mm_cmpeq_epi8(v, quote))))     << i;
+                masks.backslash  |= u64(u32(_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash)))) << i;
+                masks.op         |= u64(u32(_mm_movemask_epi8(op)))                            << i;
+                masks.whitespace |= u64(u32(_mm_movemask_epi8(ws)))                            << i;
+            }
+            return masks;
+        }
+#elif defined(_M_ARM64) || defined(__aarch64__)
+        u64 ToBitmask(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3)
+        {
+            static constexpr u8 BitWeights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+            const uint8x16_t bits = vld1q_u8(BitWeights);
+            uint8x16_t sum0 = vpaddq_u8(vandq_u8(m0, bits), vandq_u8(m1, bits));
+            uint8x16_t sum1 = vpaddq_u8(vandq_u8(m2, bits), vandq_u8(m3, bits));
+            sum0 = vpaddq_u8(sum0, sum1);
+            sum0 = vpaddq_u8(sum0, sum0);
+            return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+        }
+
+        BlockMasks ClassifyBlock(const char* block)
+        {
+            uint8x16_t quote[4], backslash[4], op[4], ws[4];
+            for (u32 i = 0; i < 4; ++i) {
+                uint8x16_t v = vld1q_u8(reinterpret_cast<const u8*>(block + i * 16));
+
+                // '[' and ']' differ from '{' and '}' only in bit 5
+                uint8x16_t folded = vorrq_u8(v, vdupq_n_u8(0x20));
+                quote[i]     = vceqq_u8(v, vdupq_n_u8('"'));
+                backslash[i] = vceqq_u8(v, vdupq_n_u8('\\'));
+                op[i] = vorrq_u8(
+                    vorrq_u8(vceqq_u8(folded, vdupq_n_u8('{')), vceqq_u8(folded, vdupq_n_u8('}'))),
+                    vorrq_u8(vceqq_u8(v, vdupq_n_u8(':')), vceqq_u8(v, vdupq_n_u8(','))));
+                ws[i] = vorrq_u8(
+                    vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')), vceqq_u8(v, vdupq_n_u8('\t'))),
+                    vorrq_u8(vceqq_u8(v, vdupq_n_u8('\n')), vceqq_u8(v, vdupq_n_u8('\r'))));
+            }
+
+            BlockMasks masks;
+            masks.quote      = ToBitmask(quote[0], quote[1], quote[2], quote[3]);
+            masks.backslash  = ToBitmask(backslash[0], backslash[1], backslash[2], backslash[3]);
+            masks.op         = ToBitmask(op[0], op[1], op[2], op[3]);
+            masks.whitespace = ToBitmask(ws[0], ws[1], ws[2], ws[3]);
+            return masks;
+        }
+#else
+        BlockMasks ClassifyBlock(const char* block)
+        {
+            BlockMasks masks;
+            for (u32 i = 0; i < 64; ++i) {
+                u64 bit = 1ull << i;
+                switch (block[i]) {
+                    break;case '"':  masks.quote |= bit;
+                    break;case '\\': masks.backslash |= bit;
+                    break;case '{': case '}': case '[': case ']': case ':': case ',':
+                        masks.op |= bit;
+                    break;case ' ': case '\t': case '\n': case '\r':
+                        masks.whitespace |= bit;
+                }
+            }
+            return masks;
+        }
+#endif
+
+        // Returns a mask of characters preceded by an odd length run of backslashes.
+        // prev_escaped carries a pending escape into the next block.
+        u64 FindEscaped(u64 backslash, u64& prev_escaped)
+        {
+            backslash &= ~prev_escaped;
+            u64 follows_escape = (backslash << 1) | prev_escaped;
+
+            // Runs starting on odd bits carry into an even bit when they have odd length
+            u64 odd_starts = backslash & ~EvenBits & ~follows_escape;
+            u64 sequences_on_even_bits = odd_starts + backslash;
+            prev_escaped = sequences_on_even_bits < odd_starts ? 1 : 0;
+            u64 invert_mask = sequences_on_even_bits << 1;
+
+            return (EvenBits ^ invert_mask) & follows_escape;
+        }
+
+        // Bit N of the result is the XOR of bits [0, N], marking the bytes between quote pairs
+        u64 PrefixXor(u64 bits)
+        {
+            bits ^= bits << 1;
+            bits ^= bits << 2;
+            bits ^= bits << 4;
+            bits ^= bits << 8;
+            bits ^= bits << 16;
+            bits ^= bits << 32;
+            return bits;
+        }
+
+        // Writes the offsets of structural characters and the first byte of every scalar
+        // and string outside of strings. Returns the number of indices written.
+        u32 IndexStructurals(const char* json, u32 size, u32* indices)
+        {
+            u32* out = indices;
+
+            u64 prev_escaped = 0;
+            u64 prev_in_string = 0;
+            u64 prev_scalar = 0;
+
+            auto process = [&](const char* block, u32 offset) {
+                BlockMasks masks = ClassifyBlock(block);
+
+                u64 quote = masks.quote & ~FindEscaped(masks.backslash, prev_escaped);
+
+                // Includes opening quotes and excludes closing quotes
+                u64 in_string = PrefixXor(quote) ^ prev_in_string;
+                prev_in_string = u64(i64(in_string) >> 63);
+                u64 string_tail = in_string ^ quote;
+
+                u64 scalar = ~(masks.op | masks.whitespace);
+                u64 nonquote_scalar = scalar & ~quote;
+                u64 follows_scalar = (nonquote_scalar << 1) | prev_scalar;
+                prev_scalar = nonquote_scalar >> 63;
+
+                u64 structurals = (masks.op | (scalar & ~follows_scalar)) & ~string_tail;
+                while (structurals) {
+                    *out++ = offset + u32(std::countr_zero(structurals));
+                    structurals &= structurals - 1;
+                }
+            };
+
+            u32 offset = 0;
+            for (; offset + 64 <= size; offset += 64) {
+                process(json + offset, offset);
+            }
+
+            if (offset < size) {
+                // Whitespace padding does not introduce any structurals
+                char tail[64];
+                std::memset(tail, ' ', sizeof(tail));
+                std::memcpy(tail, json + offset, size - offset);
+                process(tail, offset);
+            }
+
+            return u32(out - indices);
+        }
+
+// -----------------------------------------------------------------------------
+
+        constexpr auto TerminatorTable = [] {
+            std::array<bool, 256> table = {};
+            for (u8 c : { u8(' '), u8('\t'), u8('\n'), u8('\r'), u8(','), u8(':'), u8('['), u8(']'), u8('{'), u8('}') }) {
+                table[c] = true;
+            }
+            return table;
+        }();
+
+        bool IsDigit(char c) noexcept
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        i32 HexValue(char c) noexcept
+        {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        struct Parser
+        {
+            const char*      json;
+            u32              size;
+            const u32*    indices;
+            u32             count;
+            u32              next = 0;
+            Arena&          arena;
+
+            // Children are gathered here until their container is closed and its size known
+            std::vector<JsonValue>   values;
+            std::vector<JsonMember> members;
+
+        public:
+            [[noreturn]] void Error(u32 offset, std::string_view what)
+            {
+                NOVA_THROW_STACKLESS("JSON - {} at offset {}", what, offset);
+            }
+
+            char At(u32 offset) const noexcept
+            {
+                return offset < size ? json[offset] : '\0';
+            }
+
+            // Index count is always followed by an end of input sentinel
+            u32 Advance() noexcept
+            {
+                u32 offset = indices[next];
+                next += next < count;
+                return offset;
+            }
+
+            void ExpectTerminator(u32 offset)
+            {
+                if (offset < size && !TerminatorTable[u8(json[offset])]) {
+                    Error(offset, "Unexpected character after value");
+                }
+            }
+
+            void ParseLiteral(u32 offset, std::string_view literal)
+            {
+                if (size - offset < literal.size() || std::memcmp(json + offset, literal.data(), literal.size()) != 0) {
+                    Error(offset, "Invalid literal");
+                }
+                ExpectTerminator(offset + u32(literal.size()));
+            }
+
+// -----------------------------------------------------------------------------
+
+            void ParseNumber(u32 offset, JsonValue& out)
+            {
+                const char* start = json + offset;
+                const char* end = json + size;
+                const char* p = start;
+
+                bool negative = *p == '-';
+                if (negative) ++p;
+
+                if (p == end || !IsDigit(*p)) {
+                    Error(offset, "Invalid number");
+                }
+                const char* digits = p;
+                u64 mantissa = 0;
+                if (*p == '0') {
+                    ++p;
+                } else {
+                    while (p < end && IsDigit(*p)) {
+                        mantissa = mantissa * 10 + u64(*p++ - '0');
+                    }
+                }
+
+                bool is_float = false;
+                if (p < end && *p == '.') {
+                    ++p;
+                    if (p == end || !IsDigit(*p)) {
+                        Error(u32(p - json), "Expected digit after decimal point");
+                    }
+                    while (p < end && IsDigit(*p)) ++p;
+                    is_float = true;
+                }
+                if (p < end && (*p == 'e' || *p == 'E')) {
+                    ++p;
+                    if (p < end && (*p == '+' || *p == '-')) ++p;
+                    if (p == end || !IsDigit(*p)) {
+                        Error(u32(p - json), "Expected digit in exponent");
+                    }
+                    while (p < end && IsDigit(*p)) ++p;
+                    is_float = true;
+                }
+
+                ExpectTerminator(u32(p - json));
+
+                // Up to 19 digits cannot overflow the accumulator. Longer integers are
+                // rechecked and fall back to floating point if they overflow 64 bits.
+                if (!is_float) {
+                    bool fits = p - digits <= 19 || std::from_chars(digits, p, mantissa).ec == std::errc{};
+                    if (fits && !negative) {
+                        out.type = mantissa > u64(std::numeric_limits<i64>::max()) ? JsonType::UInt : JsonType::Int;
+                        out.uinteger = mantissa;
+                        return;
+                    }
+                    if (fits && mantissa <= u64(std::numeric_limits<i64>::max()) + 1) {
+                        out.type = JsonType::Int;
+                        out.integer = i64(0 - mantissa);
+                        return;
+                    }
+                }
+
+                if (std::from_chars(start, p, out.number).ec != std::errc{}) {
+                    Error(offset, "Number out of range");
+                }
+                out.type = JsonType::Float;
+            }
+
+// -----------------------------------------------------------------------------
+
+            u32 ParseHex4(u32 offset)
+            {
+                if (size - offset < 4) {
+                    Error(offset, "Truncated unicode escape");
+                }
+                u32 value = 0;
+                for (u32 i = 0; i < 4; ++i) {
+                    i32 digit = HexValue(json[offset + i]);
+                    if (digit < 0) {
+                        Error(offset + i, "Invalid unicode escape");
+                    }
+                    value = (value << 4) | u32(digit);
+                }
+                return value;
+            }
+
+            static char* AppendUtf8(char* out, u32 codepoint) noexcept
+            {
+                if (codepoint < 0x80) {
+                    *out++ = char(codepoint);
+                } else if (codepoint < 0x800) {
+                    *out++ = char(0xC0 | (codepoint >> 6));
+                    *out++ = char(0x80 | (codepoint & 0x3F));
+                } else if (codepoint < 0x10000) {
+                    *out++ = char(0xE0 | (codepoint >> 12));
+                    *out++ = char(0x80 | ((codepoint >> 6) & 0x3F));
+                    *out++ = char(0x80 | (codepoint & 0x3F));
+                } else {
+                    *out++ = char(0xF0 | (codepoint >> 18));
+                    *out++ = char(0x80 | ((codepoint >> 12) & 0x3F));
+                    *out++ = char(0x80 | ((codepoint >> 6) & 0x3F));
+                    *out++ = char(0x80 | (codepoint & 0x3F));
+                }
+                return out;
+            }
+
+            // Strings without escapes reference the source, others are unescaped into the arena
+            std::string_view ParseString(u32 offset)
+            {
+                u32 begin = offset + 1;
+                u32 pos = begin;
+                bool escaped = false;
+                for (;;) {
+                    pos += u32(detail::FindJsonSpecial(json + pos, size - pos));
+                    if (pos == size) {
+                        Error(offset, "Unterminated string");
+                    }
+                    char c = json[pos];
+                    if (c == '"') {
+                        break;
+                    }
+                    if (c != '\\') {
+                        Error(pos, "Unescaped control character in string");
+                    }
+                    escaped = true;
+                    pos += 2;
+                    if (pos > size) {
+                        Error(offset, "Unterminated string");
+                    }
+                }
+
+                if (!escaped) {
+                    return { json + begin, pos - begin };
+                }
+
+                // Escape sequences never expand, so the raw length bounds the output
+                char* str = static_cast<char*>(arena.Alloc(pos - begin, 1));
+                char* out = str;
+                for (u32 i = begin; i < pos;) {
+                    // Only backslashes remain special between the quotes
+                    u32 clean = u32(detail::FindJsonSpecial(json + i, pos - i));
+                    std::memcpy(out, json + i, clean);
+                    out += clean;
+                    i += clean;
+                    if (i == pos) {
+                        break;
+                    }
+
+                    i++;
+                    switch (json[i++]) {
+                        break;case '"':  *out++ = '"';
+                        break;case '\\': *out++ = '\\';
+                        break;case '/':  *out++ = '/';
+                        break;case 'b':  *out++ = '\b';
+                        break;case 'f':  *out++ = '\f';
+                        break;case 'n':  *out++ = '\n';
+                        break;case 'r':  *out++ = '\r';
+                        break;case 't':  *out++ = '\t';
+                        break;case 'u': {
+                            u32 codepoint = ParseHex4(i);
+                            i += 4;
+                            if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
+                                Error(i - 6, "Unpaired low surrogate");
+                            }
+                            if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+                                if (pos - i < 6 || json[i] != '\\' || json[i + 1] != 'u') {
+                                    Error(i - 6, "Unpaired high surrogate");
+                                }
+                                u32 low = ParseHex4(i + 2);
+                                if (low < 0xDC00 || low > 0xDFFF) {
+                                    Error(i, "Invalid low surrogate");
+                                }
+                                codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                                i += 6;
+                            }
+                            out = AppendUtf8(out, codepoint);
+                        }
+                        break;default:
+                            Error(i - 2, "Invalid escape sequence");
+                    }
+                }
+
+                // Release the unused tail of the worst case allocation
+                arena.Rewind(reinterpret_cast<b8*>(out));
+                return { str, usz(out - str) };
+            }
+
+// -----------------------------------------------------------------------------
+
+            template<typename T>
+            const T* Commit(std::vector<T>& stack, usz base)
+            {
+                usz count = stack.size() - base;
+                if (count == 0) {
+                    return nullptr;
+                }
+                T* items = arena.Alloc<T>(count);
+                std::memcpy(items, stack.data() + base, count * sizeof(T));
+                stack.resize(base);
+                return items;
+            }
+
+            void ParseArray(u32 offset, JsonValue& out, u32 depth)
+            {
+                usz base = values.size();
+                if (At(indices[next]) == ']') {
+                    Advance();
+                } else {
+                    for (;;) {
+                        JsonValue element;
+                        ParseValue(element, depth + 1);
+                        values.push_back(element);
+
+                        u32 separator = Advance();
+                        char c = At(separator);
+                        if (c == ']') break;
+                        if (c != ',') {
+                            Error(separator, "Expected ',' or ']' in array");
+                        }
+                    }
+                }
+
+                usz count = values.size() - base;
+                if (count > std::numeric_limits<u32>::max()) {
+                    Error(offset, "Array too large");
+                }
+                out.type = JsonType::Array;
+                out.size = u32(count);
+                out.elements = Commit(values, base);
+            }
+
+            void ParseObject(u32 offset, JsonValue& out, u32 depth)
+            {
+                usz base = members.size();
+                if (At(indices[next]) == '}') {
+                    Advance();
+                } else {
+                    for (;;) {
+                        u32 key_offset = Advance();
+                        if (At(key_offset) != '"') {
+                            Error(key_offset, "Expected string key in object");
+                        }
+
+                        JsonMember member;
+                        member.key = ParseString(key_offset);
+
+                        u32 colon = Advance();
+                        if (At(colon) != ':') {
+                            Error(colon, "Expected ':' after object key");
+                        }
+
+                        ParseValue(member.value, depth + 1);
+                        members.push_back(member);
+
+                        u32 separator = Advance();
+                        char c = At(separator);
+                        if (c == '}') break;
+                        if (c != ',') {
+                            Error(separator, "Expected ',' or '}' in object");
+                        }
+                    }
+                }
+
+                usz count = members.size() - base;
+                if (count > std::numeric_limits<u32>::max()) {
+                    Error(offset, "Object too large");
+                }
+                out.type = JsonType::Object;
+                out.size = u32(count);
+                out.members = Commit(members, base);
+            }
+
+            void ParseValue(JsonValue& out, u32 depth)
+            {
+                u32 offset = Advance();
+                if (offset >= size) {
+                    Error(size, "Unexpected end of input");
+                }
+
+                switch (json[offset]) {
+                    break;case '{':
+                        if (depth >= JsonDocument::MaxDepth) Error(offset, "Maximum nesting depth exceeded");
+                        ParseObject(offset, out, depth);
+                    break;case '[':
+                        if (depth >= JsonDocument::MaxDepth) Error(offset, "Maximum nesting depth exceeded");
+                        ParseArray(offset, out, depth);
+                    break;case '"': {
+                        auto str = ParseString(offset);
+                        out.type = JsonType::String;
+                        out.size = u32(str.size());
+                        out.string = str.data();
+                    }
+                    break;case 't':
+                        ParseLiteral(offset, "true");
+                        out.type = JsonType::Bool;
+                        out.boolean = true;
+                    break;case 'f':
+                        ParseLiteral(offset, "false");
+                        out.type = JsonType::Bool;
+                        out.boolean = false;
+                    break;case 'n':
+                        ParseLiteral(offset, "null");
+                        out.type = JsonType::Null;
+                    break;case '-': case '0': case '1': case '2': case '3': case '4':
+                          case '5': case '6': case '7': case '8': case '9':
+                        ParseNumber(offset, out);
+                    break;default:
+                        Error(offset, "Unexpected character");
+                }
+            }
+        };
+    }
+
+// -----------------------------------------------------------------------------
+
+    JsonDocument JsonDocument::Parse(std::string_view json)
+    {
+        JsonDocument document;
+        document.ParseInto(json);
+        return document;
+    }
+
+    JsonDocument JsonDocument::ParseOwned(std::vector<char> json)
+    {
+        JsonDocument document;
+        document.source = std::move(json);
+        document.ParseInto({ document.source.data(), document.source.size() });
+        return document;
+    }
+
+    JsonDocument JsonDocument::Load(const fs::path& path)
+    {
+        return ParseOwned(files::ReadBinaryFile(path.string()));
+    }
+
+    void JsonDocument::ParseInto(std::string_view json)
+    {
+        if (json.size() >= std::numeric_limits<u32>::max()) {
+            NOVA_THROW_STACKLESS("JSON - Document too large ({})", ByteSizeToString(json.size()));
+        }
+        u32 size = u32(json.size());
+
+        // Every node takes at least two source bytes (value and separator) for 16 bytes,
+        // or five bytes for a 32 byte object member, plus container alignment
+        arena = Arena(usz(size) * 8 + Arena::DefaultGranularity);
+
+        NOVA_STACK_POINT();
+        u32* indices = NOVA_STACK_ALLOC(u32, usz(size) + 1);
+        u32 count = IndexStructurals(json.data(), size, indices);
+        indices[count] = size;
+
+        Parser parser{ json.data(), size, indices, count, 0, arena };
+        parser.ParseValue(root, 0);
+        if (parser.next != count) {
+            parser.Error(indices[parser.next], "Unexpected trailing characters");
+        }
+    }
+
+// -----------------------------------------------------------------------------
+
+    const char* JsonTypeToString(JsonType type)
+    {
+        switch (type) {
+            break;case JsonType::Null:   return "null";
+            break;case JsonType::Bool:   return "bool";
+            break;case JsonType::Int:    return "int";
+            break;case JsonType::UInt:   return "uint";
+            break;case JsonType::Float:  return "float";
+            break;case JsonType::String: return "string";
+            break;case JsonType::Array:  return "array";
+            break;case JsonType::Object: return "object";
+        }
+        return "invalid";
+    }
+
+    namespace
+    {
+        [[noreturn]] void TypeError(JsonType expected, JsonType actual)
+        {
+            NOVA_THROW_STACKLESS("JSON - Expected {}, found {}", JsonTypeToString(expected), JsonTypeToString(actual));
+        }
+    }
+
+    bool JsonValue::AsBool() const
+    {
+        if (type != JsonType::Bool) TypeError(JsonType::Bool, type);
+        return boolean;
+    }
+
+    i64 JsonValue::AsI64() const
+    {
+        if (type != JsonType::Int) TypeError(JsonType::Int, type);
+        return integer;
+    }
+
+    u64 JsonValue::AsU64() const
+    {
+        if (type == JsonType::UInt || (type == JsonType::Int && integer >= 0)) {
+            return uinteger;
+        }
+        TypeError(JsonType::UInt, type);
+    }
+
+    f64 JsonValue::AsF64() const
+    {
+        switch (type) {
+            break;case JsonType::Float: return number;
+            break;case JsonType::Int:   return f64(integer);
+            break;case JsonType::UInt:  return f64(uinteger);
+            break;default: TypeError(JsonType::Float, type);
+        }
+    }
+
+    std::string_view JsonValue::AsString() const
+    {
+        if (type != JsonType::String) TypeError(JsonType::String, type);
+        return { string, size };
+    }
+
+    Span<JsonValue> JsonValue::Elements() const
+    {
+        if (type != JsonType::Array) TypeError(JsonType::Array, type);
+        return { elements, size };
+    }
+
+    Span<JsonMember> JsonValue::Members() const
+    {
+        if (type != JsonType::Object) TypeError(JsonType::Object, type);
+        return { members, size };
+    }
+
+    const JsonValue* JsonValue::Find(std::string_view key) const noexcept
+    {
+        if (type != JsonType::Object) {
+            return nullptr;
+        }
+
+        // Objects are typically small, a linear scan beats building a lookup table
+        for (u32 i = 0; i < size; ++i) {
+            if (members[i].key == key) {
+                return &members[i].value;
+            }
+        }
+        return nullptr;
+    }
+
+    const JsonValue& JsonValue::operator[](std::string_view key) const
+    {
+        if (type != JsonType::Object) TypeError(JsonType::Object, type);
+        if (auto* value = Find(key)) {
+            return *value;
+        }
+        NOVA_THROW_STACKLESS("JSON - Missing key \"{}\"", key);
+    }
+
+    const JsonValue& JsonValue::operator[](usz index) const
+    {
+        if (type != JsonType::Array) TypeError(JsonType::Array, type);
+        if (index >= size) {
+            NOVA_THROW_STACKLESS("JSON - Index {} out of range for array of size {}", index, size);
+        }
+        return elements[index];
+    }
+}
\ No newline at end of file
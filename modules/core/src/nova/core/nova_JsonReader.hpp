@@ -0,0 +1,144 @@
+#pragma once
+
+#include "nova_Core.hpp"
+
+// -----------------------------------------------------------------------------
+//                                JSON Reader
+// -----------------------------------------------------------------------------
+
+// Parses a complete document into an immutable, arena allocated DOM.
+//
+//   auto doc = JsonDocument::Load("manifest.json");
+//   for (auto& entry : doc.Root()["files"].Elements()) {
+//       Log("{} = {}", entry["path"].AsString(), entry["size"].AsU64());
+//   }
+//
+// Parsing runs in two passes. The first classifies the input 64 bytes at a time with
+// SIMD compares, resolves escaped quotes and string spans with bit arithmetic, and
+// emits the offset of every structural character and value start. The second walks
+// those offsets to build the DOM.
+//
+// Strings without escapes are views into the source buffer, so Parse requires the
+// source to outlive the document. Load and ParseOwned keep their own copy.
+//
+// Malformed input throws with the byte offset of the error.
+
+namespace nova
+{
+    enum class JsonType : u8
+    {
+        Null,
+        Bool,
+        Int,   // Fits in i64
+        UInt,  // Positive and only fits in u64
+        Float,
+        String,
+        Array,
+        Object,
+    };
+
+    struct JsonMember;
+
+    struct JsonValue
+    {
+        JsonType type = JsonType::Null;
+
+        // String length, array element count or object member count
+        u32 size = 0;
+
+        union
+        {
+            bool               boolean;
+            i64                integer;
+            u64               uinteger;
+            f64                 number;
+            const char*         string;
+            const JsonValue*  elements;
+            const JsonMember*  members;
+        };
+
+        JsonValue() noexcept : integer(0) {}
+
+// -----------------------------------------------------------------------------
+
+        bool IsNull()   const noexcept { return type == JsonType::Null;   }
+        bool IsBool()   const noexcept { return type == JsonType::Bool;   }
+        bool IsString() const noexcept { return type == JsonType::String; }
+        bool IsArray()  const noexcept { return type == JsonType::Array;  }
+        bool IsObject() const noexcept { return type == JsonType::Object; }
+
+        bool IsNumber() const noexcept
+        {
+            return type == JsonType::Int || type == JsonType::UInt || type == JsonType::Float;
+        }
+
+        bool IsInteger() const noexcept
+        {
+            return type == JsonType::Int || type == JsonType::UInt;
+        }
+
+// -----------------------------------------------------------------------------
+
+        bool             AsBool()   const;
+        i64              AsI64()    const;
+        u64              AsU64()    const;
+        f64              AsF64()    const;
+        std::string_view AsString() const;
+
+        Span<JsonValue>  Elements() const;
+        Span<JsonMember> Members()  const;
+
+        // Returns nullptr if this is not an object or the key is not present
+        const JsonValue* Find(std::string_view key) const noexcept;
+
+        // Throws if the key or index is not present
+        const JsonValue& operator[](std::string_view key) const;
+        const JsonValue& operator[](usz index) const;
+    };
+
+    struct JsonMember
+    {
+        std::string_view key;
+        JsonValue      value;
+    };
+
+    const char* JsonTypeToString(JsonType type);
+
+// -----------------------------------------------------------------------------
+
+    class JsonDocument
+    {
+        Arena              arena;
+        std::vector<char> source;
+        JsonValue           root;
+
+    public:
+        static constexpr u32 MaxDepth = 1024;
+
+    public:
+        JsonDocument() = default;
+
+        JsonDocument(JsonDocument&&) noexcept = default;
+        JsonDocument& operator=(JsonDocument&&) noexcept = default;
+
+        // The document references unescaped strings in json, which must outlive it
+        static JsonDocument Parse(std::string_view json);
+
+        static JsonDocument ParseOwned(std::vector<char> json);
+        static JsonDocument Load(const fs::path& path);
+
+        const JsonValue& Root() const noexcept
+        {
+            return root;
+        }
+
+        // Bytes used by DOM nodes and unescaped strings
+        usz MemoryUsed() const noexcept
+        {
+            return arena.Used();
+        }
+
+    private:
+        void ParseInto(std::string_view json);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "nova_JsonWriter.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#  include <emmintrin.h>
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#  include <arm_neon.h>
+#endif
+
+namespace nova
+{
+    namespace detail
+    {
+        usz FindJsonSpecial(const char* str, usz size) noexcept
+        {
+            usz i = 0;
+
+#if defined(_M_X64) || defined(__x86_64__)
+            const __m128i quote     = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i control   = _mm_set1_epi8(0x1f);
+            for (; i + 16 <= size; i += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+                __m128i special = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                    _mm_cmpeq_epi8(_mm_max_epu8(v, control), control));
+                if (u32 mask = u32(_mm_movemask_epi8(special))) {
+                    return i + std::countr_zero(mask);
+                }
+            }
+#elif defined(_M_ARM64) || defined(__aarch64__)
+            const uint8x16_t quote     = vdupq_n_u8('"');
+            const uint8x16_t backslash = vdupq_n_u8('\\');
+            const uint8x16_t control   = vdupq_n_u8(0x20);
+            for (; i + 16 <= size; i += 16) {
+                uint8x16_t v = vld1q_u8(reinterpret_cast<const u8*>(str + i));
+                uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)), vcltq_u8(v, control));
+                if (vmaxvq_u8(special)) {
+                    break;
+                }
+            }
+#endif
+
+            for (; i < size; ++i) {
+                u8 c = u8(str[i]);
+                if (c < 0x20 || c == '"' || c == '\\') {
+                    break;
+                }
+            }
+
+            return i;
+        }
+    }
+
+    JsonWriter::JsonWriter(const fs::path& path)
+    {
+#ifdef NOVA_PLATFORM_WINDOWS
+        file = _wfopen(path.c_str(), L"wb");
+#else
+        file = std::fopen(path.c_str(), "wb");
+#endif
+        if (!file) {
+            NOVA_THROW("Failed to open JSON output file: {}", path.string());
+        }
+    }
+
+    JsonWriter::~JsonWriter()
+    {
+        Flush();
+        if (file) {
+            std::fclose(file);
+        }
+    }
+
+    void JsonWriter::Flush()
+    {
+        if (buffer.empty()) {
+            return;
+        }
+
+        if (stream) {
+            stream->write(buffer.data(), std::streamsize(buffer.size()));
+        } else if (file) {
+            std::fwrite(buffer.data(), 1, buffer.size(), file);
+        } else {
+            return;
+        }
+
+        buffer.clear();
+    }
+
+    void JsonWriter::AppendString(std::string_view str)
+    {
+        static constexpr char Hex[] = "0123456789abcdef";
+
+        buffer.push_back('"');
+
+        const char* data = str.data();
+        usz remaining = str.size();
+        for (;;) {
+            usz clean = detail::FindJsonSpecial(data, remaining);
+            buffer.append(data, clean);
+            if (clean == remaining) {
+                break;
+            }
+
+            char c = data[clean];
+            switch (c) {
+                break;case '"':  buffer.append("\\\"");
+                break;case '\\': buffer.append("\\\\");
+                break;case '\b': buffer.append("\\b");
+                break;case '\f': buffer.append("\\f");
+                break;case '\n': buffer.append("\\n");
+                break;case '\r': buffer.append("\\r");
+                break;case '\t': buffer.append("\\t");
+                break;default:
+                    char escaped[] = { '\\', 'u', '0', '0', Hex[u8(c) >> 4], Hex[u8(c) & 15] };
+                    buffer.append(escaped, sizeof(escaped));
+            }
+
+            data += clean + 1;
+            remaining -= clean + 1;
+        }
+
+        buffer.push_back('"');
+    }
+}
\ No newline at end of file
@@ -2,21 +2,68 @@
 
 #include "nova_Core.hpp"
 
+#include <charconv>
+#include <cmath>
+
 namespace nova
 {
+    namespace detail
+    {
+        // Returns the length of the prefix free of quotes, backslashes and control characters
+        usz FindJsonSpecial(const char* str, usz size) noexcept;
+    }
+
+    // Writes JSON into an internal buffer, formatting numbers with std::to_chars and
+    // escaping strings as it goes. With a stream or file target the buffer is flushed
+    // in large chunks, otherwise the document stays in memory (see View / Take).
     struct JsonWriter
     {
-        std::ostream&          out;
+        static constexpr usz FlushThreshold = 1024 * 1024;
+
+        std::string         buffer;
+        std::ostream*       stream = nullptr;
+        std::FILE*            file = nullptr;
+
         std::string  indent_string = "  ";
+        bool                pretty = true;
         u32                  depth = 0;
         bool         first_element = true;
         bool               has_key = false;
 
     public:
+        JsonWriter() = default;
+
+        JsonWriter(std::ostream& out)
+            : stream(&out)
+        {}
+
+        // Throws if the file cannot be opened
+        JsonWriter(const fs::path& path);
+
+        ~JsonWriter();
+
+        JsonWriter(const JsonWriter&) = delete;
+        JsonWriter& operator=(const JsonWriter&) = delete;
+
+        // Writes buffered output to the stream or file target, if any
+        void Flush();
+
+        std::string_view View() const noexcept
+        {
+            return buffer;
+        }
+
+        std::string Take() noexcept
+        {
+            return std::move(buffer);
+        }
+
+// -----------------------------------------------------------------------------
+
         void Indent()
         {
             for (u32 i = 0; i < depth; ++i) {
-                out << indent_string;
+                buffer.append(indent_string);
             }
         }
 
@@ -27,12 +74,16 @@ namespace nova
                 return;
             }
 
+            if (buffer.size() >= FlushThreshold && (stream || file)) [[unlikely]] {
+                Flush();
+            }
+
             if (!first_element) {
-                out << ',';
+                buffer.push_back(',');
             }
 
-            if (depth > 0) {
-                out << '\n';
+            if (depth > 0 && pretty) {
+                buffer.push_back('\n');
                 Indent();
             }
 
@@ -42,7 +93,8 @@ namespace nova
         JsonWriter& Key(StringView key)
         {
             NewElement();
-            out << '"' << key << "\": ";
+            AppendString(key);
+            buffer.append(pretty ? ": " : ":");
             has_key = true;
             return *this;
         }
@@ -55,7 +107,7 @@ namespace nova
         void Object()
         {
             NewElement();
-            out << '{';
+            buffer.push_back('{');
             ++depth;
             first_element = true;
         }
@@ -63,18 +115,18 @@ namespace nova
         void EndObject()
         {
             --depth;
-            if (!first_element) {
-                out << '\n';
+            if (!first_element && pretty) {
+                buffer.push_back('\n');
                 Indent();
             }
-            out << '}';
+            buffer.push_back('}');
             first_element = false;
         }
 
         void Array()
         {
             NewElement();
-            out << '[';
+            buffer.push_back('[');
             ++depth;
             first_element = true;
         }
@@ -82,48 +134,78 @@ namespace nova
         void EndArray()
         {
             --depth;
-            if (!first_element) {
-                out << '\n';
+            if (!first_element && pretty) {
+                buffer.push_back('\n');
                 Indent();
             }
-
-            out << ']';
+            buffer.push_back(']');
             first_element = false;
         }
 
         void String(StringView str)
         {
             NewElement();
-            out << '"' << str << '"';
+            AppendString(str);
         }
 
-        void operator=(StringView str) { String(str); }
-        void operator=(char str)       { String({ &str, 1ull }); }
+        void operator=(StringView   str) { String(str);           }
+        void operator=(const char*  str) { String(str);           }
+        void operator=(char         str) { String({ &str, 1ull }); }
+
+        // Appends pre-formatted JSON without escaping
+        void Raw(std::string_view json)
+        {
+            NewElement();
+            buffer.append(json);
+        }
 
         template<typename T>
-        void Value(T&& value)
+            requires (std::is_arithmetic_v<T> && !std::same_as<T, bool>)
+        void Value(T value)
         {
             NewElement();
-            out << std::forward<T>(value);
+            AppendNumber(value);
         }
 
-        void operator=(f64  value) { Value(value);                    }
-        void operator=(f32  value) { Value(value);                    }
-        void operator=(i64  value) { Value(value);                    }
-        void operator=(i32  value) { Value(value);                    }
-        void operator=(i16  value) { Value(value);                    }
-        void operator=(i8   value) { Value(value);                    }
-        void operator=(u64  value) { Value(value);                    }
-        void operator=(u32  value) { Value(value);                    }
-        void operator=(u16  value) { Value(value);                    }
-        void operator=(u8   value) { Value(value);                    }
-        void operator=(bool value) { Value(value ? "true" : "false"); }
-        void operator=(std::nullptr_t) { Value("null");               }
+        void operator=(f64  value) { Value(value);                  }
+        void operator=(f32  value) { Value(value);                  }
+        void operator=(i64  value) { Value(value);                  }
+        void operator=(i32  value) { Value(value);                  }
+        void operator=(i16  value) { Value(value);                  }
+        void operator=(i8   value) { Value(value);                  }
+        void operator=(u64  value) { Value(value);                  }
+        void operator=(u32  value) { Value(value);                  }
+        void operator=(u16  value) { Value(value);                  }
+        void operator=(u8   value) { Value(value);                  }
+        void operator=(bool value) { Raw(value ? "true" : "false"); }
+        void operator=(std::nullptr_t) { Raw("null");               }
 
         template<typename T>
         void operator<<(T&& t)
         {
             this->operator=(std::forward<T>(t));
         }
+
+// -----------------------------------------------------------------------------
+
+    private:
+        // Appends a quoted string, escaping quotes, backslashes and control characters
+        void AppendString(std::string_view str);
+
+        template<typename T>
+        void AppendNumber(T value)
+        {
+            if constexpr (std::is_floating_point_v<T>) {
+                // JSON has no representation for infinities or NaN
+                if (!std::isfinite(value)) {
+                    buffer.append("null");
+                    return;
+                }
+            }
+
+            char chars[64];
+            auto result = std::to_chars(chars, chars + sizeof(chars), value);
+            buffer.append(chars, result.ptr);
+        }
     };
 }
\ No newline at end of file
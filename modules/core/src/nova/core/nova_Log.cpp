@@ -0,0 +1,411 @@
+#include "nova_Core.hpp"
+
+#include <fmt/chrono.h>
+
+// -----------------------------------------------------------------------------
+//                              Record buffers
+// -----------------------------------------------------------------------------
+
+namespace nova::detail
+{
+    // Inline text is stored as a u16 length followed by the characters. Longer
+    // messages are moved to the heap and the payload holds the owning pointer.
+    static constexpr usz InlineTextCapacity = LogRecord::PayloadSize - sizeof(u16);
+
+    static void FormatInlineText(LogRecord& record, std::string& out)
+    {
+        u16 length;
+        std::memcpy(&length, record.payload, sizeof(length));
+        out.append(reinterpret_cast<const char*>(record.payload + sizeof(length)), length);
+    }
+
+    static void FormatHeapText(LogRecord& record, std::string& out)
+    {
+        std::string* text;
+        std::memcpy(&text, record.payload, sizeof(text));
+        out.append(*text);
+        delete text;
+    }
+
+    void SetLogRecordText(LogRecord& record, fmt::string_view fmt_str, fmt::format_args args)
+    {
+        auto* chars = reinterpret_cast<char*>(record.payload + sizeof(u16));
+        auto result = fmt::vformat_to_n(chars, InlineTextCapacity, fmt_str, args);
+        if (result.size <= InlineTextCapacity) {
+            u16 length = u16(result.size);
+            std::memcpy(record.payload, &length, sizeof(length));
+            record.format = &FormatInlineText;
+        } else {
+            auto* text = new std::string(fmt::vformat(fmt_str, args));
+            std::memcpy(record.payload, &text, sizeof(text));
+            record.format = &FormatHeapText;
+        }
+    }
+
+    // Single producer (owning thread), single consumer (logging thread) ring
+    struct LogThreadBuffer
+    {
+        static constexpr u32 Capacity = 1024;
+
+        u32 thread_index;
+
+        alignas(64) std::atomic<u64> head = 0;
+        alignas(64) std::atomic<u64> tail = 0;
+        std::atomic<bool>         retired = false;
+
+        std::array<LogRecord, Capacity> records;
+    };
+
+    struct Logger
+    {
+        std::mutex                                  mutex;
+        std::condition_variable                        cv;
+        std::condition_variable                  flush_cv;
+        bool                                         wake = false;
+        bool                                         stop = false;
+        u64                                flush_requests = 0;
+        u64                                       flushed = 0;
+
+        std::vector<std::shared_ptr<LogThreadBuffer>> buffers;
+        u32                                 next_thread_index = 0;
+
+        std::vector<std::shared_ptr<LogSink>>  sinks;
+
+        std::atomic<LogLevel> flush_level = LogLevel::Error;
+
+        std::thread                                  thread;
+
+        Logger()
+        {
+            sinks.emplace_back(std::make_shared<ConsoleLogSink>());
+            thread = std::thread([this] { Run(); });
+        }
+
+        ~Logger()
+        {
+            {
+                std::scoped_lock lock{ mutex };
+                stop = true;
+            }
+            cv.notify_one();
+            thread.join();
+        }
+
+        void Run()
+        {
+            std::vector<LogRecord*> batch;
+            std::string message;
+
+            for (;;) {
+                bool stopping;
+                u64 requests;
+                {
+                    std::unique_lock lock{ mutex };
+                    cv.wait_for(lock, 10ms, [&] { return wake || stop; });
+                    wake = false;
+                    stopping = stop;
+                    requests = flush_requests;
+                }
+
+                Drain(batch, message, requests > flushed || stopping);
+
+                {
+                    std::scoped_lock lock{ mutex };
+                    flushed = requests;
+                }
+                flush_cv.notify_all();
+
+                if (stopping) {
+                    break;
+                }
+            }
+        }
+
+        void Drain(std::vector<LogRecord*>& batch, std::string& message, bool flush)
+        {
+            std::vector<std::shared_ptr<LogThreadBuffer>> snapshot;
+            std::vector<std::shared_ptr<LogSink>> current_sinks;
+            {
+                std::scoped_lock lock{ mutex };
+                snapshot = buffers;
+                current_sinks = sinks;
+            }
+
+            // Gather everything published so far, then write in timestamp order
+            std::vector<std::pair<LogThreadBuffer*, u64>> ranges;
+            batch.clear();
+            for (auto& buffer : snapshot) {
+                u64 tail = buffer->tail.load(std::memory_order_relaxed);
+                u64 head = buffer->head.load(std::memory_order_acquire);
+                for (u64 i = tail; i < head; ++i) {
+                    batch.push_back(&buffer->records[i % LogThreadBuffer::Capacity]);
+                }
+                ranges.emplace_back(buffer.get(), head);
+            }
+
+            std::ranges::stable_sort(batch, {}, &LogRecord::time);
+
+            for (auto* record : batch) {
+                message.clear();
+                record->format(*record, message);
+
+                LogEntry entry {
+                    .level = record->level,
+                    .thread = record->thread,
+                    .time = std::chrono::system_clock::time_point(std::chrono::system_clock::duration(record->time)),
+                    .message = message,
+                };
+
+                for (auto& sink : current_sinks) {
+                    sink->Write(entry);
+                }
+            }
+
+            for (auto[buffer, end] : ranges) {
+                buffer->tail.store(end, std::memory_order_release);
+            }
+
+            if (flush || !batch.empty()) {
+                for (auto& sink : current_sinks) {
+                    sink->Flush();
+                }
+            }
+
+            // Forget buffers whose threads have exited once they are fully drained
+            std::scoped_lock lock{ mutex };
+            std::erase_if(buffers, [](auto& buffer) {
+                return buffer->retired.load(std::memory_order_acquire)
+                    && buffer->tail.load(std::memory_order_relaxed) == buffer->head.load(std::memory_order_acquire);
+            });
+        }
+
+        void Wake()
+        {
+            {
+                std::scoped_lock lock{ mutex };
+                wake = true;
+            }
+            cv.notify_one();
+        }
+
+        void Flush()
+        {
+            std::unique_lock lock{ mutex };
+            u64 target = ++flush_requests;
+            wake = true;
+            cv.notify_one();
+            flush_cv.wait(lock, [&] { return flushed >= target || stop; });
+        }
+    };
+
+    static std::atomic<bool> LoggerAlive = false;
+
+    static Logger& GetLogger()
+    {
+        struct Holder
+        {
+            Logger logger;
+            Holder()  { LoggerAlive = true; }
+            ~Holder() { LoggerAlive = false; }
+        };
+        static Holder holder;
+        return holder.logger;
+    }
+
+    struct LogThreadBufferHandle
+    {
+        std::shared_ptr<LogThreadBuffer> buffer;
+
+        LogThreadBufferHandle()
+        {
+            buffer = std::make_shared<LogThreadBuffer>();
+            auto& logger = GetLogger();
+            std::scoped_lock lock{ logger.mutex };
+            buffer->thread_index = logger.next_thread_index++;
+            logger.buffers.push_back(buffer);
+        }
+
+        ~LogThreadBufferHandle()
+        {
+            buffer->retired.store(true, std::memory_order_release);
+        }
+    };
+
+    void PushLogRecord(LogRecord& record)
+    {
+        // Late logging from static destructors goes straight to the console
+        if (!LoggerAlive.load(std::memory_order_acquire)) {
+            GetLogger();
+            if (!LoggerAlive.load(std::memory_order_acquire)) {
+                std::string message;
+                record.format(record, message);
+                ConsoleLogSink sink;
+                sink.Write({ record.level, 0, std::chrono::system_clock::now(), message });
+                sink.Flush();
+                return;
+            }
+        }
+
+        auto& logger = GetLogger();
+        thread_local LogThreadBufferHandle handle;
+        auto& buffer = *handle.buffer;
+
+        u64 head = buffer.head.load(std::memory_order_relaxed);
+        while (head - buffer.tail.load(std::memory_order_acquire) >= LogThreadBuffer::Capacity) [[unlikely]] {
+            logger.Wake();
+            std::this_thread::yield();
+        }
+
+        record.thread = buffer.thread_index;
+        buffer.records[head % LogThreadBuffer::Capacity] = record;
+        buffer.head.store(head + 1, std::memory_order_release);
+
+        if (head - buffer.tail.load(std::memory_order_relaxed) >= LogThreadBuffer::Capacity / 2) {
+            logger.Wake();
+        }
+
+        if (record.level >= logger.flush_level.load(std::memory_order_relaxed)) {
+            logger.Flush();
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+//                              Logging control
+// -----------------------------------------------------------------------------
+
+namespace nova
+{
+    void SetLogLevel(LogLevel level)
+    {
+        detail::RuntimeLogLevel.store(level, std::memory_order_relaxed);
+    }
+
+    LogLevel GetLogLevel()
+    {
+        return detail::RuntimeLogLevel.load(std::memory_order_relaxed);
+    }
+
+    void SetLogFlushLevel(LogLevel level)
+    {
+        detail::GetLogger().flush_level.store(level, std::memory_order_relaxed);
+    }
+
+    void AddLogSink(std::shared_ptr<LogSink> sink)
+    {
+        auto& logger = detail::GetLogger();
+        std::scoped_lock lock{ logger.mutex };
+        logger.sinks.emplace_back(std::move(sink));
+    }
+
+    void ClearLogSinks()
+    {
+        auto& logger = detail::GetLogger();
+        logger.Flush();
+        std::scoped_lock lock{ logger.mutex };
+        logger.sinks.clear();
+    }
+
+    void FlushLog()
+    {
+        if (detail::LoggerAlive.load(std::memory_order_acquire)) {
+            detail::GetLogger().Flush();
+        }
+    }
+
+    std::string_view LogLevelToString(LogLevel level)
+    {
+        switch (level) {
+            break;case LogLevel::Trace: return "TRACE";
+            break;case LogLevel::Debug: return "DEBUG";
+            break;case LogLevel::Info:  return "INFO";
+            break;case LogLevel::Warn:  return "WARN";
+            break;case LogLevel::Error: return "ERROR";
+            break;case LogLevel::Fatal: return "FATAL";
+            break;case LogLevel::Off:   return "OFF";
+        }
+        return "UNKNOWN";
+    }
+}
+
+// -----------------------------------------------------------------------------
+//                                  Sinks
+// -----------------------------------------------------------------------------
+
+namespace nova
+{
+    void ConsoleLogSink::Write(const LogEntry& entry)
+    {
+        if (entry.level != LogLevel::Info) {
+            std::string_view color;
+            switch (entry.level) {
+                break;case LogLevel::Trace: color = "\u001B[90m";
+                break;case LogLevel::Debug: color = "\u001B[96m";
+                break;case LogLevel::Warn:  color = "\u001B[93m";
+                break;case LogLevel::Error: color = "\u001B[91m";
+                break;case LogLevel::Fatal: color = "\u001B[95m";
+                break;default:              color = "\u001B[0m";
+            }
+            fmt::format_to(std::back_inserter(buffer), "[{}{}\u001B[0m] ", color, LogLevelToString(entry.level));
+        }
+        buffer.append(entry.message);
+        buffer.push_back('\n');
+    }
+
+    void ConsoleLogSink::Flush()
+    {
+        std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+        std::fflush(stdout);
+        buffer.clear();
+    }
+
+// -----------------------------------------------------------------------------
+
+    FileLogSink::FileLogSink(const fs::path& path)
+        : out(path, std::ios::app)
+    {
+        if (!out.is_open()) {
+            NOVA_THROW_STACKLESS("Failed to open log file: {}", path.string());
+        }
+    }
+
+    void FileLogSink::Write(const LogEntry& entry)
+    {
+        auto time = std::chrono::floor<std::chrono::milliseconds>(entry.time);
+        out << fmt::format("{:%F %T} [{}] [{}] ", time, LogLevelToString(entry.level), entry.thread)
+            << entry.message << '\n';
+    }
+
+    void FileLogSink::Flush()
+    {
+        out.flush();
+    }
+
+// -----------------------------------------------------------------------------
+
+    BinaryLogSink::BinaryLogSink(const fs::path& path)
+        : out(path, std::ios::binary | std::ios::app)
+    {
+        if (!out.is_open()) {
+            NOVA_THROW_STACKLESS("Failed to open log file: {}", path.string());
+        }
+    }
+
+    void BinaryLogSink::Write(const LogEntry& entry)
+    {
+        i64 time = std::chrono::duration_cast<std::chrono::nanoseconds>(entry.time.time_since_epoch()).count();
+        u8 level = u8(entry.level);
+        u32 length = u32(entry.message.size());
+
+        out.write(reinterpret_cast<const char*>(&time), sizeof(time));
+        out.write(reinterpret_cast<const char*>(&entry.thread), sizeof(entry.thread));
+        out.write(reinterpret_cast<const char*>(&level), sizeof(level));
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(entry.message.data(), length);
+    }
+
+    void BinaryLogSink::Flush()
+    {
+        out.flush();
+    }
+}
\ No newline at end of file
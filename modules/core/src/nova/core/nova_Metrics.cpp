@@ -0,0 +1,322 @@
+#include "nova_Metrics.hpp"
+
+namespace nova::metrics
+{
+    namespace
+    {
+        struct Registry
+        {
+            std::mutex                          mutex;
+            std::vector<detail::MetricBase*> metrics;
+        };
+
+        Registry& GetRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+    }
+
+    detail::MetricBase::MetricBase(std::string _name, std::string _help, MetricType _type)
+        : name(std::move(_name))
+        , help(std::move(_help))
+        , type(_type)
+    {
+        auto& registry = GetRegistry();
+        std::scoped_lock lock{ registry.mutex };
+        for (auto* metric : registry.metrics) {
+            if (metric->name == name) {
+                NOVA_THROW("Duplicate metric name: {}", name);
+            }
+        }
+        registry.metrics.push_back(this);
+    }
+
+    void detail::MetricBase::Unregister()
+    {
+        auto& registry = GetRegistry();
+        std::scoped_lock lock{ registry.mutex };
+        std::erase(registry.metrics, this);
+    }
+
+// -----------------------------------------------------------------------------
+
+    void Counter::Sample(Snapshot& snapshot) const
+    {
+        snapshot.counters.emplace_back(name, help, Read());
+    }
+
+    void Gauge::Sample(Snapshot& snapshot) const
+    {
+        snapshot.gauges.emplace_back(name, help, Read());
+    }
+
+    void Histogram::Sample(Snapshot& snapshot) const
+    {
+        std::array<u64, BucketCount> merged = {};
+
+        auto& sample = snapshot.histograms.emplace_back();
+        sample.name = name;
+        sample.help = help;
+
+        u64 min = UINT64_MAX;
+        for (u32 i = 0; i < ShardCount; ++i) {
+            auto& shard = shards[i];
+            for (u32 j = 0; j < BucketCount; ++j) {
+                merged[j] += shard.buckets[j].load(std::memory_order_relaxed);
+            }
+            sample.count += shard.count.load(std::memory_order_relaxed);
+            sample.sum   += shard.sum.load(std::memory_order_relaxed);
+            min        = std::min(min, shard.min.load(std::memory_order_relaxed));
+            sample.max = std::max(sample.max, shard.max.load(std::memory_order_relaxed));
+        }
+        sample.min = sample.count ? min : 0;
+
+        for (u32 i = 0; i < BucketCount; ++i) {
+            if (merged[i]) {
+                sample.buckets.emplace_back(BucketUpperBound(i), merged[i]);
+            }
+        }
+    }
+
+    u64 HistogramSample::Percentile(f64 percentile) const noexcept
+    {
+        if (count == 0) {
+            return 0;
+        }
+
+        // Shards are read independently, so bucket totals may run slightly ahead of count
+        u64 target = u64(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * f64(count)));
+        target = std::max(target, u64(1));
+
+        u64 seen = 0;
+        for (auto& bucket : buckets) {
+            seen += bucket.count;
+            if (seen >= target) {
+                return std::min(std::max(bucket.upper_bound, min), max);
+            }
+        }
+
+        return max;
+    }
+
+// -----------------------------------------------------------------------------
+
+    Snapshot TakeSnapshot()
+    {
+        Snapshot snapshot;
+        snapshot.time = std::chrono::system_clock::now();
+
+        {
+            auto& registry = GetRegistry();
+            std::scoped_lock lock{ registry.mutex };
+            for (auto* metric : registry.metrics) {
+                metric->Sample(snapshot);
+            }
+        }
+
+        auto by_name = [](auto& l, auto& r) { return l.name < r.name; };
+        std::ranges::sort(snapshot.counters, by_name);
+        std::ranges::sort(snapshot.gauges, by_name);
+        std::ranges::sort(snapshot.histograms, by_name);
+
+        return snapshot;
+    }
+
+    Snapshot Difference(const Snapshot& current, const Snapshot& previous)
+    {
+        Snapshot delta;
+        delta.time = current.time;
+        delta.gauges = current.gauges;
+
+        // Both snapshots are sorted by name, metrics registered in between have no previous value
+        auto find = [](const auto& samples, const std::string& name) -> decltype(&samples[0]) {
+            auto iter = std::ranges::lower_bound(samples, name, {}, [](auto& s) -> const std::string& { return s.name; });
+            return (iter != samples.end() && iter->name == name) ? &*iter : nullptr;
+        };
+
+        for (auto& counter : current.counters) {
+            auto& out = delta.counters.emplace_back(counter);
+            if (auto* prev = find(previous.counters, counter.name)) {
+                out.value -= std::min(out.value, prev->value);
+            }
+        }
+
+        for (auto& histogram : current.histograms) {
+            auto& out = delta.histograms.emplace_back(histogram);
+            auto* prev = find(previous.histograms, histogram.name);
+            if (!prev) {
+                continue;
+            }
+
+            out.count -= std::min(out.count, prev->count);
+            out.sum   -= std::min(out.sum,   prev->sum);
+
+            auto prev_bucket = prev->buckets.begin();
+            for (auto& bucket : out.buckets) {
+                while (prev_bucket != prev->buckets.end() && prev_bucket->upper_bound < bucket.upper_bound) {
+                    ++prev_bucket;
+                }
+                if (prev_bucket != prev->buckets.end() && prev_bucket->upper_bound == bucket.upper_bound) {
+                    bucket.count -= std::min(bucket.count, prev_bucket->count);
+                }
+            }
+            std::erase_if(out.buckets, [](auto& bucket) { return bucket.count == 0; });
+        }
+
+        return delta;
+    }
+
+// -----------------------------------------------------------------------------
+
+    void WriteJson(JsonWriter& writer, const Snapshot& snapshot)
+    {
+        writer.Object();
+        writer["time"] = i64(std::chrono::duration_cast<std::chrono::milliseconds>(snapshot.time.time_since_epoch()).count());
+
+        writer["counters"].Object();
+        for (auto& counter : snapshot.counters) {
+            writer[counter.name] = counter.value;
+        }
+        writer.EndObject();
+
+        writer["gauges"].Object();
+        for (auto& gauge : snapshot.gauges) {
+            writer[gauge.name] = gauge.value;
+        }
+        writer.EndObject();
+
+        writer["histograms"].Object();
+        for (auto& histogram : snapshot.histograms) {
+            writer[histogram.name].Object();
+            writer["count"] = histogram.count;
+            writer["sum"] = histogram.sum;
+            writer["min"] = histogram.min;
+            writer["max"] = histogram.max;
+            writer["mean"] = histogram.Mean();
+            writer["p50"] = histogram.Percentile(50.0);
+            writer["p90"] = histogram.Percentile(90.0);
+            writer["p99"] = histogram.Percentile(99.0);
+            writer["p999"] = histogram.Percentile(99.9);
+            writer["buckets"].Array();
+            for (auto& bucket : histogram.buckets) {
+                writer.Array();
+                writer << bucket.upper_bound;
+                writer << bucket.count;
+                writer.EndArray();
+            }
+            writer.EndArray();
+            writer.EndObject();
+        }
+        writer.EndObject();
+
+        writer.EndObject();
+    }
+
+    std::string ToJson(const Snapshot& snapshot)
+    {
+        JsonWriter writer;
+        WriteJson(writer, snapshot);
+        return writer.Take();
+    }
+
+    namespace
+    {
+        std::string PrometheusName(std::string_view name)
+        {
+            std::string out(name);
+            for (auto& c : out) {
+                if (!std::isalnum(u8(c)) && c != '_' && c != ':') {
+                    c = '_';
+                }
+            }
+            if (!out.empty() && std::isdigit(u8(out[0]))) {
+                out.insert(out.begin(), '_');
+            }
+            return out;
+        }
+
+        void AppendPrometheusHeader(std::string& out, std::string_view name, std::string_view help, std::string_view type)
+        {
+            if (!help.empty()) {
+                out.append("# HELP ").append(name).push_back(' ');
+                for (char c : help) {
+                    if      (c == '\\') out.append("\\\\");
+                    else if (c == '\n') out.append("\\n");
+                    else                out.push_back(c);
+                }
+                out.push_back('\n');
+            }
+            fmt::format_to(std::back_inserter(out), "# TYPE {} {}\n", name, type);
+        }
+    }
+
+    std::string ToPrometheus(const Snapshot& snapshot)
+    {
+        std::string out;
+        auto appender = std::back_inserter(out);
+
+        for (auto& counter : snapshot.counters) {
+            auto name = PrometheusName(counter.name) + "_total";
+            AppendPrometheusHeader(out, name, counter.help, "counter");
+            fmt::format_to(appender, "{} {}\n", name, counter.value);
+        }
+
+        for (auto& gauge : snapshot.gauges) {
+            auto name = PrometheusName(gauge.name);
+            AppendPrometheusHeader(out, name, gauge.help, "gauge");
+            fmt::format_to(appender, "{} {}\n", name, gauge.value);
+        }
+
+        for (auto& histogram : snapshot.histograms) {
+            auto name = PrometheusName(histogram.name);
+            AppendPrometheusHeader(out, name, histogram.help, "histogram");
+
+            // Only non-empty buckets are emitted, Prometheus buckets are cumulative
+            u64 cumulative = 0;
+            for (auto& bucket : histogram.buckets) {
+                cumulative += bucket.count;
+                fmt::format_to(appender, "{}_bucket{{le=\"{}\"}} {}\n", name, bucket.upper_bound, cumulative);
+            }
+            fmt::format_to(appender, "{}_bucket{{le=\"+Inf\"}} {}\n", name, std::max(cumulative, histogram.count));
+            fmt::format_to(appender, "{}_sum {}\n", name, histogram.sum);
+            fmt::format_to(appender, "{}_count {}\n", name, std::max(cumulative, histogram.count));
+        }
+
+        return out;
+    }
+
+// -----------------------------------------------------------------------------
+
+    PeriodicSnapshot::PeriodicSnapshot(std::chrono::milliseconds interval, std::function<void(const Snapshot&)> callback)
+    {
+        thread = std::thread([this, interval, callback = std::move(callback)] {
+            auto next = std::chrono::steady_clock::now() + interval;
+            for (;;) {
+                {
+                    std::unique_lock lock{ mutex };
+                    if (cv.wait_until(lock, next, [&] { return stop; })) {
+                        return;
+                    }
+                }
+                next += interval;
+
+                try {
+                    callback(TakeSnapshot());
+                } catch (const std::exception& e) {
+                    LogError("Metrics snapshot callback failed: {}", e.what());
+                }
+            }
+        });
+    }
+
+    PeriodicSnapshot::~PeriodicSnapshot()
+    {
+        {
+            std::scoped_lock lock{ mutex };
+            stop = true;
+        }
+        cv.notify_one();
+        thread.join();
+    }
+}
\ No newline at end of file
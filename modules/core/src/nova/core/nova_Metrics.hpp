@@ -0,0 +1,366 @@
+#pragma once
+
+#include "nova_Core.hpp"
+#include "nova_JsonWriter.hpp"
+
+// -----------------------------------------------------------------------------
+//                              Runtime metrics
+// -----------------------------------------------------------------------------
+
+// Metrics are long lived objects (usually inline globals) that register themselves
+// by name on construction. Hot path updates touch a per-thread shard with relaxed
+// atomics, and are only merged when a snapshot is taken.
+//
+//   inline metrics::Counter   FilesIndexed{ "indexer.files", "Files visited by the crawler" };
+//   inline metrics::Histogram SearchTime{ "indexer.search_ns", "GPU search latency" };
+//
+//   FilesIndexed.Add();
+//   { metrics::ScopedTimer timer{ SearchTime }; ... }
+//
+// Metric names should be dot separated identifiers. Prometheus export maps any other
+// characters to underscores.
+
+namespace nova::metrics
+{
+    enum class MetricType : u32
+    {
+        Counter,
+        Gauge,
+        Histogram,
+    };
+
+    struct Snapshot;
+
+    namespace detail
+    {
+        inline constexpr u32 ShardCount = 16;
+
+        inline std::atomic<u32> NextShard = 0;
+
+        // Threads are assigned shards round robin on first use
+        NOVA_FORCE_INLINE
+        u32 GetShardIndex() noexcept
+        {
+            thread_local u32 shard = NextShard.fetch_add(1, std::memory_order_relaxed) % ShardCount;
+            return shard;
+        }
+
+        struct MetricBase
+        {
+            std::string name;
+            std::string help;
+            MetricType  type;
+
+            virtual void Sample(Snapshot& snapshot) const = 0;
+
+        protected:
+            MetricBase(std::string name, std::string help, MetricType type);
+            ~MetricBase() = default;
+
+            // Must be called from the most derived destructor so that snapshots never observe
+            // a partially destroyed metric.
+            void Unregister();
+        };
+    }
+
+// -----------------------------------------------------------------------------
+//                                  Counter
+// -----------------------------------------------------------------------------
+
+    // Monotonically increasing count
+    class Counter final : public detail::MetricBase
+    {
+        struct alignas(64) Shard
+        {
+            std::atomic<u64> value = 0;
+        };
+
+        std::array<Shard, detail::ShardCount> shards;
+
+    public:
+        Counter(std::string name, std::string help = {})
+            : MetricBase(std::move(name), std::move(help), MetricType::Counter)
+        {}
+
+        ~Counter()
+        {
+            Unregister();
+        }
+
+        Counter(const Counter&) = delete;
+        Counter& operator=(const Counter&) = delete;
+
+        NOVA_FORCE_INLINE
+        void Add(u64 amount = 1) noexcept
+        {
+            shards[detail::GetShardIndex()].value.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        NOVA_FORCE_INLINE
+        Counter& operator++() noexcept
+        {
+            Add();
+            return *this;
+        }
+
+        NOVA_FORCE_INLINE
+        Counter& operator+=(u64 amount) noexcept
+        {
+            Add(amount);
+            return *this;
+        }
+
+        u64 Read() const noexcept
+        {
+            u64 total = 0;
+            for (auto& shard : shards) {
+                total += shard.value.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+        void Sample(Snapshot& snapshot) const override;
+    };
+
+// -----------------------------------------------------------------------------
+//                                   Gauge
+// -----------------------------------------------------------------------------
+
+    // Point in time value. Either set directly, or read through a callback at snapshot
+    // time to expose existing state (e.g. rhi::stats) without touching its hot path.
+    class Gauge final : public detail::MetricBase
+    {
+        std::atomic<i64>      value = 0;
+        std::function<i64()> callback;
+
+    public:
+        Gauge(std::string name, std::string help = {}, std::function<i64()> _callback = {})
+            : MetricBase(std::move(name), std::move(help), MetricType::Gauge)
+            , callback(std::move(_callback))
+        {}
+
+        ~Gauge()
+        {
+            Unregister();
+        }
+
+        Gauge(const Gauge&) = delete;
+        Gauge& operator=(const Gauge&) = delete;
+
+        void Set(i64 new_value) noexcept { value.store(new_value, std::memory_order_relaxed); }
+        void Add(i64    amount) noexcept { value.fetch_add(amount, std::memory_order_relaxed); }
+        void Sub(i64    amount) noexcept { value.fetch_sub(amount, std::memory_order_relaxed); }
+
+        i64 Read() const
+        {
+            return callback ? callback() : value.load(std::memory_order_relaxed);
+        }
+
+        void Sample(Snapshot& snapshot) const override;
+    };
+
+// -----------------------------------------------------------------------------
+//                                 Histogram
+// -----------------------------------------------------------------------------
+
+    // Log-linear (HDR style) histogram over u64 values. Each power of two range is split
+    // into SubBucketCount linear buckets, bounding the relative error of any recorded
+    // value to 1 / SubBucketCount while covering the full u64 range in a fixed table.
+    class Histogram final : public detail::MetricBase
+    {
+    public:
+        static constexpr u32 SubBucketBits  = 3;
+        static constexpr u32 SubBucketCount = 1u << SubBucketBits;
+        static constexpr u32 BucketCount    = (64 - SubBucketBits + 1) * SubBucketCount;
+
+        static constexpr u32 ShardCount = 8;
+
+    private:
+        struct alignas(64) Shard
+        {
+            std::array<std::atomic<u64>, BucketCount> buckets = {};
+            std::atomic<u64>                            count = 0;
+            std::atomic<u64>                              sum = 0;
+            std::atomic<u64>                              min = UINT64_MAX;
+            std::atomic<u64>                              max = 0;
+        };
+
+        std::unique_ptr<Shard[]> shards;
+
+    public:
+        Histogram(std::string name, std::string help = {})
+            : MetricBase(std::move(name), std::move(help), MetricType::Histogram)
+            , shards(new Shard[ShardCount])
+        {}
+
+        ~Histogram()
+        {
+            Unregister();
+        }
+
+        Histogram(const Histogram&) = delete;
+        Histogram& operator=(const Histogram&) = delete;
+
+        static constexpr
+        u32 BucketIndex(u64 value) noexcept
+        {
+            if (value < 2 * SubBucketCount) {
+                return u32(value);
+            }
+
+            u32 exponent = u32(std::bit_width(value)) - 1;
+            u32 shift = exponent - SubBucketBits;
+            return (shift + 1) * SubBucketCount + u32((value >> shift) & (SubBucketCount - 1));
+        }
+
+        static constexpr
+        u64 BucketLowerBound(u32 index) noexcept
+        {
+            if (index < 2 * SubBucketCount) {
+                return index;
+            }
+
+            u32 shift = index / SubBucketCount - 1;
+            return u64(SubBucketCount + index % SubBucketCount) << shift;
+        }
+
+        // Inclusive
+        static constexpr
+        u64 BucketUpperBound(u32 index) noexcept
+        {
+            if (index < 2 * SubBucketCount) {
+                return index;
+            }
+
+            u32 shift = index / SubBucketCount - 1;
+            return BucketLowerBound(index) + ((1ull << shift) - 1);
+        }
+
+        NOVA_FORCE_INLINE
+        void Record(u64 value) noexcept
+        {
+            auto& shard = shards[detail::GetShardIndex() % ShardCount];
+            shard.buckets[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+            shard.count.fetch_add(1, std::memory_order_relaxed);
+            shard.sum.fetch_add(value, std::memory_order_relaxed);
+
+            u64 min = shard.min.load(std::memory_order_relaxed);
+            while (value < min && !shard.min.compare_exchange_weak(min, value, std::memory_order_relaxed));
+
+            u64 max = shard.max.load(std::memory_order_relaxed);
+            while (value > max && !shard.max.compare_exchange_weak(max, value, std::memory_order_relaxed));
+        }
+
+        template<typename Rep, typename Period>
+        void Record(std::chrono::duration<Rep, Period> duration) noexcept
+        {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+            Record(u64(std::max(ns, decltype(ns)(0))));
+        }
+
+        void Sample(Snapshot& snapshot) const override;
+    };
+
+    // Records the lifetime of the scope into a histogram in nanoseconds
+    struct ScopedTimer
+    {
+        Histogram&                                  histogram;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        explicit ScopedTimer(Histogram& _histogram) noexcept
+            : histogram(_histogram)
+        {}
+
+        ~ScopedTimer()
+        {
+            histogram.Record(std::chrono::steady_clock::now() - start);
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    };
+
+// -----------------------------------------------------------------------------
+//                                 Snapshots
+// -----------------------------------------------------------------------------
+
+    struct CounterSample
+    {
+        std::string  name;
+        std::string  help;
+        u64         value;
+    };
+
+    struct GaugeSample
+    {
+        std::string  name;
+        std::string  help;
+        i64         value;
+    };
+
+    struct HistogramBucket
+    {
+        u64 upper_bound;
+        u64       count;
+    };
+
+    struct HistogramSample
+    {
+        std::string                   name;
+        std::string                   help;
+        u64                          count = 0;
+        u64                            sum = 0;
+        u64                            min = 0;
+        u64                            max = 0;
+        std::vector<HistogramBucket> buckets;  // Non-empty buckets in ascending order
+
+        // Returns the upper bound of the bucket containing the given percentile [0, 100],
+        // clamped to the observed range.
+        u64 Percentile(f64 percentile) const noexcept;
+
+        f64 Mean() const noexcept
+        {
+            return count ? f64(sum) / f64(count) : 0.0;
+        }
+    };
+
+    struct Snapshot
+    {
+        std::chrono::system_clock::time_point time;
+
+        std::vector<CounterSample>     counters;
+        std::vector<GaugeSample>         gauges;
+        std::vector<HistogramSample> histograms;
+    };
+
+    // Merges all shards of every registered metric. Metrics are sorted by name
+    Snapshot TakeSnapshot();
+
+    // Change in counters and histograms between two snapshots. Gauges, and histogram
+    // min/max, are taken from the current snapshot.
+    Snapshot Difference(const Snapshot& current, const Snapshot& previous);
+
+    void WriteJson(JsonWriter& writer, const Snapshot& snapshot);
+    std::string ToJson(const Snapshot& snapshot);
+
+    // Prometheus text exposition format (version 0.0.4)
+    std::string ToPrometheus(const Snapshot& snapshot);
+
+// -----------------------------------------------------------------------------
+
+    // Takes a snapshot on a background thread every interval and hands it to the callback
+    class PeriodicSnapshot
+    {
+        std::mutex               mutex;
+        std::condition_variable     cv;
+        bool                      stop = false;
+        std::thread             thread;
+
+    public:
+        PeriodicSnapshot(std::chrono::milliseconds interval, std::function<void(const Snapshot&)> callback);
+        ~PeriodicSnapshot();
+
+        PeriodicSnapshot(const PeriodicSnapshot&) = delete;
+        PeriodicSnapshot& operator=(const PeriodicSnapshot&) = delete;
+    };
+}
\ No newline at end of file
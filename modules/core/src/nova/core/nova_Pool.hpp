@@ -0,0 +1,309 @@
+#pragma once
+
+#include "nova_Core.hpp"
+
+namespace nova
+{
+    struct PoolStats
+    {
+        const char* name;
+        usz  object_size;
+        u64         live;
+        u64         peak;
+        u64     capacity;
+    };
+
+    namespace detail
+    {
+        struct PoolBase
+        {
+            virtual PoolStats GetStats() = 0;
+
+        protected:
+            ~PoolBase() = default;
+        };
+
+        struct PoolRegistry
+        {
+            std::mutex               mutex;
+            std::vector<PoolBase*>   pools;
+        };
+
+        inline
+        PoolRegistry& GetPoolRegistry()
+        {
+            static PoolRegistry registry;
+            return registry;
+        }
+    }
+
+// -----------------------------------------------------------------------------
+//                              Typed slab pool
+// -----------------------------------------------------------------------------
+
+    // Fixed size object pool for type T. Slots are carved out of contiguous slabs and
+    // recycled through an intrusive free list. Each thread keeps a small cache of free
+    // slots so that alloc/free only take the pool lock once per CacheSize operations.
+    template<typename T>
+    class Pool final : public detail::PoolBase
+    {
+        struct FreeNode
+        {
+            FreeNode* next;
+        };
+
+        static constexpr usz SlotAlign = std::max(alignof(T), alignof(FreeNode));
+        static constexpr usz SlotSize  = AlignUpPower2(std::max(sizeof(T), sizeof(FreeNode)), SlotAlign);
+
+        static constexpr usz SlabSize     = 64ull * 1024;
+        static constexpr u32 SlotsPerSlab = u32(std::max(SlabSize / SlotSize, usz(16)));
+        static constexpr u32 CacheSize    = 64;
+
+        struct ThreadCache
+        {
+            FreeNode* head = nullptr;
+            u32      count = 0;
+
+            ~ThreadCache()
+            {
+                if (head) {
+                    Pool::Get().Flush(*this, 0);
+                }
+                IsCacheDestroyed() = true;
+            }
+        };
+
+    private:
+        std::mutex             mutex;
+        FreeNode*          free_list = nullptr;
+        std::vector<void*>     slabs;
+
+        std::atomic<u64> live = 0;
+        std::atomic<u64> peak = 0;
+
+    private:
+        Pool()
+        {
+            auto& registry = detail::GetPoolRegistry();
+            std::scoped_lock lock{ registry.mutex };
+            registry.pools.push_back(this);
+        }
+
+        ~Pool()
+        {
+            {
+                auto& registry = detail::GetPoolRegistry();
+                std::scoped_lock lock{ registry.mutex };
+                std::erase(registry.pools, this);
+            }
+
+            for (void* slab : slabs) {
+                nova::Free(slab);
+            }
+        }
+
+        static
+        ThreadCache& GetCache()
+        {
+            thread_local ThreadCache cache;
+            return cache;
+        }
+
+        // Set once the calling thread's cache has been destroyed. Pooled objects can still be
+        // freed after that by other thread_local or static destructors, which then go straight
+        // to the shared free list. Trivially destructible, so stays valid until thread exit.
+        static
+        bool& IsCacheDestroyed()
+        {
+            thread_local bool destroyed = false;
+            return destroyed;
+        }
+
+        // Requires mutex
+        void AddSlab()
+        {
+            auto* slab = static_cast<b8*>(nova::Alloc(SlotSize * SlotsPerSlab, SlotAlign));
+            slabs.push_back(slab);
+            for (u32 i = SlotsPerSlab; i-- > 0;) {
+                auto* node = reinterpret_cast<FreeNode*>(slab + i * SlotSize);
+                node->next = free_list;
+                free_list = node;
+            }
+        }
+
+        void Refill(ThreadCache& cache)
+        {
+            std::scoped_lock lock{ mutex };
+
+            if (!free_list) {
+                AddSlab();
+            }
+
+            while (free_list && cache.count < CacheSize) {
+                FreeNode* node = free_list;
+                free_list = node->next;
+                node->next = cache.head;
+                cache.head = node;
+                cache.count++;
+            }
+        }
+
+        void Flush(ThreadCache& cache, u32 keep)
+        {
+            FreeNode* first = cache.head;
+            FreeNode* last = nullptr;
+            for (u32 i = 0; i < keep; ++i) {
+                last = first;
+                first = first->next;
+            }
+
+            if (!first) {
+                return;
+            }
+
+            FreeNode* tail = first;
+            while (tail->next) {
+                tail = tail->next;
+            }
+
+            if (last) {
+                last->next = nullptr;
+            } else {
+                cache.head = nullptr;
+            }
+            cache.count = keep;
+
+            std::scoped_lock lock{ mutex };
+            tail->next = free_list;
+            free_list = first;
+        }
+
+    public:
+        static
+        Pool& Get()
+        {
+            static Pool pool;
+            return pool;
+        }
+
+        void* Allocate()
+        {
+            FreeNode* node;
+            if (IsCacheDestroyed()) [[unlikely]] {
+                std::scoped_lock lock{ mutex };
+                if (!free_list) {
+                    AddSlab();
+                }
+                node = free_list;
+                free_list = node->next;
+            } else {
+                auto& cache = GetCache();
+                if (!cache.head) [[unlikely]] {
+                    Refill(cache);
+                }
+
+                node = cache.head;
+                cache.head = node->next;
+                cache.count--;
+            }
+
+            AtomicSetMax(peak, live.fetch_add(1, std::memory_order_relaxed) + 1);
+
+            return node;
+        }
+
+        void Free(void* ptr)
+        {
+            live.fetch_sub(1, std::memory_order_relaxed);
+
+            auto* node = static_cast<FreeNode*>(ptr);
+
+            if (IsCacheDestroyed()) [[unlikely]] {
+                std::scoped_lock lock{ mutex };
+                node->next = free_list;
+                free_list = node;
+                return;
+            }
+
+            auto& cache = GetCache();
+            node->next = cache.head;
+            cache.head = node;
+
+            if (++cache.count > CacheSize * 2) [[unlikely]] {
+                Flush(cache, CacheSize);
+            }
+        }
+
+        template<typename... Args>
+        T* New(Args&&... args)
+        {
+            return new (Allocate()) T(std::forward<Args>(args)...);
+        }
+
+        void Delete(T* t)
+        {
+            if (t) {
+                t->~T();
+                Free(t);
+            }
+        }
+
+        PoolStats GetStats() override
+        {
+            u64 capacity;
+            {
+                std::scoped_lock lock{ mutex };
+                capacity = u64(slabs.size()) * SlotsPerSlab;
+            }
+
+            return PoolStats {
+                .name = typeid(T).name(),
+                .object_size = sizeof(T),
+                .live = live.load(std::memory_order_relaxed),
+                .peak = peak.load(std::memory_order_relaxed),
+                .capacity = capacity,
+            };
+        }
+    };
+
+// -----------------------------------------------------------------------------
+
+    template<typename Fn>
+    void ForEachPool(Fn&& fn)
+    {
+        auto& registry = detail::GetPoolRegistry();
+        std::scoped_lock lock{ registry.mutex };
+        for (auto* pool : registry.pools) {
+            fn(pool->GetStats());
+        }
+    }
+
+    inline
+    void LogPoolStats()
+    {
+        Log("Pools:");
+        ForEachPool([](const PoolStats& stats) {
+            Log("  {} ({} bytes) - live = {}, peak = {}, capacity = {}",
+                stats.name, stats.object_size, stats.live, stats.peak, stats.capacity);
+        });
+    }
+}
+
+// -----------------------------------------------------------------------------
+//                              Pool opt-in
+// -----------------------------------------------------------------------------
+
+// Routes `new Type` / `delete ptr` through Pool<Type>. Place inside the class body of
+// Handle<T>::Impl specializations or RefCounted types (which Ref<T> creates with new).
+// Derived types that inherit these operators fall back to the global heap.
+#define NOVA_POOLED(Type)                                                      \
+    static void* operator new(::nova::usz size)                                \
+    {                                                                          \
+        if (size != sizeof(Type)) return ::operator new(size);                 \
+        return ::nova::Pool<Type>::Get().Allocate();                           \
+    }                                                                          \
+    static void operator delete(void* ptr, ::nova::usz size)                   \
+    {                                                                          \
+        if (size != sizeof(Type)) return ::operator delete(ptr);               \
+        ::nova::Pool<Type>::Get().Free(ptr);                                   \
+    }
@@ -0,0 +1,319 @@
+#include "nova_Profiler.hpp"
+#include "nova_JsonWriter.hpp"
+
+namespace nova::profiler
+{
+    namespace
+    {
+        constexpr usz ChunkSize = 4096;
+
+        using Chunk = std::array<Event, ChunkSize>;
+
+        // Written only by the owning thread. Chunk list growth takes the mutex so that
+        // exporters can walk it safely, and count publishes completed events.
+        struct ThreadBuffer
+        {
+            std::mutex                               mutex;
+            std::vector<std::unique_ptr<Chunk>>     chunks;
+            std::atomic<usz>                         count = 0;
+            std::atomic<u64>                    generation = 0;
+            std::string                               name;
+            u32                                        tid = 0;
+            bool                                   retired = false; // Owning thread has exited, guarded by the registry mutex
+        };
+
+        struct Registry
+        {
+            std::mutex                                  mutex;
+            std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+            u32                                        next_tid = 0;
+
+            std::atomic<u64> generation = 0;
+
+            u64 start_ticks = 0;
+            u64  stop_ticks = 0;
+            std::chrono::steady_clock::time_point start_time;
+            std::chrono::steady_clock::time_point  stop_time;
+        };
+
+        Registry& GetRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        // Buffers of exited threads are kept while they hold events of the current capture, and
+        // are otherwise handed to the next thread that starts recording. This bounds the number
+        // of buffers by the threads recording at once, rather than every thread ever started.
+        std::shared_ptr<ThreadBuffer> AcquireThreadBuffer()
+        {
+            auto& registry = GetRegistry();
+            std::scoped_lock lock{ registry.mutex };
+            u64 generation = registry.generation.load();
+
+            for (auto& buffer : registry.buffers) {
+                if (!buffer->retired) {
+                    continue;
+                }
+                if (buffer->generation.load(std::memory_order_acquire) == generation
+                        && buffer->count.load(std::memory_order_acquire) > 0) {
+                    continue;
+                }
+
+                std::scoped_lock buffer_lock{ buffer->mutex };
+                buffer->retired = false;
+                buffer->count.store(0, std::memory_order_relaxed);
+                buffer->name.clear();
+                buffer->tid = registry.next_tid++;
+                return buffer;
+            }
+
+            auto buffer = std::make_shared<ThreadBuffer>();
+            buffer->tid = registry.next_tid++;
+            registry.buffers.push_back(buffer);
+            return buffer;
+        }
+
+        // Trivially destructible, so remain valid for profiled scopes in other thread_local
+        // destructors that run after the buffer has been released
+        thread_local ThreadBuffer* CurrentThreadBuffer = nullptr;
+        thread_local bool          ThreadBufferReleased = false;
+
+        struct ThreadBufferOwner
+        {
+            std::shared_ptr<ThreadBuffer> buffer;
+
+            ~ThreadBufferOwner()
+            {
+                auto& registry = GetRegistry();
+                std::scoped_lock lock{ registry.mutex };
+                buffer->retired = true;
+                CurrentThreadBuffer = nullptr;
+                ThreadBufferReleased = true;
+            }
+        };
+
+        // Returns null once the calling thread's buffer has been released at thread exit
+        ThreadBuffer* GetThreadBuffer()
+        {
+            if (CurrentThreadBuffer) [[likely]] {
+                return CurrentThreadBuffer;
+            }
+            if (ThreadBufferReleased) {
+                return nullptr;
+            }
+
+            thread_local ThreadBufferOwner owner;
+            owner.buffer = AcquireThreadBuffer();
+            CurrentThreadBuffer = owner.buffer.get();
+            return CurrentThreadBuffer;
+        }
+
+        f64 GetTicksPerMicrosecond(const Registry& registry)
+        {
+            u64 stop_ticks = registry.stop_ticks;
+            auto stop_time = registry.stop_time;
+            if (stop_ticks == 0) {
+                stop_ticks = detail::ReadTimestamp();
+                stop_time = std::chrono::steady_clock::now();
+            }
+
+            f64 elapsed_us = std::chrono::duration<f64, std::micro>(stop_time - registry.start_time).count();
+            return elapsed_us > 0.0 ? f64(stop_ticks - registry.start_ticks) / elapsed_us : 1.0;
+        }
+
+        template<typename Fn>
+        void ForEachCapturedThread(Registry& registry, Fn&& fn)
+        {
+            std::scoped_lock lock{ registry.mutex };
+            u64 generation = registry.generation.load();
+            for (auto& buffer : registry.buffers) {
+                if (buffer->generation.load(std::memory_order_acquire) != generation) {
+                    continue;
+                }
+
+                std::scoped_lock buffer_lock{ buffer->mutex };
+                usz count = buffer->count.load(std::memory_order_acquire);
+                fn(*buffer, count);
+            }
+        }
+    }
+
+// -----------------------------------------------------------------------------
+
+    void detail::Record(const Event& event)
+    {
+        auto* buffer_ptr = GetThreadBuffer();
+        if (!buffer_ptr) [[unlikely]] {
+            return;
+        }
+        auto& buffer = *buffer_ptr;
+
+        // Lazily reset buffers that still hold a previous capture
+        u64 generation = GetRegistry().generation.load(std::memory_order_relaxed);
+        if (buffer.generation.load(std::memory_order_relaxed) != generation) {
+            std::scoped_lock lock{ buffer.mutex };
+            buffer.count.store(0, std::memory_order_relaxed);
+            buffer.generation.store(generation, std::memory_order_release);
+        }
+
+        usz index = buffer.count.load(std::memory_order_relaxed);
+        usz chunk = index / ChunkSize;
+        if (chunk == buffer.chunks.size()) [[unlikely]] {
+            std::scoped_lock lock{ buffer.mutex };
+            buffer.chunks.emplace_back(std::make_unique<Chunk>());
+        }
+
+        (*buffer.chunks[chunk])[index % ChunkSize] = event;
+        buffer.count.store(index + 1, std::memory_order_release);
+    }
+
+    void Start()
+    {
+        auto& registry = GetRegistry();
+        {
+            std::scoped_lock lock{ registry.mutex };
+            registry.generation++;
+            registry.start_time = std::chrono::steady_clock::now();
+            registry.start_ticks = detail::ReadTimestamp();
+            registry.stop_ticks = 0;
+        }
+        detail::Active.store(true, std::memory_order_release);
+    }
+
+    void Stop()
+    {
+        detail::Active.store(false, std::memory_order_release);
+
+        auto& registry = GetRegistry();
+        std::scoped_lock lock{ registry.mutex };
+        registry.stop_time = std::chrono::steady_clock::now();
+        registry.stop_ticks = detail::ReadTimestamp();
+    }
+
+    void SetThreadName(std::string name)
+    {
+        auto* buffer = GetThreadBuffer();
+        if (!buffer) {
+            return;
+        }
+        std::scoped_lock lock{ buffer->mutex };
+        buffer->name = std::move(name);
+    }
+
+// -----------------------------------------------------------------------------
+
+    void WriteChromeTrace(const fs::path& path)
+    {
+        auto& registry = GetRegistry();
+        f64 ticks_per_us = GetTicksPerMicrosecond(registry);
+
+        // Round to nanoseconds to keep the shortest round-trip formatting compact
+        auto to_us = [&](u64 ticks) { return std::round(f64(ticks) / ticks_per_us * 1e3) / 1e3; };
+
+        JsonWriter json(path);
+        json.pretty = false;
+
+        json.Object();
+        json["displayTimeUnit"] = "ns";
+        json["traceEvents"].Array();
+
+        ForEachCapturedThread(registry, [&](ThreadBuffer& buffer, usz count) {
+            if (!buffer.name.empty()) {
+                json.Object();
+                json["ph"] = "M";
+                json["name"] = "thread_name";
+                json["pid"] = 0;
+                json["tid"] = buffer.tid;
+                json["args"].Object();
+                json["name"] = buffer.name;
+                json.EndObject();
+                json.EndObject();
+            }
+
+            for (usz i = 0; i < count; ++i) {
+                auto& event = (*buffer.chunks[i / ChunkSize])[i % ChunkSize];
+
+                json.Object();
+                json["ph"] = "X";
+                json["name"] = event.name;
+                json["pid"] = 0;
+                json["tid"] = buffer.tid;
+
+                // Events may straddle Start() if their scope opened during a previous capture
+                json["ts"] = event.begin > registry.start_ticks ? to_us(event.begin - registry.start_ticks) : 0.0;
+                json["dur"] = to_us(event.end - event.begin);
+                json.EndObject();
+            }
+        });
+
+        json.EndArray();
+        json.EndObject();
+    }
+
+    // Layout (little endian):
+    //   char[4] "NVPF", u32 version
+    //   f64 ticks_per_second, u64 start_ticks
+    //   u32 name_count, { u32 length, char[length] }[name_count]
+    //   u32 thread_count, {
+    //       u32 tid, u32 name_length, char[name_length], u64 event_count,
+    //       { u32 name_index, u32 depth, u64 begin, u64 end }[event_count]
+    //   }[thread_count]
+    void WriteBinary(const fs::path& path)
+    {
+        auto& registry = GetRegistry();
+        f64 ticks_per_second = GetTicksPerMicrosecond(registry) * 1e6;
+
+        std::ofstream out(path, std::ios::binary);
+        if (!out.is_open()) {
+            NOVA_THROW("Failed to open trace file: {}", path.string());
+        }
+
+        // Threads are serialized first so that the name table covers every event
+        std::string threads;
+        auto append = [](std::string& dst, const auto& value) {
+            dst.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        };
+        auto append_string = [&](std::string& dst, std::string_view str) {
+            append(dst, u32(str.size()));
+            dst.append(str);
+        };
+
+        // Zone names are static strings, so deduplicate by address
+        HashMap<const char*, u32> name_indices;
+        std::vector<const char*> names;
+        u32 thread_count = 0;
+
+        ForEachCapturedThread(registry, [&](ThreadBuffer& buffer, usz count) {
+            thread_count++;
+            append(threads, buffer.tid);
+            append_string(threads, buffer.name);
+            append(threads, u64(count));
+            for (usz i = 0; i < count; ++i) {
+                auto& event = (*buffer.chunks[i / ChunkSize])[i % ChunkSize];
+                auto[iter, inserted] = name_indices.try_emplace(event.name, u32(names.size()));
+                if (inserted) {
+                    names.push_back(event.name);
+                }
+                append(threads, iter->second);
+                append(threads, event.depth);
+                append(threads, event.begin);
+                append(threads, event.end);
+            }
+        });
+
+        std::string header;
+        header.append("NVPF", 4);
+        append(header, u32(1));
+        append(header, ticks_per_second);
+        append(header, registry.start_ticks);
+        append(header, u32(names.size()));
+        for (auto* name : names) {
+            append_string(header, name);
+        }
+        append(header, thread_count);
+
+        out.write(header.data(), header.size());
+        out.write(threads.data(), threads.size());
+    }
+}
\ No newline at end of file
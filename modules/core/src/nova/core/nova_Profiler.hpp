@@ -0,0 +1,109 @@
+#pragma once
+
+#include "nova_Core.hpp"
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+#endif
+
+// -----------------------------------------------------------------------------
+//                              CPU Profiler
+// -----------------------------------------------------------------------------
+
+// Scoped zones are only compiled in when NOVA_PROFILER is defined. Zones record
+// into per-thread buffers while the profiler is active (see profiler::Start).
+//
+//   NOVA_PROFILE_SCOPE("Crawl");
+//
+// Zone names must have static storage duration (string literals).
+
+namespace nova::profiler
+{
+    struct Event
+    {
+        const char* name;
+        u64        begin;
+        u64          end;
+        u32        depth;
+    };
+
+    namespace detail
+    {
+        inline std::atomic<bool> Active = false;
+
+        NOVA_FORCE_INLINE
+        u64 ReadTimestamp() noexcept
+        {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return u64(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+        }
+
+        struct ThreadState
+        {
+            u32 depth = 0;
+        };
+
+        inline thread_local ThreadState State;
+
+        void Record(const Event& event);
+    }
+
+    // Begins recording, discarding events from any previous capture
+    void Start();
+    void Stop();
+
+    inline
+    bool IsActive() noexcept
+    {
+        return detail::Active.load(std::memory_order_relaxed);
+    }
+
+    // Names the calling thread in exported traces
+    void SetThreadName(std::string name);
+
+    // Exports events recorded by the last capture. Call after Stop()
+    void WriteChromeTrace(const fs::path& path);
+    void WriteBinary(const fs::path& path);
+
+    struct Scope
+    {
+        const char* name;
+        u64        begin = 0;
+
+        NOVA_FORCE_INLINE
+        Scope(const char* _name) noexcept
+            : name(_name)
+        {
+            if (IsActive()) {
+                detail::State.depth++;
+                begin = detail::ReadTimestamp();
+            }
+        }
+
+        NOVA_FORCE_INLINE
+        ~Scope()
+        {
+            if (begin) {
+                u64 end = detail::ReadTimestamp();
+                u32 depth = --detail::State.depth;
+                detail::Record({ name, begin, end, depth });
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+}
+
+#ifdef NOVA_PROFILER
+#  define NOVA_PROFILE_SCOPE(name) ::nova::profiler::Scope NOVA_UNIQUE_VAR(){ name }
+#  define NOVA_PROFILE_THREAD(name) ::nova::profiler::SetThreadName(name)
+#else
+#  define NOVA_PROFILE_SCOPE(name) do {} while (0)
+#  define NOVA_PROFILE_THREAD(name) do {} while (0)
+#endif
\ No newline at end of file
@@ -0,0 +1,228 @@
+#pragma once
+
+#include "nova_Core.hpp"
+
+// -----------------------------------------------------------------------------
+//                            Generational handles
+// -----------------------------------------------------------------------------
+
+namespace nova
+{
+    // Packed (index, generation) pair. The low IndexBits hold the slot index, the
+    // remaining bits hold the slot generation at the time the handle was issued.
+    // Generation 0 is never issued, so a zero-initialized handle is always null.
+    template<typename Storage, u32 IndexBits>
+    struct GenerationalHandle
+    {
+        static_assert(std::is_unsigned_v<Storage>);
+        static_assert(IndexBits > 0 && IndexBits < sizeof(Storage) * 8);
+
+        static constexpr u32     GenerationBits = sizeof(Storage) * 8 - IndexBits;
+        static constexpr Storage IndexMask      = (Storage(1) << IndexBits) - 1;
+        static constexpr Storage GenerationMask = Storage(~Storage(0)) >> IndexBits;
+        static constexpr Storage MaxIndex       = IndexMask;
+
+        Storage value = 0;
+
+    public:
+        constexpr GenerationalHandle() noexcept = default;
+
+        constexpr GenerationalHandle(Storage index, Storage generation) noexcept
+            : value((index & IndexMask) | ((generation & GenerationMask) << IndexBits))
+        {}
+
+        constexpr Storage      Index() const noexcept { return value & IndexMask; }
+        constexpr Storage Generation() const noexcept { return value >> IndexBits; }
+
+        constexpr explicit operator bool() const noexcept { return value; }
+
+        constexpr bool operator==(const GenerationalHandle&) const noexcept = default;
+
+        static constexpr Storage NextGeneration(Storage generation) noexcept
+        {
+            generation = (generation + 1) & GenerationMask;
+            return generation ? generation : 1;
+        }
+    };
+
+    // 1M slots, 4096 generations before reuse of a stale handle can go undetected
+    using SlotHandle32 = GenerationalHandle<u32, 20>;
+
+    // 4G slots, 4G generations
+    using SlotHandle64 = GenerationalHandle<u64, 32>;
+
+    using SlotHandle = SlotHandle64;
+}
+
+template<typename Storage, nova::u32 IndexBits>
+struct std::hash<nova::GenerationalHandle<Storage, IndexBits>>
+{
+    nova::usz operator()(const nova::GenerationalHandle<Storage, IndexBits>& handle) const noexcept
+    {
+        return std::hash<Storage>{}(handle.value);
+    }
+};
+
+// -----------------------------------------------------------------------------
+//                                 Slot map
+// -----------------------------------------------------------------------------
+
+namespace nova
+{
+    // Stores values densely for iteration, with O(1) insert/erase/lookup through
+    // generation checked handles. Erasing swaps the last value into the hole, so
+    // pointers/references to values are invalidated by insert and erase.
+    // Slot indices are recycled LIFO, keeping issued indices compact.
+    template<typename T, typename HandleT = SlotHandle>
+    class SlotMap
+    {
+    public:
+        using Handle  = HandleT;
+        using Storage = decltype(HandleT::value);
+
+    private:
+        static constexpr u32 InvalidIndex = UINT_MAX;
+
+        struct Slot
+        {
+            // Dense index while occupied, next free slot index while free
+            u32          index;
+            Storage generation;
+        };
+
+        std::vector<T>               values;
+        std::vector<u32>   dense_to_slot;
+        std::vector<Slot>          slots;
+        u32                    free_head = InvalidIndex;
+
+    public:
+        template<typename... Args>
+        Handle Emplace(Args&&... args)
+        {
+            u32 slot_index;
+            if (free_head != InvalidIndex) {
+                slot_index = free_head;
+                free_head = slots[slot_index].index;
+            } else {
+                if (slots.size() > usz(Handle::MaxIndex) || slots.size() >= InvalidIndex) [[unlikely]] {
+                    NOVA_THROW("SlotMap - Out of slots ({})", slots.size());
+                }
+                slot_index = u32(slots.size());
+                slots.emplace_back(InvalidIndex, Storage(1));
+            }
+
+            values.emplace_back(std::forward<Args>(args)...);
+            dense_to_slot.push_back(slot_index);
+
+            auto& slot = slots[slot_index];
+            slot.index = u32(values.size() - 1);
+
+            return Handle(Storage(slot_index), slot.generation);
+        }
+
+        Handle Insert(T value)
+        {
+            return Emplace(std::move(value));
+        }
+
+        bool Contains(Handle handle) const noexcept
+        {
+            usz slot_index = handle.Index();
+            return handle
+                && slot_index < slots.size()
+                && slots[slot_index].generation == handle.Generation();
+        }
+
+        // Returns nullptr for null or stale handles
+        T* Get(Handle handle) noexcept
+        {
+            return Contains(handle) ? &values[slots[handle.Index()].index] : nullptr;
+        }
+
+        const T* Get(Handle handle) const noexcept
+        {
+            return Contains(handle) ? &values[slots[handle.Index()].index] : nullptr;
+        }
+
+        T& operator[](Handle handle)
+        {
+            NOVA_ASSERT(Contains(handle), "SlotMap - Stale or invalid handle (index = {}, generation = {})",
+                u64(handle.Index()), u64(handle.Generation()));
+            return values[slots[handle.Index()].index];
+        }
+
+        const T& operator[](Handle handle) const
+        {
+            return const_cast<SlotMap&>(*this)[handle];
+        }
+
+        // Returns false if the handle was null or stale
+        bool Erase(Handle handle)
+        {
+            if (!Contains(handle)) {
+                return false;
+            }
+
+            u32 slot_index = u32(handle.Index());
+            auto& slot = slots[slot_index];
+
+            u32 dense_index = slot.index;
+            u32 last_index = u32(values.size() - 1);
+            if (dense_index != last_index) {
+                values[dense_index] = std::move(values[last_index]);
+                dense_to_slot[dense_index] = dense_to_slot[last_index];
+                slots[dense_to_slot[dense_index]].index = dense_index;
+            }
+            values.pop_back();
+            dense_to_slot.pop_back();
+
+            slot.generation = Handle::NextGeneration(slot.generation);
+            slot.index = free_head;
+            free_head = slot_index;
+
+            return true;
+        }
+
+        void Clear()
+        {
+            // Bump generations of occupied slots so that outstanding handles become stale
+            for (u32 slot_index : dense_to_slot) {
+                slots[slot_index].generation = Handle::NextGeneration(slots[slot_index].generation);
+            }
+
+            values.clear();
+            dense_to_slot.clear();
+
+            free_head = InvalidIndex;
+            for (u32 i = u32(slots.size()); i-- > 0;) {
+                slots[i].index = free_head;
+                free_head = i;
+            }
+        }
+
+        void Reserve(usz count)
+        {
+            values.reserve(count);
+            dense_to_slot.reserve(count);
+            slots.reserve(count);
+        }
+
+        usz  Size() const noexcept { return values.size(); }
+        bool Empty() const noexcept { return values.empty(); }
+
+        // Handle for the value at a given dense position, used when iterating
+        Handle HandleAt(usz dense_index) const noexcept
+        {
+            u32 slot_index = dense_to_slot[dense_index];
+            return Handle(Storage(slot_index), slots[slot_index].generation);
+        }
+
+        std::span<T>       Values()       noexcept { return values; }
+        std::span<const T> Values() const noexcept { return values; }
+
+        auto begin()       noexcept { return values.begin(); }
+        auto begin() const noexcept { return values.begin(); }
+        auto   end()       noexcept { return values.end(); }
+        auto   end() const noexcept { return values.end(); }
+    };
+}
\ No newline at end of file
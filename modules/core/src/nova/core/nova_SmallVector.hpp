@@ -0,0 +1,595 @@
+#pragma once
+
+#include "nova_Core.hpp"
+
+// -----------------------------------------------------------------------------
+//                              Small Vector
+// -----------------------------------------------------------------------------
+
+namespace nova
+{
+    // std::vector compatible container that stores up to N elements inline before
+    // falling back to Allocator. Iterators are invalidated by any growth, and by
+    // moves while the elements are stored inline.
+    template<typename T, usz N, typename Allocator = std::allocator<T>>
+    class SmallVector
+    {
+        static_assert(N > 0, "Use std::vector for SmallVector<T, 0>");
+
+        using AllocTraits = std::allocator_traits<Allocator>;
+
+    public:
+        using value_type      = T;
+        using allocator_type  = Allocator;
+        using size_type       = usz;
+        using difference_type = std::ptrdiff_t;
+        using reference       = T&;
+        using const_reference = const T&;
+        using pointer         = T*;
+        using const_pointer   = const T*;
+        using iterator        = T*;
+        using const_iterator  = const T*;
+
+        static constexpr usz InlineCapacity = N;
+
+    private:
+        T*                                   ptr = InlineData();
+        usz                                count = 0;
+        usz                          capacity_ = N;
+        [[no_unique_address]] Allocator alloc = {};
+        alignas(T) b8 storage[N * sizeof(T)];
+
+    private:
+        T*       InlineData()       noexcept { return reinterpret_cast<T*>(storage); }
+        const T* InlineData() const noexcept { return reinterpret_cast<const T*>(storage); }
+
+        void Grow(usz min_capacity)
+        {
+            usz new_capacity = std::max(min_capacity, capacity_ + capacity_ / 2);
+            T* new_ptr = AllocTraits::allocate(alloc, new_capacity);
+            std::uninitialized_move_n(ptr, count, new_ptr);
+            std::destroy_n(ptr, count);
+            Deallocate();
+            ptr = new_ptr;
+            capacity_ = new_capacity;
+        }
+
+        void Deallocate() noexcept
+        {
+            if (!is_inline()) {
+                AllocTraits::deallocate(alloc, ptr, capacity_);
+            }
+        }
+
+        void StealOrMove(SmallVector& other)
+        {
+            if (!other.is_inline() && alloc == other.alloc) {
+                ptr = std::exchange(other.ptr, other.InlineData());
+                count = std::exchange(other.count, 0);
+                capacity_ = std::exchange(other.capacity_, N);
+            } else {
+                reserve(other.count);
+                std::uninitialized_move_n(other.ptr, other.count, ptr);
+                count = other.count;
+                other.clear();
+            }
+        }
+
+    public:
+        SmallVector() noexcept = default;
+
+        explicit SmallVector(const Allocator& _alloc) noexcept
+            : alloc(_alloc)
+        {}
+
+        explicit SmallVector(usz size, const Allocator& _alloc = {})
+            : alloc(_alloc)
+        {
+            resize(size);
+        }
+
+        SmallVector(usz size, const T& value, const Allocator& _alloc = {})
+            : alloc(_alloc)
+        {
+            assign(size, value);
+        }
+
+        SmallVector(std::initializer_list<T> init, const Allocator& _alloc = {})
+            : alloc(_alloc)
+        {
+            assign(init.begin(), init.end());
+        }
+
+        template<std::input_iterator It>
+        SmallVector(It first, It last, const Allocator& _alloc = {})
+            : alloc(_alloc)
+        {
+            assign(first, last);
+        }
+
+        SmallVector(const SmallVector& other)
+            : alloc(AllocTraits::select_on_container_copy_construction(other.alloc))
+        {
+            assign(other.begin(), other.end());
+        }
+
+        SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : alloc(other.alloc)
+        {
+            StealOrMove(other);
+        }
+
+        SmallVector& operator=(const SmallVector& other)
+        {
+            if (this != &other) {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            if (this != &other) {
+                clear();
+                if (!other.is_inline() && alloc == other.alloc) {
+                    Deallocate();
+                    ptr = other.InlineData();
+                    capacity_ = N;
+                }
+                StealOrMove(other);
+            }
+            return *this;
+        }
+
+        SmallVector& operator=(std::initializer_list<T> init)
+        {
+            assign(init.begin(), init.end());
+            return *this;
+        }
+
+        ~SmallVector()
+        {
+            std::destroy_n(ptr, count);
+            Deallocate();
+        }
+
+// -----------------------------------------------------------------------------
+
+        template<std::input_iterator It>
+        void assign(It first, It last)
+        {
+            clear();
+            if constexpr (std::forward_iterator<It>) {
+                reserve(usz(std::distance(first, last)));
+            }
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+
+        void assign(usz size, const T& value)
+        {
+            clear();
+            reserve(size);
+            std::uninitialized_fill_n(ptr, size, value);
+            count = size;
+        }
+
+        allocator_type get_allocator() const noexcept { return alloc; }
+
+// -----------------------------------------------------------------------------
+
+        T&       operator[](usz i)       noexcept { return ptr[i]; }
+        const T& operator[](usz i) const noexcept { return ptr[i]; }
+
+        T& at(usz i)
+        {
+            if (i >= count) NOVA_THROW("SmallVector - Index {} out of range ({})", i, count);
+            return ptr[i];
+        }
+
+        const T& at(usz i) const
+        {
+            return const_cast<SmallVector&>(*this).at(i);
+        }
+
+        T&       front()       noexcept { return ptr[0]; }
+        const T& front() const noexcept { return ptr[0]; }
+        T&       back()        noexcept { return ptr[count - 1]; }
+        const T& back()  const noexcept { return ptr[count - 1]; }
+
+        T*       data()       noexcept { return ptr; }
+        const T* data() const noexcept { return ptr; }
+
+        iterator       begin()       noexcept { return ptr; }
+        const_iterator begin() const noexcept { return ptr; }
+        iterator       end()         noexcept { return ptr + count; }
+        const_iterator end()   const noexcept { return ptr + count; }
+
+        const_iterator cbegin() const noexcept { return ptr; }
+        const_iterator cend()   const noexcept { return ptr + count; }
+
+        auto rbegin()       noexcept { return std::reverse_iterator(end()); }
+        auto rbegin() const noexcept { return std::reverse_iterator(end()); }
+        auto rend()         noexcept { return std::reverse_iterator(begin()); }
+        auto rend()   const noexcept { return std::reverse_iterator(begin()); }
+
+// -----------------------------------------------------------------------------
+
+        bool empty()     const noexcept { return count == 0; }
+        usz  size()      const noexcept { return count; }
+        usz  capacity()  const noexcept { return capacity_; }
+        bool is_inline() const noexcept { return ptr == InlineData(); }
+
+        void reserve(usz new_capacity)
+        {
+            if (new_capacity > capacity_) {
+                Grow(new_capacity);
+            }
+        }
+
+        void shrink_to_fit()
+        {
+            if (is_inline() || count == capacity_) {
+                return;
+            }
+
+            if (count <= N) {
+                T* old_ptr = ptr;
+                usz old_capacity = capacity_;
+                std::uninitialized_move_n(old_ptr, count, InlineData());
+                std::destroy_n(old_ptr, count);
+                AllocTraits::deallocate(alloc, old_ptr, old_capacity);
+                ptr = InlineData();
+                capacity_ = N;
+            } else {
+                T* new_ptr = AllocTraits::allocate(alloc, count);
+                std::uninitialized_move_n(ptr, count, new_ptr);
+                std::destroy_n(ptr, count);
+                Deallocate();
+                ptr = new_ptr;
+                capacity_ = count;
+            }
+        }
+
+// -----------------------------------------------------------------------------
+
+        void clear() noexcept
+        {
+            std::destroy_n(ptr, count);
+            count = 0;
+        }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (count == capacity_) [[unlikely]] {
+                // Construct first in case args alias an element that is about to move
+                T value(std::forward<Args>(args)...);
+                Grow(count + 1);
+                return *std::construct_at(ptr + count++, std::move(value));
+            }
+            return *std::construct_at(ptr + count++, std::forward<Args>(args)...);
+        }
+
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value)      { emplace_back(std::move(value)); }
+
+        void pop_back() noexcept
+        {
+            std::destroy_at(ptr + --count);
+        }
+
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args&&... args)
+        {
+            usz index = usz(pos - ptr);
+            if (index == count) {
+                emplace_back(std::forward<Args>(args)...);
+                return ptr + index;
+            }
+
+            T value(std::forward<Args>(args)...);
+            emplace_back(std::move(back()));
+            std::move_backward(ptr + index, ptr + count - 2, ptr + count - 1);
+            ptr[index] = std::move(value);
+            return ptr + index;
+        }
+
+        iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+        iterator insert(const_iterator pos, T&& value)      { return emplace(pos, std::move(value)); }
+
+        template<std::input_iterator It>
+        iterator insert(const_iterator pos, It first, It last)
+        {
+            usz index = usz(pos - ptr);
+            usz old_count = count;
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+            std::rotate(ptr + index, ptr + old_count, ptr + count);
+            return ptr + index;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            T* f = ptr + (first - ptr);
+            T* l = ptr + (last - ptr);
+            if (f != l) {
+                T* new_end = std::move(l, ptr + count, f);
+                std::destroy(new_end, ptr + count);
+                count = usz(new_end - ptr);
+            }
+            return f;
+        }
+
+        void resize(usz size)
+        {
+            if (size < count) {
+                std::destroy(ptr + size, ptr + count);
+            } else {
+                reserve(size);
+                std::uninitialized_value_construct(ptr + count, ptr + size);
+            }
+            count = size;
+        }
+
+        void resize(usz size, const T& value)
+        {
+            if (size < count) {
+                std::destroy(ptr + size, ptr + count);
+            } else {
+                reserve(size);
+                std::uninitialized_fill(ptr + count, ptr + size, value);
+            }
+            count = size;
+        }
+
+// -----------------------------------------------------------------------------
+
+        friend bool operator==(const SmallVector& l, const SmallVector& r)
+        {
+            return std::ranges::equal(l, r);
+        }
+
+        friend auto operator<=>(const SmallVector& l, const SmallVector& r)
+        {
+            return std::lexicographical_compare_three_way(l.begin(), l.end(), r.begin(), r.end());
+        }
+    };
+
+    namespace pmr
+    {
+        // SmallVector that spills into a memory_resource, e.g. nova::ArenaResource
+        template<typename T, usz N>
+        using SmallVector = nova::SmallVector<T, N, std::pmr::polymorphic_allocator<T>>;
+    }
+}
+
+// -----------------------------------------------------------------------------
+//                              Inline String
+// -----------------------------------------------------------------------------
+
+namespace nova
+{
+    // Null terminated string with room for N characters inline. Mirrors the commonly
+    // used subset of std::string, and converts to std::string_view/StringView.
+    template<usz N, typename Allocator = std::allocator<char>>
+    class InlineString
+    {
+        SmallVector<char, N + 1, Allocator> chars = { '\0' };
+
+        // Growing the buffer would invalidate views into it
+        bool Aliases(std::string_view str) const noexcept
+        {
+            return std::less_equal<>{}(chars.data(), str.data())
+                && std::less<>{}(str.data(), chars.data() + chars.size());
+        }
+
+    public:
+        using value_type     = char;
+        using allocator_type = Allocator;
+        using size_type      = usz;
+        using iterator       = char*;
+        using const_iterator = const char*;
+
+        static constexpr usz npos = std::string_view::npos;
+        static constexpr usz InlineCapacity = N;
+
+    public:
+        InlineString() = default;
+
+        explicit InlineString(const Allocator& alloc)
+            : chars({ '\0' }, alloc)
+        {}
+
+        InlineString(std::string_view str, const Allocator& alloc = {})
+            : chars(alloc)
+        {
+            assign(str);
+        }
+
+        InlineString(const char* str, const Allocator& alloc = {})
+            : InlineString(std::string_view(str), alloc)
+        {}
+
+        InlineString(const std::string& str, const Allocator& alloc = {})
+            : InlineString(std::string_view(str), alloc)
+        {}
+
+        InlineString(usz count, char c, const Allocator& alloc = {})
+            : chars(alloc)
+        {
+            chars.assign(count, c);
+            chars.push_back('\0');
+        }
+
+        InlineString(const InlineString&) = default;
+        InlineString& operator=(const InlineString&) = default;
+
+        InlineString(InlineString&& other) noexcept
+            : chars(std::move(other.chars))
+        {
+            other.chars.push_back('\0');
+        }
+
+        InlineString& operator=(InlineString&& other) noexcept
+        {
+            if (this != &other) {
+                chars = std::move(other.chars);
+                other.chars.push_back('\0');
+            }
+            return *this;
+        }
+
+        InlineString& operator=(std::string_view str)
+        {
+            return assign(str);
+        }
+
+// -----------------------------------------------------------------------------
+
+        InlineString& assign(std::string_view str)
+        {
+            if (Aliases(str)) {
+                return assign(InlineString(str).view());
+            }
+
+            chars.resize(str.size() + 1);
+            std::memcpy(chars.data(), str.data(), str.size());
+            chars.back() = '\0';
+            return *this;
+        }
+
+        InlineString& append(std::string_view str)
+        {
+            if (Aliases(str)) {
+                return append(InlineString(str).view());
+            }
+
+            usz old_size = size();
+            chars.resize(old_size + str.size() + 1);
+            std::memcpy(chars.data() + old_size, str.data(), str.size());
+            chars.back() = '\0';
+            return *this;
+        }
+
+        InlineString& append(usz count, char c)
+        {
+            usz old_size = size();
+            chars.resize(old_size + count + 1, c);
+            chars[old_size + count] = '\0';
+            return *this;
+        }
+
+        void push_back(char c)
+        {
+            chars.back() = c;
+            chars.push_back('\0');
+        }
+
+        void pop_back() noexcept
+        {
+            chars.pop_back();
+            chars.back() = '\0';
+        }
+
+        InlineString& operator+=(std::string_view str) { return append(str); }
+        InlineString& operator+=(char c) { push_back(c); return *this; }
+
+        void clear() noexcept
+        {
+            chars.resize(1);
+            chars[0] = '\0';
+        }
+
+        void resize(usz size, char c = '\0')
+        {
+            chars.back() = c;
+            chars.resize(size + 1, c);
+            chars.back() = '\0';
+        }
+
+        void reserve(usz capacity)
+        {
+            chars.reserve(capacity + 1);
+        }
+
+// -----------------------------------------------------------------------------
+
+        usz  size()      const noexcept { return chars.size() - 1; }
+        usz  length()    const noexcept { return size(); }
+        bool empty()     const noexcept { return size() == 0; }
+        usz  capacity()  const noexcept { return chars.capacity() - 1; }
+        bool is_inline() const noexcept { return chars.is_inline(); }
+
+        char*       data()        noexcept { return chars.data(); }
+        const char* data()  const noexcept { return chars.data(); }
+        const char* c_str() const noexcept { return chars.data(); }
+
+        char&       operator[](usz i)       noexcept { return chars[i]; }
+        const char& operator[](usz i) const noexcept { return chars[i]; }
+
+        char&       front()       noexcept { return chars.front(); }
+        const char& front() const noexcept { return chars.front(); }
+        char&       back()        noexcept { return chars[size() - 1]; }
+        const char& back()  const noexcept { return chars[size() - 1]; }
+
+        iterator       begin()       noexcept { return chars.begin(); }
+        const_iterator begin() const noexcept { return chars.begin(); }
+        iterator       end()         noexcept { return chars.begin() + size(); }
+        const_iterator end()   const noexcept { return chars.begin() + size(); }
+
+// -----------------------------------------------------------------------------
+
+        std::string_view view() const noexcept { return { data(), size() }; }
+
+        operator std::string_view() const noexcept { return view(); }
+        // Include the terminator so that StringView::CStr() doesn't need to copy
+        operator StringView() const noexcept { return StringView(data(), size() + 1); }
+
+        explicit operator std::string() const { return std::string(view()); }
+
+        usz find(std::string_view str, usz pos = 0) const noexcept { return view().find(str, pos); }
+        usz find(char c, usz pos = 0)               const noexcept { return view().find(c, pos); }
+        usz rfind(std::string_view str, usz pos = npos) const noexcept { return view().rfind(str, pos); }
+        usz rfind(char c, usz pos = npos)               const noexcept { return view().rfind(c, pos); }
+
+        bool starts_with(std::string_view str) const noexcept { return view().starts_with(str); }
+        bool ends_with(std::string_view str)   const noexcept { return view().ends_with(str); }
+
+        std::string_view substr(usz pos, usz count = npos) const { return view().substr(pos, count); }
+
+        friend bool operator==(const InlineString& l, std::string_view r) noexcept { return l.view() == r; }
+        friend auto operator<=>(const InlineString& l, std::string_view r) noexcept { return l.view() <=> r; }
+    };
+
+    namespace pmr
+    {
+        template<usz N>
+        using InlineString = nova::InlineString<N, std::pmr::polymorphic_allocator<char>>;
+    }
+}
+
+template<nova::usz N, typename Allocator>
+struct std::hash<nova::InlineString<N, Allocator>>
+{
+    nova::usz operator()(const nova::InlineString<N, Allocator>& str) const noexcept
+    {
+        return std::hash<std::string_view>{}(str.view());
+    }
+};
+
+template<nova::usz N, typename Allocator>
+struct fmt::formatter<nova::InlineString<N, Allocator>> : fmt::formatter<std::string_view>
+{
+    auto format(const nova::InlineString<N, Allocator>& str, fmt::format_context& ctx) const
+    {
+        return fmt::formatter<std::string_view>::format(str.view(), ctx);
+    }
+};
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "nova_StringInterner.hpp"
+
+namespace nova
+{
+    namespace
+    {
+        constexpr u32 InitialSlots = 64;
+
+        // The low hash bits select the shard, so probe with the high bits
+        u32 SlotTag(u64 hash)
+        {
+            return u32(hash >> 32);
+        }
+    }
+
+    StringInterner::StringInterner(const StringInternerConfig& config)
+    {
+        u32 count = std::bit_ceil(std::max(config.shards, 1u));
+        shard_bits = u32(std::countr_zero(count));
+        shard_mask = count - 1;
+
+        block_reserve = std::clamp(config.block_reserve, usz(Arena::DefaultGranularity), MaxBlockReserve);
+
+        // Room for a page pointer per possible local id, only committed as pages are added
+        usz max_pages = (usz(InvalidId >> shard_bits) >> PageBits) + 1;
+        usz page_table_reserve = AlignUpPower2(max_pages * sizeof(Page*), Arena::DefaultGranularity);
+
+        shards = std::make_unique<Shard[]>(count);
+        for (u32 i = 0; i < count; ++i) {
+            auto& shard = shards[i];
+            shard.blocks.emplace_back(block_reserve);
+            shard.page_table = Arena(page_table_reserve);
+            shard.pages = static_cast<Page**>(shard.page_table.Alloc(0, alignof(Page*)));
+            shard.slots.resize(InitialSlots);
+        }
+    }
+
+    const StringInterner::Entry* StringInterner::FindEntry(const Shard& shard, StringView str, u64 hash) const noexcept
+    {
+        u32 tag = SlotTag(hash);
+        u32 mask = u32(shard.slots.size() - 1);
+        for (u32 i = tag & mask;; i = (i + 1) & mask) {
+            auto& slot = shard.slots[i];
+            if (slot.local == InvalidId) {
+                return nullptr;
+            }
+
+            if (slot.tag == tag) {
+                auto* entry = GetLocal(shard, slot.local);
+                if (entry->size == str.Size() && std::memcmp(entry->Data(), str.Data(), str.Size()) == 0) {
+                    return entry;
+                }
+            }
+        }
+    }
+
+    void StringInterner::Grow(Shard& shard)
+    {
+        std::vector<Slot> slots(shard.slots.size() * 2);
+        u32 mask = u32(slots.size() - 1);
+        u32 count = shard.count.load(std::memory_order_relaxed);
+        for (u32 local = 0; local < count; ++local) {
+            u32 tag = SlotTag(GetLocal(shard, local)->hash);
+            u32 i = tag & mask;
+            while (slots[i].local != InvalidId) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = { tag, local };
+        }
+        shard.slots = std::move(slots);
+    }
+
+    void* StringInterner::AllocBlockData(Shard& shard, usz size, usz align)
+    {
+        auto* block = &shard.blocks.back();
+        if (AlignUpPower2(block->Used(), align) + size > block->Reserved()) {
+            usz reserve = std::min(block->Reserved() * 2, MaxBlockReserve);
+            block = &shard.blocks.emplace_back(std::max(reserve, size + align));
+        }
+        return block->Alloc(size, align);
+    }
+
+    StringInterner::Id StringInterner::Intern(StringView str, u64 hash, bool* inserted)
+    {
+        auto& shard = shards[hash & shard_mask];
+
+        // Most calls find an existing string, so try under a shared lock first
+        {
+            std::shared_lock lock{ shard.mutex };
+            if (auto* entry = FindEntry(shard, str, hash)) {
+                if (inserted) *inserted = false;
+                return entry->id;
+            }
+        }
+
+        std::unique_lock lock{ shard.mutex };
+        if (auto* entry = FindEntry(shard, str, hash)) {
+            if (inserted) *inserted = false;
+            return entry->id;
+        }
+
+        if (str.Size() > UINT32_MAX) {
+            NOVA_THROW("StringInterner - String of length {} is too long", str.Size());
+        }
+
+        u32 local = shard.count.load(std::memory_order_relaxed);
+        if (local >= (InvalidId >> shard_bits)) {
+            NOVA_THROW("StringInterner - Shard overflow after {} strings", local);
+        }
+
+        // Keep the load factor at or below one half
+        if ((local + 1) * 2 > shard.slots.size()) {
+            Grow(shard);
+        }
+
+        if ((local & PageMask) == 0) {
+            *static_cast<Page**>(shard.page_table.Alloc(sizeof(Page*), alignof(Page*)))
+                = static_cast<Page*>(AllocBlockData(shard, sizeof(Page), alignof(Page)));
+        }
+
+        auto* entry = static_cast<Entry*>(AllocBlockData(shard, sizeof(Entry) + str.Size() + 1, alignof(Entry)));
+        entry->hash = hash;
+        entry->size = u32(str.Size());
+        entry->id = (local << shard_bits) | u32(hash & shard_mask);
+        auto* data = const_cast<char*>(entry->Data());
+        std::memcpy(data, str.Data(), str.Size());
+        data[str.Size()] = '\0';
+
+        shard.pages[local >> PageBits]->entries[local & PageMask] = entry;
+
+        u32 mask = u32(shard.slots.size() - 1);
+        u32 tag = SlotTag(hash);
+        u32 i = tag & mask;
+        while (shard.slots[i].local != InvalidId) {
+            i = (i + 1) & mask;
+        }
+        shard.slots[i] = { tag, local };
+
+        shard.count.store(local + 1, std::memory_order_relaxed);
+
+        if (inserted) *inserted = true;
+        return entry->id;
+    }
+
+    StringInterner::Id StringInterner::Find(StringView str, u64 hash) const
+    {
+        auto& shard = shards[hash & shard_mask];
+        std::shared_lock lock{ shard.mutex };
+        auto* entry = FindEntry(shard, str, hash);
+        return entry ? entry->id : InvalidId;
+    }
+
+    u32 StringInterner::Size() const noexcept
+    {
+        u32 size = 0;
+        for (u32 i = 0; i <= shard_mask; ++i) {
+            size += shards[i].count.load(std::memory_order_relaxed);
+        }
+        return size;
+    }
+
+    usz StringInterner::MemoryUsed() const noexcept
+    {
+        usz used = 0;
+        for (u32 i = 0; i <= shard_mask; ++i) {
+            auto& shard = shards[i];
+            std::shared_lock lock{ shard.mutex };
+            for (auto& block : shard.blocks) {
+                used += block.Used();
+            }
+            used += shard.page_table.Used() + shard.slots.capacity() * sizeof(Slot);
+        }
+        return used;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "nova_Core.hpp"
+
+// -----------------------------------------------------------------------------
+//                              String Interning
+// -----------------------------------------------------------------------------
+
+// Deduplicates strings into stable 32-bit ids. Each unique string is copied once into
+// arena blocks and never moves, so views remain valid for the lifetime of the interner.
+// Interned strings are null terminated and carry their hash for reuse as map keys.
+//
+//   StringInterner names;
+//   auto id = names.Intern("nova_Core.hpp");
+//   names.Get(id);      // "nova_Core.hpp"
+//   names.GetHash(id);  // hash::Hash of the contents
+//
+// Strings are sharded on their hash, with ids carrying the shard in their low bits.
+// Concurrent inserts only contend within a shard, and resolving an id takes no lock.
+// With a single shard ids are dense and assigned in insertion order.
+
+namespace nova
+{
+    struct StringInternerConfig
+    {
+        // Rounded up to a power of two
+        u32 shards = 64;
+
+        // Virtual memory reserved for each shard's first block of string data. Full shards
+        // reserve further blocks, each twice the size of the last up to MaxBlockReserve.
+        usz block_reserve = 1ull << 20;
+    };
+
+    class StringInterner
+    {
+    public:
+        using Id = u32;
+        static constexpr Id InvalidId = ~0u;
+
+    private:
+        // Followed by the string contents and a null terminator
+        struct Entry
+        {
+            u64 hash;
+            u32 size;
+            Id    id;
+
+            const char* Data() const noexcept
+            {
+                return reinterpret_cast<const char*>(this + 1);
+            }
+        };
+
+        struct Slot
+        {
+            u32  tag = 0;
+            u32 local = InvalidId;
+        };
+
+        // Entries by local id, in fixed pages so the table grows without moving
+        static constexpr u32 PageBits = 12;
+        static constexpr u32 PageMask = (1u << PageBits) - 1;
+
+        struct Page
+        {
+            const Entry* entries[1u << PageBits];
+        };
+
+        struct alignas(64) Shard
+        {
+            std::shared_mutex      mutex;
+            std::vector<Arena>    blocks; // Arenas never move their memory, only the vector's handles move
+            Arena             page_table;
+            Page**                 pages = nullptr;
+            std::atomic<u32>       count = 0;
+            std::vector<Slot>      slots;
+        };
+
+        std::unique_ptr<Shard[]> shards;
+        u32                  shard_bits = 0;
+        u32                  shard_mask = 0;
+        usz               block_reserve = 0;
+
+    public:
+        explicit StringInterner(const StringInternerConfig& config = {});
+
+        StringInterner(const StringInterner&) = delete;
+        StringInterner& operator=(const StringInterner&) = delete;
+
+        static constexpr usz MaxBlockReserve = 256ull << 20;
+
+// -----------------------------------------------------------------------------
+
+        static u64 Hash(StringView str) noexcept
+        {
+            return hash::Hash(str.Data(), str.Size());
+        }
+
+        // Returns the id of an existing equal string, or copies it in. Safe to call concurrently
+        Id Intern(StringView str, u64 hash, bool* inserted = nullptr);
+        Id Intern(StringView str, bool* inserted = nullptr)
+        {
+            return Intern(str, Hash(str), inserted);
+        }
+
+        // Returns InvalidId if the string has not been interned
+        Id Find(StringView str, u64 hash) const;
+        Id Find(StringView str) const
+        {
+            return Find(str, Hash(str));
+        }
+
+// -----------------------------------------------------------------------------
+
+        // Ids must have been returned by this interner
+
+        StringView Get(Id id) const noexcept
+        {
+            auto* entry = GetEntry(id);
+            return StringView(entry->Data(), entry->size);
+        }
+
+        const char* CStr(Id id) const noexcept
+        {
+            return GetEntry(id)->Data();
+        }
+
+        u64 GetHash(Id id) const noexcept
+        {
+            return GetEntry(id)->hash;
+        }
+
+// -----------------------------------------------------------------------------
+
+        u32 GetShardCount() const noexcept
+        {
+            return shard_mask + 1;
+        }
+
+        // Number of unique strings
+        u32 Size() const noexcept;
+
+        usz MemoryUsed() const noexcept;
+
+    private:
+        static const Entry* GetLocal(const Shard& shard, u32 local) noexcept
+        {
+            return shard.pages[local >> PageBits]->entries[local & PageMask];
+        }
+
+        const Entry* GetEntry(Id id) const noexcept
+        {
+            return GetLocal(shards[id & shard_mask], id >> shard_bits);
+        }
+
+        const Entry* FindEntry(const Shard& shard, StringView str, u64 hash) const noexcept;
+        void Grow(Shard& shard);
+        void* AllocBlockData(Shard& shard, usz size, usz align);
+    };
+}
\ No newline at end of file
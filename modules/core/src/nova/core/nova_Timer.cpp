@@ -0,0 +1,136 @@
+#include "nova_Timer.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#  include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+#  include <intrin.h>
+#endif
+
+namespace nova
+{
+    namespace
+    {
+        using namespace std::chrono;
+
+        // Spin at least this long, to absorb scheduling noise the estimate hasn't seen yet
+        constexpr nanoseconds MinSpinMargin = 20us;
+        constexpr nanoseconds MaxSpinMargin = 2ms;
+
+        void CpuRelax()
+        {
+#if defined(_M_X64) || defined(__x86_64__)
+            _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+            __yield();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#endif
+        }
+    }
+
+    nanoseconds Timer::GetSpinMargin() const noexcept
+    {
+        return spin_margin;
+    }
+
+    void Timer::SetInitialLatency(nanoseconds latency)
+    {
+        latencies.fill(latency);
+        AddLatencySample(latency);
+    }
+
+    void Timer::AddLatencySample(nanoseconds latency)
+    {
+        latencies[latency_index] = latency;
+        latency_index = (latency_index + 1) % LatencySamples;
+
+        // Sized from the 75th percentile rather than a moving average, as preemption
+        // shows up as occasional wakeups that are milliseconds late and would otherwise
+        // keep the margin (and the time spent spinning) inflated
+        auto sorted = latencies;
+        auto p75 = sorted.begin() + LatencySamples * 3 / 4;
+        std::ranges::nth_element(sorted, p75);
+        spin_margin = std::clamp(*p75 + *p75 / 2 + MinSpinMargin, MinSpinMargin, MaxSpinMargin);
+    }
+
+    bool Timer::ConsumeSignal()
+    {
+        if (!signaled.exchange(false, std::memory_order_acquire)) {
+            return false;
+        }
+        ClearWakeup();
+        return true;
+    }
+
+    bool Timer::WaitUntil(steady_clock::time_point deadline)
+    {
+        if (ConsumeSignal()) {
+            return false;
+        }
+
+        // Sleeping for at least half of every wait keeps latency samples coming in, so
+        // a margin inflated by a burst of late wakeups can recover even for short waits
+        auto margin = std::min<steady_clock::duration>(spin_margin, (deadline - steady_clock::now()) / 2);
+        if (margin >= MinSpinMargin) {
+            auto target = deadline - margin;
+            if (!SleepUntil(target)) {
+                ConsumeSignal();
+                return false;
+            }
+
+            AddLatencySample(duration_cast<nanoseconds>(steady_clock::now() - target));
+        }
+
+        while (steady_clock::now() < deadline) {
+            if (signaled.load(std::memory_order_relaxed)) {
+                ConsumeSignal();
+                return false;
+            }
+            CpuRelax();
+        }
+
+        return true;
+    }
+
+// -----------------------------------------------------------------------------
+
+    FramePacer::FramePacer(nanoseconds _interval)
+        : interval(duration_cast<steady_clock::duration>(_interval))
+    {}
+
+    void FramePacer::SetInterval(nanoseconds _interval)
+    {
+        interval = duration_cast<steady_clock::duration>(_interval);
+    }
+
+    bool FramePacer::WaitForNextFrame()
+    {
+        auto now = steady_clock::now();
+        if (next == steady_clock::time_point{}) {
+            next = now + interval;
+        } else if (now > next) {
+            // Overran, skip to the first boundary still ahead
+            u64 skipped = u64((now - next) / interval) + 1;
+            missed += skipped;
+            next += interval * skipped;
+        }
+
+        if (!timer.WaitUntil(next)) {
+            return false;
+        }
+
+        frames++;
+        next += interval;
+        return true;
+    }
+
+    void FramePacer::Interrupt()
+    {
+        timer.Signal();
+    }
+
+    void FramePacer::Reset()
+    {
+        next = {};
+    }
+}
\ No newline at end of file
@@ -2,27 +2,101 @@
 
 #include "nova_Core.hpp"
 
+// -----------------------------------------------------------------------------
+//                           High resolution timers
+// -----------------------------------------------------------------------------
+
+// Waits block on an OS timer (timerfd on Linux, a high resolution waitable timer on
+// Windows) until shortly before the deadline, then spin for the remainder. The spin
+// margin follows the recent wakeup latency of each timer, so a wait usually spins
+// for tens of microseconds instead of occupying a core for the whole interval.
+//
+//   FramePacer pacer{ 6'944'444ns }; // 144 Hz
+//   while (running) {
+//       if (!pacer.WaitForNextFrame()) continue; // Interrupted, e.g. to handle a resize
+//       Render();
+//   }
+
 namespace nova
 {
     class Timer
     {
-        void* handle;
+    public:
+        struct Impl;
+
+    private:
+        Impl*                            impl = nullptr;
+        std::atomic<bool>            signaled = false;
 
+        // Recent OS timer wakeup latencies, used to size the spin margin
+        static constexpr u32 LatencySamples = 16;
+        std::array<std::chrono::nanoseconds, LatencySamples> latencies;
+        u32                                               latency_index = 0;
+        std::chrono::nanoseconds                            spin_margin = {};
+
+    public:
         Timer();
         ~Timer();
 
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        // Ends the current wait early, or the next one if no thread is waiting.
+        // Safe to call from any thread.
         void Signal();
 
-        bool WaitNanos(std::chrono::nanoseconds duration, bool preempt = false);
+        // Returns false if interrupted by Signal before the deadline
+        bool WaitUntil(std::chrono::steady_clock::time_point deadline);
 
         template<typename Rep, typename Period>
-        bool Wait(std::chrono::duration<Rep, Period> duration, bool preempt = false)
+        bool Wait(std::chrono::duration<Rep, Period> duration)
         {
-            if (duration <= 0ns) {
-                return false;
-            }
-
-            return WaitNanos(std::chrono::duration_cast<std::chrono::nanoseconds>(duration), preempt);
+            return WaitUntil(std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration));
         }
+
+        // How long before a deadline the next wait will stop sleeping and start spinning
+        std::chrono::nanoseconds GetSpinMargin() const noexcept;
+
+    private:
+        // Blocks on the OS timer until target. Returns false if woken by a signal
+        bool SleepUntil(std::chrono::steady_clock::time_point target);
+        void ClearWakeup();
+
+        bool ConsumeSignal();
+        void SetInitialLatency(std::chrono::nanoseconds latency);
+        void AddLatencySample(std::chrono::nanoseconds latency);
+    };
+
+// -----------------------------------------------------------------------------
+
+    // Paces a loop to fixed frame boundaries. Boundaries are multiples of the interval
+    // from the first frame, so time spent between waits does not accumulate as drift.
+    // When a frame overruns a boundary the missed boundaries are skipped, not caught up.
+    class FramePacer
+    {
+        Timer                                     timer;
+        std::chrono::steady_clock::duration    interval;
+        std::chrono::steady_clock::time_point      next = {};
+        u64                                      frames = 0;
+        u64                                      missed = 0;
+
+    public:
+        explicit FramePacer(std::chrono::nanoseconds interval);
+
+        // Takes effect from the next frame
+        void SetInterval(std::chrono::nanoseconds interval);
+
+        // Returns false if interrupted, in which case the pending boundary is kept
+        bool WaitForNextFrame();
+
+        // Wakes a thread in WaitForNextFrame. Safe to call from any thread
+        void Interrupt();
+
+        // Starts a new schedule from the next wait
+        void Reset();
+
+        u64 GetFrameCount()  const noexcept { return frames; }
+        u64 GetMissedFrames() const noexcept { return missed; }
+        std::chrono::steady_clock::time_point GetNextFrameTime() const noexcept { return next; }
     };
 }
\ No newline at end of file
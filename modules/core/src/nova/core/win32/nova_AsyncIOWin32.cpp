@@ -0,0 +1,108 @@
+#include <nova/core/nova_AsyncIO.hpp>
+
+#include "nova_Win32.hpp"
+
+// Windows uses the thread pool backend. Handles are opened for synchronous access and
+// reads and writes pass their offset through OVERLAPPED, so requests on the same file
+// may run concurrently on different workers.
+
+namespace nova::io::detail
+{
+    namespace
+    {
+        HANDLE ToHandle(NativeFile file)
+        {
+            return reinterpret_cast<HANDLE>(file);
+        }
+
+        OVERLAPPED ToOverlapped(u64 offset)
+        {
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = DWORD(offset);
+            overlapped.OffsetHigh = DWORD(offset >> 32);
+            return overlapped;
+        }
+
+        // 100ns intervals between 1601-01-01 and 1970-01-01
+        constexpr i64 UnixEpochFileTime = 116'444'736'000'000'000;
+
+        // Single reads and writes are capped at just under 2GiB
+        constexpr u64 MaxTransfer = 0x7fff'f000;
+    }
+
+    void Execute(Operation& op)
+    {
+        auto& request = op.request;
+        auto& result = op.result;
+
+        auto check = [&](BOOL success) {
+            if (!success) {
+                result.error = i32(::GetLastError());
+            }
+        };
+
+        switch (request.type) {
+            break;case OpType::Open: {
+                DWORD access = 0;
+                if (request.flags >= OpenFlags::Read)  access |= GENERIC_READ;
+                if (request.flags >= OpenFlags::Write) access |= GENERIC_WRITE;
+
+                DWORD disposition = OPEN_EXISTING;
+                if (request.flags >= (OpenFlags::Create | OpenFlags::Truncate)) disposition = CREATE_ALWAYS;
+                else if (request.flags >= OpenFlags::Create)                    disposition = OPEN_ALWAYS;
+                else if (request.flags >= OpenFlags::Truncate)                  disposition = TRUNCATE_EXISTING;
+
+                HANDLE file = ::CreateFileW(ToUtf16(request.path).c_str(), access, FILE_SHARE_READ,
+                    nullptr, disposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+                check(file != INVALID_HANDLE_VALUE);
+                if (result.Ok()) {
+                    result.result = reinterpret_cast<NativeFile>(file);
+                }
+            }
+            break;case OpType::Close:
+                check(::CloseHandle(ToHandle(request.file)));
+            break;case OpType::Read: {
+                DWORD transferred = 0;
+                OVERLAPPED overlapped = ToOverlapped(request.offset);
+                BOOL success = ::ReadFile(ToHandle(request.file), request.buffer, DWORD(std::min(request.size, MaxTransfer)), &transferred, &overlapped);
+
+                // Reading at or past the end of file is not an error
+                if (!success && ::GetLastError() == ERROR_HANDLE_EOF) {
+                    success = TRUE;
+                }
+                check(success);
+                result.result = transferred;
+            }
+            break;case OpType::Write: {
+                DWORD transferred = 0;
+                OVERLAPPED overlapped = ToOverlapped(request.offset);
+                check(::WriteFile(ToHandle(request.file), request.buffer, DWORD(std::min(request.size, MaxTransfer)), &transferred, &overlapped));
+                result.result = transferred;
+            }
+            break;case OpType::Stat: {
+                WIN32_FILE_ATTRIBUTE_DATA data;
+                check(::GetFileAttributesExW(ToUtf16(request.path).c_str(), GetFileExInfoStandard, &data));
+                if (result.Ok()) {
+                    i64 file_time = i64(u64(data.ftLastWriteTime.dwHighDateTime) << 32 | data.ftLastWriteTime.dwLowDateTime);
+                    request.stat->size = u64(data.nFileSizeHigh) << 32 | data.nFileSizeLow;
+                    request.stat->last_write_ns = (file_time - UnixEpochFileTime) * 100;
+                    request.stat->is_directory = data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY;
+                }
+            }
+        }
+    }
+
+    RingBackend* CreateRing(Queue::Impl*, u32)
+    {
+        return nullptr;
+    }
+
+    void DestroyRing(RingBackend*)
+    {
+    }
+
+    void SubmitRing(RingBackend*, std::span<Operation*>)
+    {
+        NOVA_THROW("io_uring is not available on Windows");
+    }
+}
\ No newline at end of file
@@ -35,54 +35,86 @@ namespace nova
         return timer_resolution.min_quantum;
     }
 
+    struct Timer::Impl
+    {
+        HANDLE timer = nullptr;
+        HANDLE event = nullptr;
+    };
+
     Timer::Timer()
     {
-        handle = ::CreateWaitableTimerW(nullptr, true, nullptr);
-        if (!handle) {
-            NOVA_THROW("Failed to create Win32 timer");
+        impl = new Impl;
+        NOVA_CLEANUP_ON_EXCEPTION(&) {
+            if (impl->timer) ::CloseHandle(impl->timer);
+            delete impl;
+        };
+
+        // High resolution timers (Windows 10 1803+) are not bound to the global timer
+        // resolution; fall back to a regular timer with the resolution raised instead.
+        impl->timer = ::CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        if (impl->timer) {
+            SetInitialLatency(std::chrono::microseconds(500));
+        } else {
+            impl->timer = ::CreateWaitableTimerW(nullptr, true, nullptr);
+            if (!impl->timer) {
+                NOVA_THROW("Failed to create Win32 timer");
+            }
+            SetInitialLatency(GetMinQuantum());
+        }
+
+        impl->event = ::CreateEventW(nullptr, false, false, nullptr);
+        if (!impl->event) {
+            NOVA_THROW("Failed to create Win32 event");
         }
     }
 
     Timer::~Timer()
     {
-        if (handle) {
-            ::CloseHandle(handle);
-        }
+        ::CloseHandle(impl->timer);
+        ::CloseHandle(impl->event);
+        delete impl;
     }
 
     void Timer::Signal()
     {
-        LARGE_INTEGER li;
-        li.QuadPart = 0;
-        ::SetWaitableTimer(handle, &li, 0, nullptr, nullptr, false);
+        signaled.store(true, std::memory_order_release);
+        ::SetEvent(impl->event);
     }
 
-    bool Timer::WaitNanos(std::chrono::nanoseconds duration, bool preempt)
+    void Timer::ClearWakeup()
     {
-        if (duration <= 0ns) {
-            return false;
-        }
-
-        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(duration);
-
-        if (preempt) {
-            if (duration < GetMinQuantum()) {
-                return true;
-            }
+        ::ResetEvent(impl->event);
+    }
 
-            nanos -= GetMinQuantum();
+    bool Timer::SleepUntil(std::chrono::steady_clock::time_point target)
+    {
+        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(target - std::chrono::steady_clock::now());
+        if (nanos <= 0ns) {
+            return true;
         }
 
         LARGE_INTEGER li;
-        li.QuadPart = -(nanos.count() / 100);
-        if (!::SetWaitableTimer(handle, &li, 0, nullptr, nullptr, false)) {
+        li.QuadPart = -std::max(nanos.count() / 100, 1ll);
+        if (!::SetWaitableTimer(impl->timer, &li, 0, nullptr, nullptr, false)) {
             NOVA_THROW("Timer::Wait - Failed to set Win32 timer");
         }
 
-        if (auto res = ::WaitForSingleObject(handle, INFINITE); res != WAIT_OBJECT_0) {
-            NOVA_THROW("Timer::Wait - Failed to wait on Win32 timer");
-        }
+        HANDLE handles[] { impl->timer, impl->event };
+        for (;;) {
+            auto res = ::WaitForMultipleObjects(2, handles, false, INFINITE);
+            if (res == WAIT_OBJECT_0) {
+                return true;
+            }
+
+            if (res != WAIT_OBJECT_0 + 1) {
+                NOVA_THROW("Timer::Wait - Failed to wait on Win32 timer");
+            }
 
-        return preempt;
+            // The event may be left over from a signal already consumed by a previous wait
+            if (signaled.load(std::memory_order_acquire)) {
+                ::CancelWaitableTimer(impl->timer);
+                return false;
+            }
+        }
     }
 };
\ No newline at end of file
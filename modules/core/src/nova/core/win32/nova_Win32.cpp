@@ -3,6 +3,7 @@
 #include "shellapi.h"
 #include "userenv.h"
 #include "shlobj_core.h"
+#include "psapi.h"
 
 namespace {
     std::monostate Win32_EnableUTF8 = []() -> std::monostate {
@@ -17,20 +18,22 @@ namespace {
 
 namespace nova
 {
-    void* AllocVirtual(AllocationType type, usz size)
+    void* AllocVirtual(AllocationType type, usz size, void* address)
     {
         DWORD win_type = {};
         if (type >= AllocationType::Commit)  win_type |= MEM_COMMIT;
         if (type >= AllocationType::Reserve) win_type |= MEM_RESERVE;
-        return VirtualAlloc(nullptr, size, win_type, PAGE_READWRITE);
+        return VirtualAlloc(address, size, win_type, PAGE_READWRITE);
     }
 
     void FreeVirtual(FreeType type, void* ptr, usz size)
     {
-        DWORD win_type = {};
-        if (type >= FreeType::Decommit) win_type |= MEM_DECOMMIT;
-        if (type >= FreeType::Release)  win_type |= MEM_RELEASE;
-        VirtualFree(ptr, size, win_type);
+        // MEM_RELEASE always frees the entire reservation and requires a size of 0
+        if (type >= FreeType::Release) {
+            VirtualFree(ptr, 0, MEM_RELEASE);
+        } else {
+            VirtualFree(ptr, size, MEM_DECOMMIT);
+        }
     }
 }
 
@@ -99,4 +102,38 @@ namespace nova::env
 
         return out;
     }
+}
+
+// -----------------------------------------------------------------------------
+//                          Win32 Resource Usage
+// -----------------------------------------------------------------------------
+
+namespace nova::env
+{
+    std::chrono::nanoseconds GetThreadCpuTime()
+    {
+        FILETIME creation_time, exit_time, kernel_time, user_time;
+        if (!::GetThreadTimes(::GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time)) {
+            NOVA_THROW(win::LastErrorString());
+        }
+
+        auto user_ticks = std::bit_cast<ULARGE_INTEGER>(user_time).QuadPart;
+        auto kernel_ticks = std::bit_cast<ULARGE_INTEGER>(kernel_time).QuadPart;
+
+        // FILETIME is measured in 100ns intervals
+        return std::chrono::nanoseconds((user_ticks + kernel_ticks) * 100);
+    }
+
+    MemoryUsage GetProcessMemoryUsage()
+    {
+        PROCESS_MEMORY_COUNTERS counters = {};
+        if (!::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters))) {
+            NOVA_THROW(win::LastErrorString());
+        }
+
+        return MemoryUsage {
+            .resident = counters.WorkingSetSize,
+            .peak_resident = counters.PeakWorkingSetSize,
+        };
+    }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nova/core/nova_Core.hpp>
+#include <nova/core/nova_Metrics.hpp>
 
 #include <variant>
 
@@ -19,6 +20,17 @@ namespace nova
         inline std::atomic<u64> MemoryAllocated = 0;
 
         inline bool ThrowOnAllocation = false;
+
+        // Published through the metrics registry. The accumulators above are left as is
+        // since examples periodically exchange them for per-frame averages.
+
+        inline metrics::Histogram SubmitLatency { "rhi.queue_submit_ns", "Time spent in vkQueueSubmit2" };
+        inline metrics::Histogram PresentLatency{ "rhi.queue_present_ns", "Time spent in vkQueuePresentKHR" };
+
+        inline metrics::Gauge AllocationCountGauge{ "rhi.allocations", "Live device memory allocations",
+            [] { return i64(AllocationCount.load(std::memory_order_relaxed)); } };
+        inline metrics::Gauge MemoryAllocatedGauge{ "rhi.memory_allocated_bytes", "Device memory currently allocated",
+            [] { return i64(MemoryAllocated.load(std::memory_order_relaxed)); } };
     }
 
 // -----------------------------------------------------------------------------
@@ -288,7 +288,9 @@ namespace nova
                 .pImageIndices = indices,
                 .pResults = results,
             }));
-            rhi::stats::TimePresenting += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            auto present_time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            rhi::stats::TimePresenting += present_time.count();
+            rhi::stats::PresentLatency.Record(present_time);
 
             for (u32 i = 0; i < swapchains.size(); ++i) {
                 if (results[i] == VK_ERROR_OUT_OF_DATE_KHR || results[i] == VK_SUBOPTIMAL_KHR) {
@@ -25,13 +25,17 @@ namespace nova
         }), context->alloc, &impl->sampler));
 
         {
-            std::scoped_lock lock{ context->global_heap.mutex };
-            impl->descriptor_index = context->global_heap.sampler_handles.Acquire();
+            auto& heap = context->global_heap;
+            std::scoped_lock lock{ heap.mutex };
+            if (heap.sampler_handles.Size() >= heap.sampler_descriptor_count) {
+                NOVA_THROW("DescriptorHeap - Out of sampler descriptors ({})", heap.sampler_descriptor_count);
+            }
+            impl->descriptor = heap.sampler_handles.Insert(impl);
 #ifdef NOVA_RHI_NOISY_ALLOCATIONS
-            Log("Sampler Descriptor Acquired: {}", impl->descriptorIndex);
+            Log("Sampler Descriptor Acquired: {}", impl->descriptor.Index());
 #endif
         }
-        context->global_heap.WriteSampler(impl->descriptor_index, impl);
+        context->global_heap.WriteSampler(u32(impl->descriptor.Index()), impl);
 
         return { impl };
     }
@@ -46,9 +50,11 @@ namespace nova
 
         {
             std::scoped_lock lock{ impl->context->global_heap.mutex };
-            impl->context->global_heap.sampler_handles.Release(impl->descriptor_index);
+            if (!impl->context->global_heap.sampler_handles.Erase(impl->descriptor)) {
+                NOVA_THROW("Sampler - Descriptor {} released twice", impl->descriptor.Index());
+            }
 #ifdef NOVA_RHI_NOISY_ALLOCATIONS
-            Log("Sampler Descriptor Released: {}", impl->descriptorIndex);
+            Log("Sampler Descriptor Released: {}", impl->descriptor.Index());
 #endif
         }
 
@@ -58,7 +64,7 @@ namespace nova
 
     SamplerDescriptor Sampler::Descriptor() const
     {
-        return impl->descriptor_index;
+        return u32(impl->descriptor.Index());
     }
 
 // -----------------------------------------------------------------------------
@@ -206,13 +212,15 @@ namespace nova
             vmaDestroyImage(impl->context->vma, impl->image, impl->allocation);
         }
 
-        if (impl->descriptor_index != UINT_MAX) {
+        if (impl->descriptor) {
             auto& heap = impl->context->global_heap;
             std::scoped_lock lock{ heap.mutex };
-            impl->context->global_heap.image_handles.Release(impl->descriptor_index);
+            if (!heap.image_handles.Erase(impl->descriptor)) {
+                NOVA_THROW("Image - Descriptor {} released twice", impl->descriptor.Index());
+            }
 #ifdef NOVA_RHI_NOISY_ALLOCATIONS
             Log("Image Descriptor Released: {} (total = {})",
-                impl->descriptorIndex, heap.imageHandles.nextIndex - heap.imageHandles.freeList.size());
+                impl->descriptor.Index(), heap.image_handles.Size());
 #endif
         }
 
@@ -222,25 +230,28 @@ namespace nova
 
     ImageDescriptor Image::Descriptor() const
     {
-        if (impl->descriptor_index == UINT_MAX) {
+        if (!impl->descriptor) {
             auto& heap = impl->context->global_heap;
             {
                 std::scoped_lock lock{ heap.mutex };
-                impl->descriptor_index = heap.image_handles.Acquire();
+                if (heap.image_handles.Size() >= heap.image_descriptor_count) {
+                    NOVA_THROW("DescriptorHeap - Out of image descriptors ({})", heap.image_descriptor_count);
+                }
+                impl->descriptor = heap.image_handles.Insert(*this);
 #ifdef NOVA_RHI_NOISY_ALLOCATIONS
                 Log("Image Descriptor Acquired: {} (total = {})",
-                    impl->descriptorIndex, heap.imageHandles.nextIndex - heap.imageHandles.freeList.size());
+                    impl->descriptor.Index(), heap.image_handles.Size());
 #endif
             }
             if (impl->usage >= nova::ImageUsage::Sampled) {
-                heap.WriteSampled(impl->descriptor_index, *this);
+                heap.WriteSampled(u32(impl->descriptor.Index()), *this);
             }
             if (impl->usage >= nova::ImageUsage::Storage) {
-                heap.WriteStorage(impl->descriptor_index, *this);
+                heap.WriteStorage(u32(impl->descriptor.Index()), *this);
             }
         }
 
-        return impl->descriptor_index;
+        return u32(impl->descriptor.Index());
     }
 
     Vec3U Image::Extent() const
@@ -255,6 +266,8 @@ namespace nova
 
     void Image::Set(Vec3I offset, Vec3U extent, const void* data) const
     {
+        NOVA_PROFILE_SCOPE("Image::Set");
+
         // TODO: Layers
         // TODO: Mips
 
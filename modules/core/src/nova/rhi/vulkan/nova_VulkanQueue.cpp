@@ -68,7 +68,9 @@ namespace nova
             .pSignalSemaphoreInfos = &signal_info,
         }), nullptr));
 
-        rhi::stats::TimeSubmitting += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        auto submit_time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        rhi::stats::TimeSubmitting += submit_time.count();
+        rhi::stats::SubmitLatency.Record(submit_time);
 
         for (auto& list : command_lists) {
             impl->MoveCommandListToPending(list);
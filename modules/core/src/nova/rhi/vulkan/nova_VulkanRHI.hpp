@@ -1,6 +1,9 @@
 #pragma once
 
 #include <nova/rhi/nova_RHI.hpp>
+#include <nova/core/nova_Pool.hpp>
+#include <nova/core/nova_SlotMap.hpp>
+#include <nova/core/nova_Profiler.hpp>
 
 #ifndef VK_NO_PROTOTYPES
 #  define VK_NO_PROTOTYPES
@@ -27,11 +30,10 @@ namespace nova
         template<typename VulkanType, typename Fn, typename ...Args>
         Span<VulkanType> StackEnumerate(Fn&& fn, Args&&... args)
         {
-            auto& stack = detail::GetThreadStack();
-            VulkanType* begin = reinterpret_cast<VulkanType*>(stack.ptr);
-            u32 count = UINT_MAX;
+            u32 count = 0;
+            fn(args..., &count, nullptr);
+            VulkanType* begin = detail::StackAlloc<VulkanType>(count);
             fn(args..., &count, begin);
-            stack.ptr = AlignUpPower2(reinterpret_cast<std::byte*>(begin + count), 16);
             return { begin, count };
         }
 
@@ -152,8 +154,8 @@ namespace nova
         u64 storage_offset, storage_stride;
         u64 sampler_offset, sampler_stride;
 
-        IndexFreeList   image_handles;
-        IndexFreeList sampler_handles;
+        SlotMap<HImage>     image_handles;
+        SlotMap<HSampler> sampler_handles;
 
         std::shared_mutex mutex;
 
@@ -240,6 +242,8 @@ namespace nova
         void*      host_address = 0ull;
         BufferFlags       flags = BufferFlags::None;
         BufferUsage       usage = {};
+
+        NOVA_POOLED(Impl)
     };
 
     template<>
@@ -249,7 +253,9 @@ namespace nova
 
         VkSampler sampler;
 
-        u32 descriptor_index;
+        SlotHandle descriptor = {};
+
+        NOVA_POOLED(Impl)
     };
 
     template<>
@@ -267,11 +273,13 @@ namespace nova
         VkImageLayout        layout = VK_IMAGE_LAYOUT_UNDEFINED;
         VkPipelineStageFlags2 stage = VK_PIPELINE_STAGE_2_NONE;
 
-        u32 descriptor_index = UINT_MAX;
+        SlotHandle descriptor = {};
 
         Vec3U extent = {};
         u32     mips = 0;
         u32   layers = 0;
+
+        NOVA_POOLED(Impl)
     };
 
     template<>
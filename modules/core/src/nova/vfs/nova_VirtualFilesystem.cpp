@@ -1,6 +1,7 @@
 #include "nova_VirtualFilesystem.hpp"
 
 #include <nova/core/nova_Files.hpp>
+#include <nova/core/nova_StringInterner.hpp>
 
 namespace nova::vfs
 {
@@ -8,13 +9,17 @@ namespace nova::vfs
     {
         struct VirtualFilesystem
         {
-            std::vector<std::unique_ptr<std::string>>                      paths;
-            ankerl::unordered_dense::map<std::string_view, Span<const b8>> files;
+            // Single shard, so path ids index files directly
+            StringInterner           paths{ { .shards = 1 } };
+            std::vector<Span<const b8>> files;
 
-            void Register(std::string name, const void* data, size_t size)
+            void Register(StringView name, const void* data, size_t size)
             {
-                std::string_view str = *paths.emplace_back(new std::string(std::move(name)));
-                files[str] = Span((const b8*)data, size);
+                auto id = paths.Intern(name);
+                if (id >= files.size()) {
+                    files.resize(id + 1);
+                }
+                files[id] = Span((const b8*)data, size);
             }
         };
 
@@ -34,12 +39,12 @@ namespace nova::vfs
     std::optional<Span<const b8>> LoadMaybe(StringView path)
     {
         auto& vfs = detail::GetVFS();
-        auto i = vfs.files.find(std::string_view(path));
-        if (i == vfs.files.end()) {
+        auto id = vfs.paths.Find(path);
+        if (id == StringInterner::InvalidId) {
             return std::nullopt;
         }
 
-        return i->second;
+        return vfs.files[id];
     }
 
     Span<const b8> Load(StringView path)
@@ -67,8 +72,9 @@ namespace nova::vfs
 
     void ForEach(std::function<void(StringView, Span<const b8>)> for_each)
     {
-        for (auto[path, contents] : detail::GetVFS().files) {
-            for_each(StringView(path), contents);
+        auto& vfs = detail::GetVFS();
+        for (u32 id = 0; id < vfs.files.size(); ++id) {
+            for_each(vfs.paths.Get(id), vfs.files[id]);
         }
     }
 }
@@ -11,6 +11,13 @@
 
 #include <ankerl/unordered_dense.h>
 
+#include <nova/core/nova_Profiler.hpp>
+#include <nova/core/nova_Metrics.hpp>
+
+static nova::metrics::Counter indexed_files_counter{ "indexer.files", "File system entries visited by the crawler" };
+static nova::metrics::Counter unique_names_counter{ "indexer.unique_names", "Entry names added to the string table" };
+static nova::metrics::Counter directories_counter{ "indexer.directories", "Directories opened by the crawler" };
+
 struct index_header_t {
     size_t string_size;
     uint32_t string_offset_count;
@@ -19,6 +26,8 @@ struct index_header_t {
 
 void save_index(const index_t& index, const char* path)
 {
+    NOVA_PROFILE_SCOPE("Save Index");
+
     std::ofstream out{ path, std::ios::binary };
 
     index_header_t header{
@@ -37,6 +46,8 @@ void save_index(const index_t& index, const char* path)
 
 void load_index(index_t& index, const char* path)
 {
+    NOVA_PROFILE_SCOPE("Load Index");
+
     std::ifstream in{ path, std::ios::binary };
 
     index_header_t header;
@@ -84,6 +95,7 @@ uint32_t insert_node(indexer_t& indexer, std::string_view view, uint32_t parent)
         string_offset_index = uint32_t(indexer.index->string_offsets.size());
         indexer.index->string_offsets.emplace_back(slice.offset);
         indexer.dedup_set.insert({ slice, string_offset_index });
+        unique_names_counter.Add();
     } else {
         string_offset_index = existing->second;
     }
@@ -112,6 +124,8 @@ void search_dir(indexer_t& indexer, size_t offset, uint32_t parent)
         return;
     }
 
+    directories_counter.Add();
+
     do {
         size_t len = wcslen(indexer.result.cFileName);
 
@@ -127,6 +141,7 @@ void search_dir(indexer_t& indexer, size_t offset, uint32_t parent)
             (const char16_t*)indexer.result.cFileName, len, indexer.utf8_buffer);
 
         uint32_t node_index = insert_node(indexer, std::string_view(indexer.utf8_buffer, utf8_len), parent);
+        indexed_files_counter.Add();
 
         if (++indexer.count % 100'000 == 0) {
             std::wcout << std::format(L"  File[{}]: {:.{}s}{}\n",
@@ -146,6 +161,8 @@ void search_dir(indexer_t& indexer, size_t offset, uint32_t parent)
 static
 void index_filesystem(indexer_t& indexer, const wchar_t* vol_guid)
 {
+    NOVA_PROFILE_SCOPE("Crawl Volume");
+
     auto vol_guid_len = wcslen(vol_guid);
     wcscpy(indexer.path, vol_guid);
     std::wcout << std::format(L"Indexing volume: {}\n", vol_guid);
@@ -170,6 +187,8 @@ void index_filesystem(indexer_t& indexer, const wchar_t* vol_guid)
 
 void index_filesystem(index_t& index)
 {
+    NOVA_PROFILE_SCOPE("Crawl");
+
     wchar_t vol[256];
     auto vol_handle = FindFirstVolumeW(vol, 255);
 
@@ -189,6 +208,8 @@ void index_filesystem(index_t& index)
 
 void sort_index(index_t& index)
 {
+    NOVA_PROFILE_SCOPE("Sort Index");
+
     std::vector<uint32_t> depth(index.file_nodes.size());
     std::vector<uint32_t> index_new_to_old(index.file_nodes.size());
     for (uint32_t i = 0; i < index.file_nodes.size(); ++i) {
@@ -1,6 +1,10 @@
 #include "file_searcher.hpp"
 #include "shared_types.h"
 
+#include <nova/core/nova_Metrics.hpp>
+
+static nova::metrics::Histogram search_latency{ "indexer.search_ns", "Keyword upload, GPU filter and readback time" };
+
 using namespace nova::types;
 
 void file_searcher_t::init(nova::Context _context, nova::Queue _queue)
@@ -125,6 +129,7 @@ void file_searcher_t::filter(nova::Span<std::string_view> keywords)
     queue.Submit({cmd}, {}).Wait();
 
     auto end = std::chrono::steady_clock::now();
+    search_latency.Record(end - start);
     auto dur = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
 
     // Check results